@@ -0,0 +1,95 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+// Compares invoking a pipe of 8 integer stages composed at compile time by makeAutoPipe, composed at runtime by a
+// StageRegistry and composed at runtime as a chain of std::functions.
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "funkypipes/make_auto_pipe.hpp"
+#include "funkypipes/stage_registry.hpp"
+#include "utils/measure.hpp"
+
+using namespace funkypipes;
+
+namespace {
+
+constexpr std::size_t kRuns = 10000000;
+constexpr std::size_t kStageCount = 8;
+
+auto makeAddFn(std::int64_t summand) {
+  return [summand](std::int64_t value) { return value + summand; };
+}
+
+auto makeDropMultiplesFn(std::int64_t divisor) {
+  return [divisor](std::int64_t value) -> std::optional<std::int64_t> {
+    return value % divisor == 0 ? std::nullopt : std::make_optional(value);
+  };
+}
+
+StageRegistry makeRegistry() {
+  StageRegistry registry;
+  registry.add<std::int64_t, std::int64_t>(
+      "add", [](const StageParameters& parameters) { return makeAddFn(parameters.get<std::int64_t>("summand")); });
+  registry.add<std::int64_t, std::int64_t>("dropMultiples", [](const StageParameters& parameters) {
+    return makeDropMultiplesFn(parameters.get<std::int64_t>("divisor"));
+  });
+  return registry;
+}
+
+std::vector<StageConfig> makeConfigs() {
+  std::vector<StageConfig> configs;
+  for (std::size_t stage = 0; stage < kStageCount - 1; ++stage) {
+    configs.push_back({"add", {{"summand", std::to_string(stage + 1)}}});
+  }
+  configs.push_back({"dropMultiples", {{"divisor", "1000"}}});
+  return configs;
+}
+
+}  // namespace
+
+int main() {
+  std::int64_t sum = 0;
+
+  auto staticPipe = makeAutoPipe(makeAddFn(1), makeAddFn(2), makeAddFn(3), makeAddFn(4), makeAddFn(5), makeAddFn(6),
+                                 makeAddFn(7), makeDropMultiplesFn(1000));
+  measure("makeAutoPipe", kRuns, [&](std::size_t run) {
+    sum += staticPipe(static_cast<std::int64_t>(run)).value_or(0);
+    doNotOptimize(sum);
+  });
+
+  auto dynamicPipe = makeRegistry().build<std::int64_t, std::int64_t>(makeConfigs());
+  measure("DynamicPipe built by StageRegistry", kRuns, [&](std::size_t run) {
+    sum += dynamicPipe(static_cast<std::int64_t>(run)).value_or(0);
+    doNotOptimize(sum);
+  });
+
+  std::vector<std::function<std::optional<std::int64_t>(std::int64_t)>> functionChain;
+  for (std::size_t stage = 0; stage < kStageCount - 1; ++stage) {
+    functionChain.emplace_back(makeAddFn(static_cast<std::int64_t>(stage + 1)));
+  }
+  functionChain.emplace_back(makeDropMultiplesFn(1000));
+  measure("chain of std::function", kRuns, [&](std::size_t run) {
+    std::optional<std::int64_t> value = static_cast<std::int64_t>(run);
+    for (auto& fn : functionChain) {
+      value = fn(*value);
+      if (!value) {
+        break;
+      }
+    }
+    sum += value.value_or(0);
+    doNotOptimize(sum);
+  });
+
+  return 0;
+}
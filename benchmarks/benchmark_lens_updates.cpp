@@ -0,0 +1,106 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+// Compares changing the threshold of a single sensor within a state of 10k sensors by a pure update of the whole
+// state (apply) with updating the threshold only (applyAt), with and without a subscription.
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "funkypipes/lens.hpp"
+#include "funkypipes/persistent_hash_map.hpp"
+#include "funkypipes/state_store.hpp"
+#include "utils/measure.hpp"
+
+using namespace funkypipes;
+
+namespace {
+
+constexpr std::size_t kSensorCount = 10000;
+constexpr std::size_t kRuns = 2000;
+
+struct Sensor {
+  std::string name;
+  double threshold{0.0};
+  std::vector<double> calibration;
+};
+
+template <typename TSensors>
+struct State {
+  TSensors sensors;
+  std::string operatorName;
+};
+
+template <typename TSensors>
+State<TSensors> makeState() {
+  State<TSensors> state;
+  for (std::size_t id = 0; id < kSensorCount; ++id) {
+    state.sensors = state.sensors.set(id, Sensor{"sensor" + std::to_string(id), 1.0, std::vector<double>(8, 1.0)});
+  }
+  return state;
+}
+
+template <>
+State<std::unordered_map<std::size_t, Sensor>> makeState() {
+  State<std::unordered_map<std::size_t, Sensor>> state;
+  for (std::size_t id = 0; id < kSensorCount; ++id) {
+    state.sensors[id] = Sensor{"sensor" + std::to_string(id), 1.0, std::vector<double>(8, 1.0)};
+  }
+  return state;
+}
+
+template <typename TSensors>
+void benchmarkState(const char* title) {
+  using Store = StateStore<State<TSensors>>;
+  std::printf("%s:\n", title);
+  auto subscriptionFn = [](const std::string&, const State<TSensors>& oldState, const State<TSensors>& newState) {
+    doNotOptimize(oldState.sensors.size() + newState.sensors.size());
+  };
+  const auto thresholdLens = [](std::size_t id) { return lens(&State<TSensors>::sensors, id, &Sensor::threshold); };
+  const auto raiseThreshold = [](double threshold) { return threshold + 1.0; };
+
+  if constexpr (std::is_same_v<TSensors, std::unordered_map<std::size_t, Sensor>>) {
+    Store store{makeState<TSensors>()};
+    measure("  apply (whole state)", kRuns, [&](std::size_t run) {
+      store.apply("raise", [id = run % kSensorCount](State<TSensors> state) {
+        state.sensors.at(id).threshold += 1.0;
+        return state;
+      });
+    });
+  } else {
+    Store store{makeState<TSensors>()};
+    measure("  apply (whole state)", kRuns, [&](std::size_t run) {
+      store.apply("raise", [id = run % kSensorCount](const State<TSensors>& state) {
+        auto sensor = state.sensors.at(id);
+        sensor.threshold += 1.0;
+        return State<TSensors>{state.sensors.set(id, std::move(sensor)), state.operatorName};
+      });
+    });
+  }
+
+  Store store{makeState<TSensors>()};
+  measure("  applyAt", kRuns,
+          [&](std::size_t run) { store.applyAt("raise", thresholdLens(run % kSensorCount), raiseThreshold); });
+
+  Store subscribedStore{subscriptionFn, makeState<TSensors>()};
+  measure("  applyAt with subscription", kRuns, [&](std::size_t run) {
+    subscribedStore.applyAt("raise", thresholdLens(run % kSensorCount), raiseThreshold);
+  });
+}
+
+}  // namespace
+
+int main() {
+  benchmarkState<std::unordered_map<std::size_t, Sensor>>("10k sensors in std::unordered_map");
+  benchmarkState<PersistentHashMap<std::size_t, Sensor>>("10k sensors in PersistentHashMap");
+  return 0;
+}
@@ -0,0 +1,111 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+// Compares pure updates of StateStore states held in std containers with those held in persistent containers. A
+// StateStore copies the state for the subscription and the update function returns a new state, so each update of a
+// std container copies all of its elements, while a persistent container copies O(log n) nodes only.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "funkypipes/persistent_hash_map.hpp"
+#include "funkypipes/persistent_vector.hpp"
+#include "funkypipes/state_store.hpp"
+#include "utils/measure.hpp"
+
+using namespace funkypipes;
+
+namespace {
+
+// Returns the number of runs for states of the given size, keeping the std container runs within seconds.
+std::size_t runsFor(std::size_t size) { return std::max<std::size_t>(20, 10000000 / size); }
+
+// Measures adding a sample to a sliding window of the given size, the way the moving average example does.
+void benchmarkSlidingWindow(std::size_t windowSize) {
+  std::printf("sliding window of %zu samples:\n", windowSize);
+  const std::size_t runs = runsFor(windowSize);
+
+  auto slide = [windowSize](auto window, double sample) {
+    window.push_back(sample);
+    if (window.size() > windowSize) {
+      window.erase(window.begin());
+    }
+    return window;
+  };
+  StateStore<std::vector<double>> vectorStore{std::vector<double>(windowSize, 0.0)};
+  measure("  StateStore<std::vector>", runs,
+          [&](std::size_t run) { vectorStore.apply("add", slide, static_cast<double>(run)); });
+
+  auto slideDeque = [windowSize](std::deque<double> window, double sample) {
+    window.push_back(sample);
+    if (window.size() > windowSize) {
+      window.pop_front();
+    }
+    return window;
+  };
+  StateStore<std::deque<double>> dequeStore{std::deque<double>(windowSize, 0.0)};
+  measure("  StateStore<std::deque>", runs,
+          [&](std::size_t run) { dequeStore.apply("add", slideDeque, static_cast<double>(run)); });
+
+  auto slidePersistent = [windowSize](const PersistentVector<double>& window, double sample) {
+    auto result = window.push_back(sample);
+    return result.size() > windowSize ? result.pop_front() : result;
+  };
+  auto initialWindow = PersistentVector<double>{}.transient();
+  for (std::size_t i = 0; i < windowSize; ++i) {
+    initialWindow.push_back(0.0);
+  }
+  StateStore<PersistentVector<double>> persistentStore{initialWindow.persistent()};
+  measure("  StateStore<PersistentVector>", runs,
+          [&](std::size_t run) { persistentStore.apply("add", slidePersistent, static_cast<double>(run)); });
+}
+
+// Measures replacing a single reading within a map of the given size.
+void benchmarkReadingsMap(std::size_t deviceCount) {
+  std::printf("map of %zu readings:\n", deviceCount);
+  const std::size_t runs = runsFor(deviceCount);
+
+  auto setReading = [](std::unordered_map<std::size_t, double> readings, std::size_t device, double reading) {
+    readings[device] = reading;
+    return readings;
+  };
+  std::unordered_map<std::size_t, double> initialReadings;
+  for (std::size_t device = 0; device < deviceCount; ++device) {
+    initialReadings[device] = 0.0;
+  }
+  StateStore<std::unordered_map<std::size_t, double>> mapStore{initialReadings};
+  measure("  StateStore<std::unordered_map>", runs, [&](std::size_t run) {
+    mapStore.apply("set", setReading, run % deviceCount, static_cast<double>(run));
+  });
+
+  auto setPersistentReading = [](const PersistentHashMap<std::size_t, double>& readings, std::size_t device,
+                                 double reading) { return readings.set(device, reading); };
+  auto initialPersistentReadings = PersistentHashMap<std::size_t, double>{}.transient();
+  for (std::size_t device = 0; device < deviceCount; ++device) {
+    initialPersistentReadings.set(device, 0.0);
+  }
+  StateStore<PersistentHashMap<std::size_t, double>> persistentStore{initialPersistentReadings.persistent()};
+  measure("  StateStore<PersistentHashMap>", runs, [&](std::size_t run) {
+    persistentStore.apply("set", setPersistentReading, run % deviceCount, static_cast<double>(run));
+  });
+}
+
+}  // namespace
+
+int main() {
+  for (std::size_t size : {100U, 10000U, 1000000U}) {
+    benchmarkSlidingWindow(size);
+    benchmarkReadingsMap(size);
+  }
+  return 0;
+}
@@ -0,0 +1,76 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+// Compares counting events from 1 to 64 threads in a single StateStore shared via a mutex with counting them in a
+// ReplicatedStateStore, which keeps a replica per thread. Prints the wall-clock time per update, so perfect scaling
+// shows as a time inversely proportional to the thread count (up to the number of cores).
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "funkypipes/replicated_state_store.hpp"
+#include "funkypipes/state_store.hpp"
+#include "utils/measure.hpp"
+
+using namespace funkypipes;
+
+namespace {
+
+constexpr std::size_t kUpdatesPerThread = 200000;
+
+std::uint64_t increment(std::uint64_t count) { return count + 1; }
+
+// Runs the given function on the given number of threads, each applying the given number of updates, and prints the
+// wall-clock time per update in nanoseconds.
+template <typename TFn>
+void measureThreads(const std::string& name, std::size_t threadCount, TFn&& fn) {
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (std::size_t thread = 0; thread < threadCount; ++thread) {
+    threads.emplace_back([&fn] {
+      for (std::size_t update = 0; update < kUpdatesPerThread; ++update) {
+        fn();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+  const double nanosecondsPerUpdate = duration.count() / static_cast<double>(threadCount * kUpdatesPerThread);
+  std::printf("%-60s %12.1f ns\n", (name + " (" + std::to_string(threadCount) + " threads)").c_str(),
+              nanosecondsPerUpdate);
+}
+
+}  // namespace
+
+int main() {
+  for (std::size_t threadCount = 1; threadCount <= 64; threadCount *= 2) {
+    {
+      StateStore<std::uint64_t> store;
+      std::mutex storeMutex;
+      measureThreads("StateStore behind a mutex", threadCount, [&] {
+        std::lock_guard<std::mutex> lock{storeMutex};
+        store.apply("increment", increment);
+      });
+      doNotOptimize(store.get_state());
+    }
+    {
+      ReplicatedStateStore<std::uint64_t> store{std::plus<>{}};
+      measureThreads("ReplicatedStateStore", threadCount, [&] { store.apply(increment); });
+      doNotOptimize(store.get_state());
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,140 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+// Compares dispatching events to a connection state machine with 6 states and 6 events via StateMachine's jump table
+// with applying them to a StateStore by a switch-based update function.
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "funkypipes/state_machine.hpp"
+#include "funkypipes/state_store.hpp"
+#include "utils/measure.hpp"
+
+using namespace funkypipes;
+
+namespace {
+
+constexpr std::size_t kRuns = 10000000;
+constexpr std::size_t kEventCount = 4096;
+
+enum class ConnectionState { kIdle, kConnecting, kConnected, kSending, kClosing, kFailed };
+enum class ConnectionEvent { kConnect, kEstablished, kSend, kSent, kClose, kError };
+
+struct Connection {
+  ConnectionState state{ConnectionState::kIdle};
+  std::uint64_t sentCount{0};
+  std::uint64_t errorCount{0};
+};
+
+Connection moveTo(Connection connection, ConnectionState state) {
+  connection.state = state;
+  return connection;
+}
+
+Connection sent(Connection connection) {
+  ++connection.sentCount;
+  return moveTo(connection, ConnectionState::kConnected);
+}
+
+Connection failed(Connection connection) {
+  ++connection.errorCount;
+  return moveTo(connection, ConnectionState::kFailed);
+}
+
+Connection switchUpdate(Connection connection, ConnectionEvent event) {
+  switch (connection.state) {
+    case ConnectionState::kIdle:
+      return event == ConnectionEvent::kConnect ? moveTo(connection, ConnectionState::kConnecting) : connection;
+    case ConnectionState::kConnecting:
+      switch (event) {
+        case ConnectionEvent::kEstablished:
+          return moveTo(connection, ConnectionState::kConnected);
+        case ConnectionEvent::kError:
+          return failed(connection);
+        default:
+          return connection;
+      }
+    case ConnectionState::kConnected:
+      switch (event) {
+        case ConnectionEvent::kSend:
+          return moveTo(connection, ConnectionState::kSending);
+        case ConnectionEvent::kClose:
+          return moveTo(connection, ConnectionState::kClosing);
+        case ConnectionEvent::kError:
+          return failed(connection);
+        default:
+          return connection;
+      }
+    case ConnectionState::kSending:
+      switch (event) {
+        case ConnectionEvent::kSent:
+          return sent(connection);
+        case ConnectionEvent::kError:
+          return failed(connection);
+        default:
+          return connection;
+      }
+    case ConnectionState::kClosing:
+      return event == ConnectionEvent::kSent ? moveTo(connection, ConnectionState::kIdle) : connection;
+    case ConnectionState::kFailed:
+      return event == ConnectionEvent::kConnect ? moveTo(connection, ConnectionState::kConnecting) : connection;
+  }
+  return connection;
+}
+
+template <ConnectionState kFrom, ConnectionEvent kEvent>
+auto moveTransition(ConnectionState to) {
+  return transition<kFrom, kEvent>([to](const Connection& connection) { return moveTo(connection, to); });
+}
+
+auto makeConnectionTransitions() {
+  using State = ConnectionState;
+  using Event = ConnectionEvent;
+  return makeTransitionTable(moveTransition<State::kIdle, Event::kConnect>(State::kConnecting),
+                             moveTransition<State::kConnecting, Event::kEstablished>(State::kConnected),
+                             transition<State::kConnecting, Event::kError>(failed),
+                             moveTransition<State::kConnected, Event::kSend>(State::kSending),
+                             moveTransition<State::kConnected, Event::kClose>(State::kClosing),
+                             transition<State::kConnected, Event::kError>(failed),
+                             transition<State::kSending, Event::kSent>(sent),
+                             transition<State::kSending, Event::kError>(failed),
+                             moveTransition<State::kClosing, Event::kSent>(State::kIdle),
+                             moveTransition<State::kFailed, Event::kConnect>(State::kConnecting));
+}
+
+std::vector<ConnectionEvent> makeEvents() {
+  std::mt19937 generator{42};
+  std::uniform_int_distribution<int> distribution{0, 5};
+  std::vector<ConnectionEvent> events(kEventCount);
+  for (auto& event : events) {
+    event = static_cast<ConnectionEvent>(distribution(generator));
+  }
+  return events;
+}
+
+}  // namespace
+
+int main() {
+  const auto events = makeEvents();
+
+  StateStore<Connection, ConnectionEvent> store;
+  measure("StateStore with switch-based update function", kRuns, [&](std::size_t run) {
+    const ConnectionEvent event = events[run % kEventCount];
+    store.apply(event, switchUpdate, event);
+  });
+  doNotOptimize(store.get_state().sentCount);
+
+  auto machine = makeStateMachine(Connection{}, &Connection::state, makeConnectionTransitions());
+  measure("StateMachine", kRuns, [&](std::size_t run) { machine.dispatch(events[run % kEventCount]); });
+  doNotOptimize(machine.get_state().sentCount);
+
+  return 0;
+}
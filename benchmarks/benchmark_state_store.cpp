@@ -0,0 +1,120 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+// Baseline of StateStore's update path: apply, apply with an update function returning additional outputs (which go
+// through separateTupleElements and tryFlattenTuple), applyAndTransform and a bound update function, for states of
+// 8 bytes to 10 MB, without and with a subscription. Reports per update the mean duration of a batch of updates, the
+// 50th, 99th and 99.9th percentile of individually timed updates, and the number of state bytes copied, as well as the
+// peak resident set size after each state size.
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "funkypipes/state_store.hpp"
+#include "utils/measure.hpp"
+
+using namespace funkypipes;
+
+namespace {
+
+std::uint64_t copiedBytes = 0;
+
+// A state of the given number of bytes which counts the bytes copied.
+struct CountingState {
+  explicit CountingState(std::size_t size = 8) : bytes(size) {}
+  ~CountingState() = default;
+
+  CountingState(const CountingState& other) : bytes{other.bytes} { copiedBytes += bytes.size(); }
+  CountingState(CountingState&&) noexcept = default;
+
+  CountingState& operator=(const CountingState& other) {
+    bytes = other.bytes;
+    copiedBytes += bytes.size();
+    return *this;
+  }
+  CountingState& operator=(CountingState&&) noexcept = default;
+
+  std::vector<std::uint8_t> bytes;
+};
+
+using Store = StateStore<CountingState>;
+
+CountingState touch(CountingState state) {
+  ++state.bytes[0];
+  return state;
+}
+
+std::tuple<CountingState, std::uint8_t, std::size_t> touchWithOutputs(CountingState state) {
+  const std::uint8_t previous = state.bytes[0]++;
+  const std::size_t size = state.bytes.size();
+  return {std::move(state), previous, size};
+}
+
+std::uint8_t firstByte(const CountingState& state) { return state.bytes[0]; }
+
+void subscriptionFn(const std::string& /*updateName*/, const CountingState& oldState, const CountingState& newState) {
+  doNotOptimize(oldState.bytes[0] + newState.bytes[0]);
+}
+
+double peakRssMegabytes() {
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return static_cast<double>(usage.ru_maxrss) / 1024.0;  // Note: ru_maxrss is given in kilobytes on Linux
+}
+
+// Measures the update performed by the callable made by the given function for a store of the given state size, and
+// prints a row of results.
+template <typename TMakeUpdateFn>
+void benchmarkUpdate(const char* name, std::size_t stateSize, bool isSubscribed, TMakeUpdateFn&& makeUpdateFn) {
+  const std::size_t runs = std::clamp<std::size_t>(200000000 / stateSize, 20, 200000);
+  Store store = isSubscribed ? Store{subscriptionFn, CountingState{stateSize}} : Store{CountingState{stateSize}};
+  auto updateFn = makeUpdateFn(store);
+
+  copiedBytes = 0;
+  const double meanNanoseconds = measureBatch(runs, [&](std::size_t) { updateFn(); });
+  const double copiedBytesPerUpdate = static_cast<double>(copiedBytes) / static_cast<double>(runs);
+  const Latencies latencies = measureLatencies(runs, [&](std::size_t) { updateFn(); });
+
+  const std::string rowName = std::string{name} + (isSubscribed ? " (subscribed)" : "");
+  std::printf("  %-36s %12.1f %12.1f %12.1f %12.1f %14.0f\n", rowName.c_str(), meanNanoseconds, latencies.p50,
+              latencies.p99, latencies.p999, copiedBytesPerUpdate);
+}
+
+void benchmarkStateSize(const char* title, std::size_t stateSize) {
+  std::printf("%s:\n  %-36s %12s %12s %12s %12s %14s\n", title, "", "mean ns", "p50 ns", "p99 ns", "p99.9 ns",
+              "copied bytes");
+  for (const bool isSubscribed : {false, true}) {
+    benchmarkUpdate("apply", stateSize, isSubscribed,
+                    [](Store& store) { return [&store] { store.apply("touch", touch); }; });
+    benchmarkUpdate("apply (tuple result)", stateSize, isSubscribed,
+                    [](Store& store) { return [&store] { doNotOptimize(store.apply("touch", touchWithOutputs)); }; });
+    benchmarkUpdate("applyAndTransform", stateSize, isSubscribed, [](Store& store) {
+      return [&store] { doNotOptimize(store.applyAndTransform("touch", touch, firstByte)); };
+    });
+    benchmarkUpdate("bind", stateSize, isSubscribed, [](Store& store) { return store.bind("touch", touch); });
+  }
+  std::printf("  peak RSS: %.1f MB\n", peakRssMegabytes());
+}
+
+}  // namespace
+
+int main() {
+  benchmarkStateSize("8 B state", 8);
+  benchmarkStateSize("1 KB state", 1024);
+  benchmarkStateSize("64 KB state", 64 * 1024);
+  benchmarkStateSize("1 MB state", 1024 * 1024);
+  benchmarkStateSize("10 MB state", 10 * 1024 * 1024);
+  return 0;
+}
@@ -0,0 +1,73 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github/mahush/funkypipes
+//
+#ifndef FUNKYPIPES_BENCHMARKS_UTILS_MEASURE_HPP
+#define FUNKYPIPES_BENCHMARKS_UTILS_MEASURE_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+// Runs the given function the given number of times and returns the average duration of a run in nanoseconds.
+template <typename TFn>
+double measureBatch(std::size_t runs, TFn&& fn) {
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t run = 0; run < runs; ++run) {
+    fn(run);
+  }
+  const std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+  return duration.count() / static_cast<double>(runs);
+}
+
+// Runs the given function the given number of times and prints the average duration of a run in nanoseconds.
+template <typename TFn>
+double measure(const char* name, std::size_t runs, TFn&& fn) {
+  const double nanosecondsPerRun = measureBatch(runs, std::forward<TFn>(fn));
+  std::printf("%-60s %12.1f ns\n", name, nanosecondsPerRun);
+  return nanosecondsPerRun;
+}
+
+// The distribution of the durations of the runs of a function, in nanoseconds.
+struct Latencies {
+  double mean;
+  double p50;
+  double p99;
+  double p999;
+};
+
+// Runs the given function the given number of times, timing each run on its own, and returns the distribution of the
+// durations. Includes the overhead of reading the clock, see measure for timing many runs at once.
+template <typename TFn>
+Latencies measureLatencies(std::size_t runs, TFn&& fn) {
+  std::vector<double> durations(runs);
+  for (std::size_t run = 0; run < runs; ++run) {
+    const auto start = std::chrono::steady_clock::now();
+    fn(run);
+    const std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+    durations[run] = duration.count();
+  }
+  std::sort(durations.begin(), durations.end());
+  double sum = 0.0;
+  for (const double duration : durations) {
+    sum += duration;
+  }
+  const auto percentile = [&](double fraction) {
+    return durations[std::min(runs - 1, static_cast<std::size_t>(fraction * static_cast<double>(runs)))];
+  };
+  return Latencies{sum / static_cast<double>(runs), percentile(0.5), percentile(0.99), percentile(0.999)};
+}
+
+// Keeps the compiler from optimizing away the computation of the given value.
+template <typename T>
+void doNotOptimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+#endif  // FUNKYPIPES_BENCHMARKS_UTILS_MEASURE_HPP
@@ -1,19 +1,25 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <deque>
 #include <numeric>
 #include <sstream>
 #include <string>
 #include <tuple>
 
+#include "funkypipes/any_pipe.hpp"
 #include "funkypipes/at.hpp"
 #include "funkypipes/bind_front.hpp"
+#include "funkypipes/bind_front_reloadable.hpp"
 #include "funkypipes/fork.hpp"
+#include "funkypipes/function_ref.hpp"
 #include "funkypipes/make_auto_pipe.hpp"
 #include "funkypipes/make_callable.hpp"
 #include "funkypipes/make_pipe.hpp"
 #include "funkypipes/pass_along.hpp"
+#include "funkypipes/stage_registry.hpp"
 #include "funkypipes/state_store.hpp"
+#include "funkypipes/swappable_stage.hpp"
 
 using namespace funkypipes;
 using namespace std::string_literals;
@@ -107,6 +113,18 @@ TEST(ReadmeExamples, bind_front) {
   ASSERT_EQ(result, "Hello World!");
 }
 
+TEST(ReadmeExamples, bind_front_reloadable) {
+  struct Limits {
+    int max;
+  };
+  auto limits = makeReloadableArgs(Limits{10});
+  auto isTooHigh = bindFrontReloadable([](const Limits& current, int value) { return value > current.max; }, limits);
+  ASSERT_TRUE(isTooHigh(15));
+
+  limits.reload(Limits{20});  // from any thread, while isTooHigh is invoked
+  ASSERT_FALSE(isTooHigh(15));
+}
+
 TEST(ReadmeExamples, pipe_with_at_simple) {
   auto incrementFn = [](int value) { return value + 1; };
 
@@ -181,6 +199,45 @@ TEST(ReadmeExamples, pass_along_by_type) {
   ASSERT_EQ(appendDateTime("de_DE: "s, Locale::de_DE), "de_DE: 15.09.1959 00:01"s);
 }
 
+TEST(ReadmeExamples, any_pipe) {
+  auto swapArgs = [](auto arg1, auto arg2) { return std::make_tuple(arg2, arg1); };
+
+  AnyPipe<std::tuple<std::string, int>(int, std::string)> pipe = makePipe(swapArgs);
+
+  ASSERT_EQ(pipe(42, "answer"), std::make_tuple("answer"s, 42));
+}
+
+TEST(ReadmeExamples, function_ref) {
+  auto sumOfResults = [](FunctionRef<int(int)> pipe) { return pipe(1) + pipe(2); };
+
+  auto incrementFn = [](int value) { return value + 1; };
+
+  ASSERT_EQ(sumOfResults(makePipe(incrementFn, incrementFn)), 7);
+}
+
+TEST(ReadmeExamples, stage_registry) {
+  StageRegistry registry;
+  registry.add<int, int>("clamp", [](const StageParameters& parameters) {
+    return [max = parameters.get<int>("max")](int value) { return std::min(value, max); };
+  });
+  registry.add<int, std::string>("toString", [](const StageParameters&) {
+    return [](int value) { return std::to_string(value); };
+  });
+
+  auto pipe = registry.build<int, std::string>({{"clamp", {{"max", "10"}}}, {"toString", {}}});
+
+  ASSERT_EQ(pipe(42), "10");
+}
+
+TEST(ReadmeExamples, swappable_stage) {
+  auto threshold = makeSwappableStage<bool(int)>([](int value) { return value > 10; });
+  auto pipe = makePipe([](const std::string& text) { return std::stoi(text); }, threshold);
+  ASSERT_TRUE(pipe("15"));
+
+  threshold.swap([](int value) { return value > 20; });  // from any thread, while pipe is invoked
+  ASSERT_FALSE(pipe("15"));
+}
+
 TEST(ReadmeExamples, state_store_basic) {
   // The store has an initial value
   StateStore<int> store{10};
@@ -246,4 +303,11 @@ TEST(ReadmeExamples, state_store_moving_average) {
   ASSERT_EQ(addSampleAndGetAverageFn(20.0), 15.0);
   ASSERT_EQ(addSampleAndGetAverageFn(30.0), 20.0);
   ASSERT_EQ(addSampleAndGetAverageFn(40.0), 30.0);
+
+  // The average is computed lazily instead, and only once per state change
+  auto average = store.derive(computeAverageFn);
+  auto addSample = store.bind("addSample", addSampleFn);
+  addSample(50.0);
+  addSample(60.0);
+  ASSERT_EQ(average(), 50.0);
 }
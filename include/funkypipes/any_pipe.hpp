@@ -0,0 +1,198 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_ANY_PIPE_HPP
+#define FUNKYPIPES_ANY_PIPE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "funkypipes/details/invoke_packed.hpp"
+
+namespace funkypipes {
+
+// The inline capacity of AnyPipe by default, which fits pipes capturing a few pointers or small values.
+inline constexpr std::size_t kDefaultAnyPipeInlineCapacity = 4 * sizeof(void*);
+
+// AnyPipe is a move-only, type-erased container of a pipe (or any other callable) with the given signature, like
+// std::function but without requiring the pipe to be copyable. Pipes of up to the given inline capacity, which are
+// nothrow move constructible, are stored inline, so neither constructing nor moving an AnyPipe allocates for them.
+// Larger pipes are stored on the heap.
+//
+// The pipe is invoked like a pipe made by makePipe invokes its first callable: zero or multiple arguments are passed as
+// tuple to pipes accepting a single tuple, and a single tuple argument is unpacked for pipes accepting its elements.
+// Tuple results are returned as they are. Invoking an empty AnyPipe throws std::bad_function_call.
+//
+// Example usage:
+//   AnyPipe<std::tuple<std::string, bool>(int)> classify = makePipe(classifyTemperature, swapArgs);
+//   auto [info, isAlert] = classify(45);
+template <typename TSignature, std::size_t kInlineCapacity = kDefaultAnyPipeInlineCapacity>
+class AnyPipe;
+
+template <typename TResult, typename... TArgs, std::size_t kInlineCapacity>
+class AnyPipe<TResult(TArgs...), kInlineCapacity> {
+ public:
+  // Returns whether a pipe of the given type is stored inline.
+  template <typename TFn>
+  static constexpr bool isStoredInline() {
+    using Fn = std::decay_t<TFn>;
+    return sizeof(Fn) <= kInlineCapacity && alignof(Fn) <= alignof(std::max_align_t) &&
+           std::is_nothrow_move_constructible_v<Fn>;
+  }
+
+  AnyPipe() noexcept = default;
+
+  // Constructor: Takes ownership of the given pipe.
+  template <typename TFn, typename = std::enable_if_t<!std::is_same_v<std::decay_t<TFn>, AnyPipe> &&
+                                                      details::isInvocablePackedReturning<TResult, std::decay_t<TFn>&,
+                                                                                          TArgs...>()>>
+  AnyPipe(TFn&& fn);  // NOLINT implicit by intention
+
+  AnyPipe(AnyPipe&& other) noexcept;
+  AnyPipe& operator=(AnyPipe&& other) noexcept;
+  AnyPipe(const AnyPipe&) = delete;
+  AnyPipe& operator=(const AnyPipe&) = delete;
+  ~AnyPipe();
+
+  // Invokes the pipe with the given arguments, see above.
+  TResult operator()(TArgs... args);
+
+  // Returns whether a pipe is contained.
+  explicit operator bool() const noexcept { return vtable_ != nullptr; }
+
+ private:
+  struct VTable {
+    TResult (*invoke)(void* storage, TArgs&&... args);
+    // Move constructs the pipe of the source storage into the target storage and destroys the source's pipe.
+    void (*relocate)(void* source, void* target) noexcept;
+    void (*destroy)(void* storage) noexcept;
+  };
+
+  template <typename TFn>
+  static TFn& pipeOf(void* storage) noexcept;
+
+  template <typename TFn>
+  static TResult invoke(void* storage, TArgs&&... args);
+
+  template <typename TFn>
+  static void relocate(void* source, void* target) noexcept;
+
+  template <typename TFn>
+  static void destroy(void* storage) noexcept;
+
+  template <typename TFn>
+  static constexpr VTable kVTable{&invoke<TFn>, &relocate<TFn>, &destroy<TFn>};
+
+  void reset() noexcept;
+
+  // Note: holds the pipe if stored inline and a pointer to it otherwise
+  alignas(std::max_align_t) std::byte storage_[kInlineCapacity < sizeof(void*) ? sizeof(void*) : kInlineCapacity];
+  const VTable* vtable_{nullptr};
+};
+
+template <typename TResult, typename... TArgs, std::size_t kInlineCapacity>
+template <typename TFn, typename>
+AnyPipe<TResult(TArgs...), kInlineCapacity>::AnyPipe(TFn&& fn) {
+  using Fn = std::decay_t<TFn>;
+  if constexpr (isStoredInline<Fn>()) {
+    ::new (static_cast<void*>(storage_)) Fn(std::forward<TFn>(fn));
+  } else {
+    ::new (static_cast<void*>(storage_)) Fn*(new Fn(std::forward<TFn>(fn)));
+  }
+  vtable_ = &kVTable<Fn>;
+}
+
+template <typename TResult, typename... TArgs, std::size_t kInlineCapacity>
+AnyPipe<TResult(TArgs...), kInlineCapacity>::AnyPipe(AnyPipe&& other) noexcept : vtable_{other.vtable_} {
+  if (vtable_ != nullptr) {
+    vtable_->relocate(other.storage_, storage_);
+    other.vtable_ = nullptr;
+  }
+}
+
+template <typename TResult, typename... TArgs, std::size_t kInlineCapacity>
+auto AnyPipe<TResult(TArgs...), kInlineCapacity>::operator=(AnyPipe&& other) noexcept -> AnyPipe& {
+  if (this != &other) {
+    reset();
+    if (other.vtable_ != nullptr) {
+      other.vtable_->relocate(other.storage_, storage_);
+      vtable_ = std::exchange(other.vtable_, nullptr);
+    }
+  }
+  return *this;
+}
+
+template <typename TResult, typename... TArgs, std::size_t kInlineCapacity>
+AnyPipe<TResult(TArgs...), kInlineCapacity>::~AnyPipe() {
+  reset();
+}
+
+template <typename TResult, typename... TArgs, std::size_t kInlineCapacity>
+TResult AnyPipe<TResult(TArgs...), kInlineCapacity>::operator()(TArgs... args) {
+  if (vtable_ == nullptr) {
+    throw std::bad_function_call{};
+  }
+  return vtable_->invoke(storage_, std::forward<TArgs>(args)...);
+}
+
+template <typename TResult, typename... TArgs, std::size_t kInlineCapacity>
+template <typename TFn>
+TFn& AnyPipe<TResult(TArgs...), kInlineCapacity>::pipeOf(void* storage) noexcept {
+  if constexpr (isStoredInline<TFn>()) {
+    return *std::launder(static_cast<TFn*>(storage));
+  } else {
+    return **std::launder(static_cast<TFn**>(storage));
+  }
+}
+
+template <typename TResult, typename... TArgs, std::size_t kInlineCapacity>
+template <typename TFn>
+TResult AnyPipe<TResult(TArgs...), kInlineCapacity>::invoke(void* storage, TArgs&&... args) {
+  if constexpr (std::is_void_v<TResult>) {
+    details::invokePacked(pipeOf<TFn>(storage), std::forward<TArgs>(args)...);
+  } else {
+    return details::invokePacked(pipeOf<TFn>(storage), std::forward<TArgs>(args)...);
+  }
+}
+
+template <typename TResult, typename... TArgs, std::size_t kInlineCapacity>
+template <typename TFn>
+void AnyPipe<TResult(TArgs...), kInlineCapacity>::relocate(void* source, void* target) noexcept {
+  if constexpr (isStoredInline<TFn>()) {
+    TFn& sourceFn = pipeOf<TFn>(source);
+    ::new (target) TFn(std::move(sourceFn));
+    sourceFn.~TFn();
+  } else {
+    ::new (target) TFn*(*std::launder(static_cast<TFn**>(source)));
+  }
+}
+
+template <typename TResult, typename... TArgs, std::size_t kInlineCapacity>
+template <typename TFn>
+void AnyPipe<TResult(TArgs...), kInlineCapacity>::destroy(void* storage) noexcept {
+  if constexpr (isStoredInline<TFn>()) {
+    pipeOf<TFn>(storage).~TFn();
+  } else {
+    delete &pipeOf<TFn>(storage);
+  }
+}
+
+template <typename TResult, typename... TArgs, std::size_t kInlineCapacity>
+void AnyPipe<TResult(TArgs...), kInlineCapacity>::reset() noexcept {
+  if (vtable_ != nullptr) {
+    vtable_->destroy(storage_);
+    vtable_ = nullptr;
+  }
+}
+
+}  // namespace funkypipes
+
+#endif  // FUNKYPIPES_ANY_PIPE_HPP
@@ -0,0 +1,189 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_ASYNC_STATE_STORE_HPP
+#define FUNKYPIPES_ASYNC_STATE_STORE_HPP
+
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "funkypipes/details/strand.hpp"
+#include "funkypipes/state_store.hpp"
+
+namespace funkypipes {
+
+// AsyncStateStore is a variant of StateStore whose updates are applied asynchronously. It offers the same interface as
+// StateStore (see there for the expected signatures of update, transform and subscription functions), but apply and
+// applyAndTransform enqueue the update and return a std::future of what StateStore would have returned, so the calling
+// thread never waits for the update to be computed. The functions returned by bind behave alike.
+//
+// Updates are applied one after the other on a background thread owned by the store (a strand), in the order they were
+// enqueued, so the state keeps a single writer without any lock around it. The subscription function is called on that
+// thread as well. An exception thrown by an update function is passed to its future and leaves the state unchanged.
+//
+// Update functions and arguments are copied (or moved) into the queue. The functions returned by bind share their
+// update and transform functions with the queued updates instead. When the store is destroyed, all queued updates are
+// applied before its thread is stopped. Waiting for a future within an update or subscription function of the same
+// store deadlocks.
+//
+// Example usage:
+//   AsyncStateStore<State> store{subscriptionFn};
+//   auto addSample = store.bind("addSample", addSampleFn, computeAverageFn);
+//   std::future<double> average = addSample(sample);
+template <typename TState, typename TUpdateName = std::string,
+          typename TSubscriptionFn = std::function<void(const TUpdateName&, const TState&, const TState&)>>
+class AsyncStateStore {
+ public:
+  using UpdateName = TUpdateName;
+  using SubscriptionFn = TSubscriptionFn;
+
+  // Constructor: Initializes the store with an optional subscription callback and initial state.
+  explicit AsyncStateStore(SubscriptionFn subscriptionFn = SubscriptionFn{}, TState initialState = TState{});
+
+  // Constructor: Initializes the store with an initial state.
+  explicit AsyncStateStore(TState initialState);
+
+  // Enqueues an update function with optional arguments, and returns a future of any additional output.
+  template <typename TStateUpdateFn, typename... TArgs>
+  auto apply(const UpdateName& updateName, TStateUpdateFn updateFn, TArgs&&... args);
+
+  // Enqueues an update function whose result is passed to a transformation function, and returns a future of the
+  // transformed output.
+  template <typename TStateUpdateFn, typename TTransformFn, typename... TArgs>
+  auto applyAndTransform(const UpdateName& updateName, TStateUpdateFn updateFn, TTransformFn transformFn,
+                         TArgs&&... args);
+
+  // Returns a callable that, when invoked, enqueues the update function using the specified update name and returns a
+  // future of any additional output.
+  template <typename TStateUpdateFn>
+  [[nodiscard]] auto bind(UpdateName updateName, TStateUpdateFn&& updateFn);
+
+  // Returns a callable that, when invoked, enqueues the update function and then the transform function using the
+  // specified update name, and returns a future of the transformed output.
+  template <typename TStateUpdateFn, typename TTransformFn>
+  [[nodiscard]] auto bind(UpdateName updateName, TStateUpdateFn&& updateFn, TTransformFn&& transformFn);
+
+  // Returns a future of the state after all updates enqueued before.
+  [[nodiscard]] std::future<TState> get_state();
+
+ private:
+  using Store = StateStore<TState, TUpdateName, TSubscriptionFn>;
+
+  // Enqueues a function invoked with the underlying store, and returns a future of its result.
+  template <typename TStoreFn>
+  auto post(TStoreFn storeFn);
+
+  // Note: declared before the strand, so queued updates are applied before the store is destroyed
+  Store store_;
+  details::Strand strand_;
+};
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+AsyncStateStore<TState, TUpdateName, TSubscriptionFn>::AsyncStateStore(SubscriptionFn subscriptionFn,
+                                                                       TState initialState)
+    : store_{std::move(subscriptionFn), std::move(initialState)} {}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+AsyncStateStore<TState, TUpdateName, TSubscriptionFn>::AsyncStateStore(TState initialState)
+    : store_{std::move(initialState)} {}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+template <typename TStateUpdateFn, typename... TArgs>
+auto AsyncStateStore<TState, TUpdateName, TSubscriptionFn>::apply(const UpdateName& updateName,
+                                                                  TStateUpdateFn updateFn, TArgs&&... args) {
+  return post([updateName, updateFn = std::move(updateFn),
+               argsTuple = std::make_tuple(std::forward<TArgs>(args)...)](Store& store) mutable {
+    return std::apply(
+        [&](auto&... args) { return store.apply(updateName, updateFn, std::move(args)...); }, argsTuple);
+  });
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+template <typename TStateUpdateFn, typename TTransformFn, typename... TArgs>
+auto AsyncStateStore<TState, TUpdateName, TSubscriptionFn>::applyAndTransform(const UpdateName& updateName,
+                                                                              TStateUpdateFn updateFn,
+                                                                              TTransformFn transformFn,
+                                                                              TArgs&&... args) {
+  return post([updateName, updateFn = std::move(updateFn), transformFn = std::move(transformFn),
+               argsTuple = std::make_tuple(std::forward<TArgs>(args)...)](Store& store) mutable {
+    return std::apply(
+        [&](auto&... args) { return store.applyAndTransform(updateName, updateFn, transformFn, std::move(args)...); },
+        argsTuple);
+  });
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+template <typename TStateUpdateFn>
+[[nodiscard]] auto AsyncStateStore<TState, TUpdateName, TSubscriptionFn>::bind(UpdateName updateName,
+                                                                               TStateUpdateFn&& updateFn) {
+  auto sharedUpdateFn = std::make_shared<const std::decay_t<TStateUpdateFn>>(std::forward<TStateUpdateFn>(updateFn));
+  return [this, updateName_ = std::move(updateName), sharedUpdateFn_ = std::move(sharedUpdateFn)](auto&&... args) {
+    auto updateFn = [sharedUpdateFn_](auto&&... updateArgs) {
+      return (*sharedUpdateFn_)(std::forward<decltype(updateArgs)>(updateArgs)...);
+    };
+    return this->apply(updateName_, std::move(updateFn), std::forward<decltype(args)>(args)...);
+  };
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+template <typename TStateUpdateFn, typename TTransformFn>
+[[nodiscard]] auto AsyncStateStore<TState, TUpdateName, TSubscriptionFn>::bind(UpdateName updateName,
+                                                                               TStateUpdateFn&& updateFn,
+                                                                               TTransformFn&& transformFn) {
+  auto sharedUpdateFn = std::make_shared<const std::decay_t<TStateUpdateFn>>(std::forward<TStateUpdateFn>(updateFn));
+  auto sharedTransformFn =
+      std::make_shared<const std::decay_t<TTransformFn>>(std::forward<TTransformFn>(transformFn));
+  return [this, updateName_ = std::move(updateName), sharedUpdateFn_ = std::move(sharedUpdateFn),
+          sharedTransformFn_ = std::move(sharedTransformFn)](auto&&... args) {
+    auto updateFn = [sharedUpdateFn_](auto&&... updateArgs) {
+      return (*sharedUpdateFn_)(std::forward<decltype(updateArgs)>(updateArgs)...);
+    };
+    auto transformFn = [sharedTransformFn_](auto&&... transformArgs) {
+      return (*sharedTransformFn_)(std::forward<decltype(transformArgs)>(transformArgs)...);
+    };
+    return this->applyAndTransform(updateName_, std::move(updateFn), std::move(transformFn),
+                                   std::forward<decltype(args)>(args)...);
+  };
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+[[nodiscard]] std::future<TState> AsyncStateStore<TState, TUpdateName, TSubscriptionFn>::get_state() {
+  return post([](Store& store) { return store.get_state(); });
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+template <typename TStoreFn>
+auto AsyncStateStore<TState, TUpdateName, TSubscriptionFn>::post(TStoreFn storeFn) {
+  using Result = std::invoke_result_t<TStoreFn&, Store&>;
+
+  std::promise<Result> promise;
+  auto future = promise.get_future();
+  strand_.post([this, promise = std::move(promise), storeFn = std::move(storeFn)]() mutable {
+    try {
+      if constexpr (std::is_void_v<Result>) {
+        storeFn(store_);
+        promise.set_value();
+      } else {
+        promise.set_value(storeFn(store_));
+      }
+    } catch (...) {
+      promise.set_exception(std::current_exception());
+    }
+  });
+  return future;
+}
+
+}  // namespace funkypipes
+
+#endif  // FUNKYPIPES_ASYNC_STATE_STORE_HPP
@@ -0,0 +1,244 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_ASYNC_SUBSCRIPTION_HPP
+#define FUNKYPIPES_ASYNC_SUBSCRIPTION_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "funkypipes/details/bounded_queue.hpp"
+
+namespace funkypipes {
+
+// Defines what AsyncSubscription does with a notification when its queue is full.
+enum class OverflowPolicy {
+  kBlock,            // Wait until the background thread made room, no notification is lost.
+  kDropOldest,       // Discard the oldest queued notification in favor of the new one.
+  kCoalesceToLatest  // Merge all overflowing notifications into a single one, see AsyncSubscription.
+};
+
+namespace details {
+
+// The shared part of AsyncSubscription: owns the queue and the background thread delivering its notifications.
+template <typename TState, typename TUpdateName>
+class AsyncSubscriptionDispatcher {
+ public:
+  using SubscriptionFn = std::function<void(const TUpdateName&, const TState&, const TState&)>;
+
+  AsyncSubscriptionDispatcher(SubscriptionFn subscriptionFn, std::size_t capacity, OverflowPolicy overflowPolicy)
+      : subscriptionFn_{std::move(subscriptionFn)}, overflowPolicy_{overflowPolicy}, queue_{capacity} {
+    thread_ = std::thread{[this] { deliverUntilStopped(); }};
+  }
+
+  AsyncSubscriptionDispatcher(const AsyncSubscriptionDispatcher&) = delete;
+  AsyncSubscriptionDispatcher(AsyncSubscriptionDispatcher&&) = delete;
+  AsyncSubscriptionDispatcher& operator=(const AsyncSubscriptionDispatcher&) = delete;
+  AsyncSubscriptionDispatcher& operator=(AsyncSubscriptionDispatcher&&) = delete;
+
+  // Delivers all remaining notifications before stopping the background thread.
+  ~AsyncSubscriptionDispatcher() {
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      stopRequested_ = true;
+    }
+    wakeUp_.notify_one();
+    thread_.join();
+  }
+
+  void post(const TUpdateName& updateName, const TState& oldState, const TState& newState) {
+    submittedCount_.fetch_add(1, std::memory_order_relaxed);
+    Notification notification{updateName, oldState, newState};
+
+    if (overflowPolicy_ == OverflowPolicy::kCoalesceToLatest && hasPending_.load(std::memory_order_acquire)) {
+      coalesce(std::move(notification));
+    } else {
+      while (!queue_.tryPush(std::move(notification))) {  // Note: tryPush leaves the notification intact on failure
+        if (overflowPolicy_ == OverflowPolicy::kBlock) {
+          wakeUpConsumer();
+          std::this_thread::yield();
+        } else if (overflowPolicy_ == OverflowPolicy::kDropOldest) {
+          if (queue_.tryPop()) {
+            markDropped();
+          }
+        } else {
+          coalesce(std::move(notification));
+          break;
+        }
+      }
+    }
+    wakeUpConsumer();
+  }
+
+  void flush() {
+    const auto targetCount = submittedCount_.load(std::memory_order_relaxed);
+    std::unique_lock<std::mutex> lock{mutex_};
+    progressed_.wait(lock, [&] { return finishedCount_.load(std::memory_order_acquire) >= targetCount; });
+  }
+
+  [[nodiscard]] std::uint64_t droppedCount() const { return droppedCount_.load(std::memory_order_relaxed); }
+
+ private:
+  struct Notification {
+    TUpdateName updateName;
+    TState oldState;
+    TState newState;
+  };
+
+  // Stores the given notification in the pending slot, merging it with a notification already pending there. The
+  // merged notification keeps the old state of the first and takes update name and new state of the latest one.
+  void coalesce(Notification&& notification) {
+    std::lock_guard<std::mutex> lock{pendingMutex_};
+    if (pending_) {
+      pending_->updateName = std::move(notification.updateName);
+      pending_->newState = std::move(notification.newState);
+      markDropped();
+    } else {
+      pending_ = std::move(notification);
+      hasPending_.store(true, std::memory_order_release);
+    }
+  }
+
+  std::optional<Notification> takePending() {
+    std::lock_guard<std::mutex> lock{pendingMutex_};
+    std::optional<Notification> pending{std::move(pending_)};
+    pending_.reset();
+    hasPending_.store(false, std::memory_order_release);
+    return pending;
+  }
+
+  void markDropped() {
+    droppedCount_.fetch_add(1, std::memory_order_relaxed);
+    markFinished();
+  }
+
+  void markFinished() {
+    finishedCount_.fetch_add(1, std::memory_order_release);
+    {
+      std::lock_guard<std::mutex> lock{mutex_};  // Note: avoids missed wake ups of flush
+    }
+    progressed_.notify_all();
+  }
+
+  void wakeUpConsumer() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);  // Note: pairs with the fence in deliverUntilStopped
+    if (consumerWaiting_.load(std::memory_order_relaxed)) {
+      std::lock_guard<std::mutex> lock{mutex_};
+      wakeUp_.notify_one();
+    }
+  }
+
+  [[nodiscard]] bool hasWork() const { return !queue_.empty() || hasPending_.load(std::memory_order_acquire); }
+
+  void deliverUntilStopped() {
+    for (;;) {
+      if (auto notification = queue_.tryPop()) {
+        deliver(*notification);
+        continue;
+      }
+      if (hasPending_.load(std::memory_order_acquire)) {
+        // Note: the pending notification is only delivered once the queue is drained, which preserves the order
+        if (auto pending = takePending()) {
+          deliver(*pending);
+        }
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock{mutex_};
+      consumerWaiting_.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      wakeUp_.wait(lock, [&] { return stopRequested_ || hasWork(); });
+      consumerWaiting_.store(false, std::memory_order_relaxed);
+      if (stopRequested_ && !hasWork()) {
+        return;
+      }
+    }
+  }
+
+  void deliver(const Notification& notification) {
+    subscriptionFn_(notification.updateName, notification.oldState, notification.newState);
+    markFinished();
+  }
+
+  SubscriptionFn subscriptionFn_;
+  OverflowPolicy overflowPolicy_;
+  BoundedQueue<Notification> queue_;
+
+  std::mutex pendingMutex_;
+  std::optional<Notification> pending_;
+  std::atomic<bool> hasPending_{false};
+
+  std::mutex mutex_;
+  std::condition_variable wakeUp_;
+  std::condition_variable progressed_;
+  std::atomic<bool> consumerWaiting_{false};
+  bool stopRequested_{false};
+
+  std::atomic<std::uint64_t> submittedCount_{0};
+  std::atomic<std::uint64_t> finishedCount_{0};
+  std::atomic<std::uint64_t> droppedCount_{0};
+
+  std::thread thread_;
+};
+
+}  // namespace details
+
+// AsyncSubscription is a subscription function for StateStore that decouples the store's update path from the cost of
+// the actual subscription function. Each call copies the notification (update name, old state, new state) into a
+// bounded lock-free queue, and a background thread passes the queued notifications to the wrapped subscription function
+// in order. Hence apply's latency does not depend on what the subscription does, e.g. logging or updating metrics.
+//
+// When the queue is full the overflow policy applies. With kCoalesceToLatest, overflowing notifications are merged into
+// one that carries the old state of the first and the update name and new state of the latest overflowing
+// notification, so the subscription still observes a gapless chain of states.
+//
+// Copies share the queue and the background thread. When the last copy is destroyed, all remaining notifications are
+// delivered before the thread is stopped. The wrapped subscription function must not throw.
+//
+// Example usage:
+//   auto store = makeStateStore(0, AsyncSubscription<int>{logStateChangeFn, 1024, OverflowPolicy::kDropOldest});
+template <typename TState, typename TUpdateName = std::string>
+class AsyncSubscription {
+ public:
+  using SubscriptionFn = std::function<void(const TUpdateName&, const TState&, const TState&)>;
+
+  // Constructor: Starts a background thread delivering notifications to the given subscription function, using a queue
+  // of the given capacity.
+  explicit AsyncSubscription(SubscriptionFn subscriptionFn, std::size_t capacity = 1024,
+                             OverflowPolicy overflowPolicy = OverflowPolicy::kBlock)
+      : dispatcher_{std::make_shared<Dispatcher>(std::move(subscriptionFn), capacity, overflowPolicy)} {}
+
+  // Queues a notification for the background thread.
+  void operator()(const TUpdateName& updateName, const TState& oldState, const TState& newState) const {
+    dispatcher_->post(updateName, oldState, newState);
+  }
+
+  // Waits until all notifications queued so far have been delivered or dropped.
+  void flush() const { dispatcher_->flush(); }
+
+  // Returns the number of notifications that got dropped or merged due to overflows.
+  [[nodiscard]] std::uint64_t droppedCount() const { return dispatcher_->droppedCount(); }
+
+ private:
+  using Dispatcher = details::AsyncSubscriptionDispatcher<TState, TUpdateName>;
+
+  std::shared_ptr<Dispatcher> dispatcher_;
+};
+
+}  // namespace funkypipes
+
+#endif  // FUNKYPIPES_ASYNC_SUBSCRIPTION_HPP
@@ -0,0 +1,84 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_BIND_FRONT_RELOADABLE_HPP
+#define FUNKYPIPES_BIND_FRONT_RELOADABLE_HPP
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "funkypipes/details/rcu.hpp"
+
+namespace funkypipes {
+
+// ReloadableArgs holds a snapshot of arguments to be bound by bindFrontReloadable, e.g. configuration objects like
+// thresholds or lookup tables, which can be reloaded while functions bound to them are invoked from any thread. Copies
+// share the snapshot, so one copy is bound while another one is kept for reloading.
+//
+// The snapshot is held by an RCU cell (read-copy-update): reading it is wait-free, an invocation reads it once and
+// uses it until it completes, and reload returns once all invocations using the previous snapshot completed, which is
+// then destroyed. Hence reload must not be called from within a function bound to the same arguments.
+template <typename... TArgs>
+class ReloadableArgs {
+ public:
+  using Snapshot = std::tuple<TArgs...>;
+
+  explicit ReloadableArgs(TArgs... args)
+      : rcu_{std::make_shared<details::Rcu<Snapshot>>(std::make_unique<Snapshot>(std::move(args)...))} {}
+
+  // Replaces the snapshot by the given arguments, returns once no invocation uses the previous snapshot anymore.
+  void reload(TArgs... args) { rcu_->update(std::make_unique<Snapshot>(std::move(args)...)); }
+
+  // Invokes the given function with the arguments of the current snapshot, as const lvalues, followed by the given
+  // arguments.
+  template <typename TFn, typename... TCallArgs>
+  auto invoke(TFn&& fn, TCallArgs&&... callArgs) const {
+    const auto snapshot = rcu_->read();
+    return std::apply(
+        [&](const auto&... boundArgs) {
+          return std::invoke(std::forward<TFn>(fn), boundArgs..., std::forward<TCallArgs>(callArgs)...);
+        },
+        std::as_const(*snapshot));
+  }
+
+  // Returns the number of completed reloads.
+  [[nodiscard]] std::uint64_t version() const noexcept { return rcu_->version(); }
+
+ private:
+  std::shared_ptr<details::Rcu<Snapshot>> rcu_;
+};
+
+// Returns reloadable arguments initialized with the given ones, see ReloadableArgs.
+template <typename... TArgs>
+auto makeReloadableArgs(TArgs&&... args) {
+  return ReloadableArgs<std::decay_t<TArgs>...>{std::forward<TArgs>(args)...};
+}
+
+// Decorates the given function like bindFront, but binds the arguments of the current snapshot of the given reloadable
+// arguments, which is read anew by each invocation. Thus reloaded arguments are used from the next invocation on,
+// without rebuilding pipes composed of the resulting function. The result is returned by value, as it must not refer
+// to a snapshot which may be destroyed after the invocation.
+//
+// Example usage:
+//   auto limits = makeReloadableArgs(Limits{10, 20});
+//   auto classify = bindFrontReloadable([](const Limits& current, int value) { return value > current.max; }, limits);
+//   limits.reload(Limits{10, 30});  // from any thread, while classify is invoked
+template <typename TFn, typename... TArgs>
+auto bindFrontReloadable(TFn&& fn, ReloadableArgs<TArgs...> reloadableArgs) {
+  return [fn_ = std::forward<TFn>(fn), reloadableArgs_ = std::move(reloadableArgs)](auto&&... args) mutable {
+    return reloadableArgs_.invoke(fn_, std::forward<decltype(args)>(args)...);
+  };
+}
+
+}  // namespace funkypipes
+
+#endif  // FUNKYPIPES_BIND_FRONT_RELOADABLE_HPP
@@ -0,0 +1,112 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_DERIVED_HPP
+#define FUNKYPIPES_DERIVED_HPP
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace funkypipes {
+
+namespace details {
+
+template <typename T, typename = void>
+constexpr bool IsEqualityComparable = false;
+
+template <typename T>
+constexpr bool IsEqualityComparable<T, std::void_t<decltype(std::declval<const T&>() == std::declval<const T&>())>> =
+    true;
+
+}  // namespace details
+
+// Derived is a memoized value computed from one or more inputs, which are either stores (see StateStore::derive) or
+// other derived values. Each input has a version which changes whenever its value changes. The value is computed
+// lazily when read and recomputed only if the version of any input changed since the last computation.
+//
+// A derived value has a version of its own, which changes whenever a recomputation yields a different value (compared
+// by operator== if available), so derived values composed of others are only recomputed if their inputs really
+// changed.
+//
+// Copies share the memoized value. A derived value refers to its stores, so it must not outlive them, and like a
+// StateStore it must not be used by several threads concurrently.
+//
+// Example usage:
+//   auto average = store.derive(computeAverageFn);
+//   auto isTooHot = derive([](double average) { return average > 30.0; }, average);
+//   if (isTooHot()) {...}
+template <typename TComputeFn, typename... TInputs>
+class Derived {
+ public:
+  using Value =
+      std::decay_t<std::invoke_result_t<const TComputeFn&, decltype(std::declval<const TInputs&>().value())...>>;
+
+  explicit Derived(TComputeFn computeFn, TInputs... inputs)
+      : computeFn_{std::move(computeFn)}, inputs_{std::move(inputs)...}, memo_{std::make_shared<Memo>()} {}
+
+  // Returns the value, computing it if any input changed since the last computation.
+  const Value& operator()() const { return value(); }
+
+  const Value& value() const {
+    refresh();
+    return *memo_->value;
+  }
+
+  // Returns the version of the value, computing it if any input changed since the last computation.
+  [[nodiscard]] std::uint64_t version() const {
+    refresh();
+    return memo_->version;
+  }
+
+ private:
+  using InputVersions = std::array<std::uint64_t, sizeof...(TInputs)>;
+
+  struct Memo {
+    std::optional<Value> value;
+    InputVersions inputVersions{};
+    std::uint64_t version{0};
+  };
+
+  void refresh() const {
+    const auto inputVersions =
+        std::apply([](const auto&... inputs) { return InputVersions{inputs.version()...}; }, inputs_);
+    if (memo_->value && inputVersions == memo_->inputVersions) {
+      return;
+    }
+
+    Value newValue = std::apply([this](const auto&... inputs) { return computeFn_(inputs.value()...); }, inputs_);
+    bool isChanged = true;
+    if constexpr (details::IsEqualityComparable<Value>) {
+      isChanged = !memo_->value || !(*memo_->value == newValue);
+    }
+    if (isChanged) {
+      memo_->value.emplace(std::move(newValue));
+      ++memo_->version;
+    }
+    memo_->inputVersions = inputVersions;
+  }
+
+  TComputeFn computeFn_;
+  std::tuple<TInputs...> inputs_;
+  std::shared_ptr<Memo> memo_;
+};
+
+// Returns a value derived from the given derived values by the given function, see Derived.
+template <typename TComputeFn, typename... TInputs>
+auto derive(TComputeFn&& computeFn, TInputs... inputs) {
+  return Derived<std::decay_t<TComputeFn>, TInputs...>{std::forward<TComputeFn>(computeFn), std::move(inputs)...};
+}
+
+}  // namespace funkypipes
+
+#endif  // FUNKYPIPES_DERIVED_HPP
@@ -0,0 +1,106 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_DETAILS_AGGREGATE_FIELDS_HPP
+#define FUNKYPIPES_DETAILS_AGGREGATE_FIELDS_HPP
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace funkypipes::details {
+
+// The maximum number of fields of aggregates supported by fieldsOf.
+inline constexpr std::size_t kMaxAggregateFieldCount = 16;
+
+// Converts to any field type, for probing how many initializers an aggregate accepts. Used in unevaluated contexts
+// only. Note: converting to a reference keeps the constructors of the field type out of the overload resolution.
+struct AnyField {
+  template <typename T>
+  operator T&() const;  // NOLINT implicit conversion is intended here
+};
+
+template <typename T, typename TIndices, typename = void>
+constexpr bool IsInitializableWithFields = false;
+
+template <typename T, std::size_t... Indices>
+constexpr bool IsInitializableWithFields<T, std::index_sequence<Indices...>,
+                                         std::void_t<decltype(T{(void(Indices), AnyField{})...})>> = true;
+
+// Returns the number of fields of an aggregate, which is the maximum number of initializers it accepts.
+template <typename T, std::size_t Count = 0>
+constexpr std::size_t fieldCountOf() {
+  if constexpr (Count < kMaxAggregateFieldCount + 1 &&
+                IsInitializableWithFields<T, std::make_index_sequence<Count + 1>>) {
+    return fieldCountOf<T, Count + 1>();
+  } else {
+    return Count;
+  }
+}
+
+// Returns a tuple of references to the fields of the given aggregate. Supports aggregates without base classes and
+// array fields, having up to kMaxAggregateFieldCount fields.
+template <typename T>
+auto fieldsOf(const T& value) {
+  constexpr std::size_t kCount = fieldCountOf<T>();
+  static_assert(kCount > 0 && kCount <= kMaxAggregateFieldCount, "unsupported number of aggregate fields");
+  if constexpr (kCount == 1) {
+    const auto& [f1] = value;
+    return std::tie(f1);
+  } else if constexpr (kCount == 2) {
+    const auto& [f1, f2] = value;
+    return std::tie(f1, f2);
+  } else if constexpr (kCount == 3) {
+    const auto& [f1, f2, f3] = value;
+    return std::tie(f1, f2, f3);
+  } else if constexpr (kCount == 4) {
+    const auto& [f1, f2, f3, f4] = value;
+    return std::tie(f1, f2, f3, f4);
+  } else if constexpr (kCount == 5) {
+    const auto& [f1, f2, f3, f4, f5] = value;
+    return std::tie(f1, f2, f3, f4, f5);
+  } else if constexpr (kCount == 6) {
+    const auto& [f1, f2, f3, f4, f5, f6] = value;
+    return std::tie(f1, f2, f3, f4, f5, f6);
+  } else if constexpr (kCount == 7) {
+    const auto& [f1, f2, f3, f4, f5, f6, f7] = value;
+    return std::tie(f1, f2, f3, f4, f5, f6, f7);
+  } else if constexpr (kCount == 8) {
+    const auto& [f1, f2, f3, f4, f5, f6, f7, f8] = value;
+    return std::tie(f1, f2, f3, f4, f5, f6, f7, f8);
+  } else if constexpr (kCount == 9) {
+    const auto& [f1, f2, f3, f4, f5, f6, f7, f8, f9] = value;
+    return std::tie(f1, f2, f3, f4, f5, f6, f7, f8, f9);
+  } else if constexpr (kCount == 10) {
+    const auto& [f1, f2, f3, f4, f5, f6, f7, f8, f9, f10] = value;
+    return std::tie(f1, f2, f3, f4, f5, f6, f7, f8, f9, f10);
+  } else if constexpr (kCount == 11) {
+    const auto& [f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11] = value;
+    return std::tie(f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11);
+  } else if constexpr (kCount == 12) {
+    const auto& [f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12] = value;
+    return std::tie(f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12);
+  } else if constexpr (kCount == 13) {
+    const auto& [f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13] = value;
+    return std::tie(f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13);
+  } else if constexpr (kCount == 14) {
+    const auto& [f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14] = value;
+    return std::tie(f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14);
+  } else if constexpr (kCount == 15) {
+    const auto& [f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15] = value;
+    return std::tie(f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15);
+  } else if constexpr (kCount == 16) {
+    const auto& [f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15, f16] = value;
+    return std::tie(f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15, f16);
+  }
+}
+
+}  // namespace funkypipes::details
+
+#endif  // FUNKYPIPES_DETAILS_AGGREGATE_FIELDS_HPP
@@ -0,0 +1,106 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_DETAILS_BOUNDED_QUEUE_HPP
+#define FUNKYPIPES_DETAILS_BOUNDED_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace funkypipes::details {
+
+// A bounded lock-free multi-producer multi-consumer queue based on a ring buffer of sequence-stamped cells (D. Vyukov's
+// design). Each cell's sequence number tells whether it is ready to be written or read in the current lap, so
+// producers and consumers only contend on their respective position counter.
+template <typename T>
+class BoundedQueue {
+ public:
+  // Constructor: Creates a queue able to hold the given number of elements. The capacity is rounded up to the next
+  // power of two, but at least two.
+  explicit BoundedQueue(std::size_t capacity) : mask_{roundUpToPowerOfTwo(capacity) - 1}, cells_{new Cell[mask_ + 1]} {
+    for (std::size_t idx = 0; idx <= mask_; ++idx) {
+      cells_[idx].sequence.store(idx, std::memory_order_relaxed);
+    }
+  }
+
+  // Appends the given value unless the queue is full. Returns whether the value got appended.
+  bool tryPush(T&& value) {
+    std::size_t position = enqueuePosition_.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell& cell = cells_[position & mask_];
+      const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+      if (difference == 0) {
+        if (enqueuePosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+          cell.value.emplace(std::move(value));
+          cell.sequence.store(position + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (difference < 0) {
+        return false;  // Note: the cell still holds a value of the previous lap, so the queue is full
+      } else {
+        position = enqueuePosition_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Removes and returns the oldest value, or nothing if the queue is empty.
+  std::optional<T> tryPop() {
+    std::size_t position = dequeuePosition_.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell& cell = cells_[position & mask_];
+      const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+      if (difference == 0) {
+        if (dequeuePosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+          std::optional<T> value{std::move(cell.value)};
+          cell.value.reset();
+          cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+          return value;
+        }
+      } else if (difference < 0) {
+        return std::nullopt;  // Note: the cell has not been written in this lap, so the queue is empty
+      } else {
+        position = dequeuePosition_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Returns whether the queue is empty. Only a snapshot in the presence of concurrent operations.
+  [[nodiscard]] bool empty() const {
+    return enqueuePosition_.load(std::memory_order_seq_cst) == dequeuePosition_.load(std::memory_order_seq_cst);
+  }
+
+ private:
+  struct Cell {
+    std::atomic<std::size_t> sequence;
+    std::optional<T> value;
+  };
+
+  static std::size_t roundUpToPowerOfTwo(std::size_t value) {
+    std::size_t result = 2;  // Note: the algorithm requires at least two cells
+    while (result < value) {
+      result <<= 1U;
+    }
+    return result;
+  }
+
+  static constexpr std::size_t kCacheLineSize = 64;
+
+  const std::size_t mask_;
+  const std::unique_ptr<Cell[]> cells_;
+  alignas(kCacheLineSize) std::atomic<std::size_t> enqueuePosition_{0};
+  alignas(kCacheLineSize) std::atomic<std::size_t> dequeuePosition_{0};
+};
+
+}  // namespace funkypipes::details
+
+#endif  // FUNKYPIPES_DETAILS_BOUNDED_QUEUE_HPP
@@ -0,0 +1,81 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_DETAILS_DYNAMIC_STAGE_HPP
+#define FUNKYPIPES_DETAILS_DYNAMIC_STAGE_HPP
+
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "funkypipes/details/invoke_packed.hpp"
+#include "funkypipes/details/traits.hpp"
+
+namespace funkypipes::details {
+
+// A type-erased stage of a dynamic pipe. Stages are stored consecutively, each stage invokes its function with the
+// given input and passes the result on to the stage after it, which is why a call of a dynamic pipe costs a single
+// indirect call per stage. The last stage is a sink storing its input in the given output. Stages returning an empty
+// std::optional break the chain, values of non-empty ones are passed on.
+struct DynamicStage {
+  using InvokeFn = void (*)(const DynamicStage* stage, void* input, void* output);
+
+  std::unique_ptr<void, void (*)(void*)> fn;
+  InvokeFn invoke;
+};
+
+template <typename TIn, typename TOut, typename TFn>
+void invokeDynamicStage(const DynamicStage* stage, void* input, void* output) {
+  auto& fn = *static_cast<TFn*>(stage->fn.get());
+  // Note: the result is stored by value, as the next stage moves from it
+  auto result = invokePacked(fn, std::move(*static_cast<TIn*>(input)));
+  const DynamicStage* nextStage = stage + 1;
+  if constexpr (IsOptional<decltype(result)>::value) {
+    if (result.has_value()) {
+      nextStage->invoke(nextStage, &*result, output);
+    }
+  } else {
+    nextStage->invoke(nextStage, &result, output);
+  }
+}
+
+template <typename TOut>
+void storeDynamicOutput(const DynamicStage* /*stage*/, void* input, void* output) {
+  static_cast<std::optional<TOut>*>(output)->emplace(std::move(*static_cast<TOut*>(input)));
+}
+
+// Returns whether the given function is a valid stage taking TIn and returning TOut, optionally wrapped in a
+// std::optional to be able to break the chain.
+template <typename TIn, typename TOut, typename TFn>
+constexpr bool isDynamicStageFn() {
+  if constexpr (!isInvocablePacked<TFn&, TIn&&>()) {
+    return false;
+  } else {
+    using Result = std::decay_t<decltype(invokePacked(std::declval<TFn&>(), std::declval<TIn&&>()))>;
+    return std::is_same_v<Result, TOut> || std::is_same_v<Result, std::optional<TOut>>;
+  }
+}
+
+template <typename TIn, typename TOut, typename TFn>
+DynamicStage makeDynamicStage(TFn&& fn) {
+  using Fn = std::decay_t<TFn>;
+  static_assert(isDynamicStageFn<TIn, TOut, Fn>(),
+                "A stage must be invocable with its input type and return its output type or an optional of it.");
+  return DynamicStage{{new Fn(std::forward<TFn>(fn)), [](void* fnToDelete) { delete static_cast<Fn*>(fnToDelete); }},
+                      &invokeDynamicStage<TIn, TOut, Fn>};
+}
+
+template <typename TOut>
+DynamicStage makeDynamicSink() {
+  return DynamicStage{{nullptr, [](void* /*fn*/) {}}, &storeDynamicOutput<TOut>};
+}
+
+}  // namespace funkypipes::details
+
+#endif  // FUNKYPIPES_DETAILS_DYNAMIC_STAGE_HPP
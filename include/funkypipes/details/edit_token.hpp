@@ -0,0 +1,54 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_DETAILS_EDIT_TOKEN_HPP
+#define FUNKYPIPES_DETAILS_EDIT_TOKEN_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace funkypipes::details {
+
+// Identifies the edit that created a node of a persistent container. Each modification of a persistent container is
+// an edit with a token of its own, as is each transient. Nodes created by an edit are not shared with any other
+// container until the edit completed, so the edit may modify them in place.
+using EditToken = std::uint64_t;
+
+// The owner of nodes that no edit may modify in place.
+inline constexpr EditToken kPersistentEditToken = 0;
+
+// Returns a token that differs from all tokens returned before. Tokens are reserved in blocks per thread, so that
+// concurrent edits do not contend on a shared counter.
+inline EditToken makeEditToken() {
+  constexpr EditToken kBlockSize = 1024;
+  static std::atomic<EditToken> nextBlock{kPersistentEditToken + 1};
+  thread_local EditToken nextToken = 0;
+  thread_local EditToken blockEnd = 0;
+  if (nextToken == blockEnd) {
+    nextToken = nextBlock.fetch_add(kBlockSize, std::memory_order_relaxed);
+    blockEnd = nextToken + kBlockSize;
+  }
+  return nextToken++;
+}
+
+// Makes the given node modifiable for the edit with the given token: a node created by that edit is returned as is,
+// any other node is replaced by a copy owned by the edit.
+template <typename TNode>
+TNode& makeEditable(std::shared_ptr<TNode>& node, EditToken token) {
+  if (node->owner != token) {
+    auto copy = std::make_shared<TNode>(*node);
+    copy->owner = token;
+    node = std::move(copy);
+  }
+  return *node;
+}
+
+}  // namespace funkypipes::details
+
+#endif  // FUNKYPIPES_DETAILS_EDIT_TOKEN_HPP
@@ -0,0 +1,78 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_DETAILS_INVOKE_PACKED_HPP
+#define FUNKYPIPES_DETAILS_INVOKE_PACKED_HPP
+
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "funkypipes/details/tuple/tuple_traits.hpp"
+
+namespace funkypipes::details {
+
+template <typename TFn, typename TTuple, std::size_t... kIndices>
+constexpr bool isApplicable(std::index_sequence<kIndices...> /*indices*/) {
+  return std::is_invocable_v<TFn, decltype(std::get<kIndices>(std::declval<TTuple>()))...>;
+}
+
+template <typename TFn, typename TArg>
+constexpr bool isApplicable() {
+  if constexpr (IsTuple<std::decay_t<TArg>>) {
+    return isApplicable<TFn, TArg>(std::make_index_sequence<std::tuple_size_v<std::decay_t<TArg>>>{});
+  } else {
+    return false;
+  }
+}
+
+// Invokes the given function with the given arguments following the conventions of makePipe: arguments are forwarded
+// directly if possible, otherwise zero or multiple arguments are packed into a tuple and a single tuple argument is
+// unpacked.
+template <typename TFn, typename... TArgs>
+decltype(auto) invokePacked(TFn&& fn, TArgs&&... args) {
+  if constexpr (std::is_invocable_v<TFn, TArgs...>) {
+    return std::invoke(std::forward<TFn>(fn), std::forward<TArgs>(args)...);
+  } else if constexpr (sizeof...(TArgs) != 1) {
+    return std::invoke(std::forward<TFn>(fn), std::forward_as_tuple(std::forward<TArgs>(args)...));
+  } else {
+    return std::apply(std::forward<TFn>(fn), std::forward<TArgs>(args)...);
+  }
+}
+
+// Returns whether the given function can be invoked by invokePacked with the given arguments.
+template <typename TFn, typename... TArgs>
+constexpr bool isInvocablePacked() {
+  if constexpr (std::is_invocable_v<TFn, TArgs...>) {
+    return true;
+  } else if constexpr (sizeof...(TArgs) != 1) {
+    return std::is_invocable_v<TFn, std::tuple<TArgs&&...>>;
+  } else {
+    return isApplicable<TFn, TArgs...>();
+  }
+}
+
+// Returns whether the given function can be invoked by invokePacked with the given arguments, returning a result
+// convertible to the given result type. References are only returned for references, never bound to temporaries.
+template <typename TResult, typename TFn, typename... TArgs>
+constexpr bool isInvocablePackedReturning() {
+  if constexpr (!isInvocablePacked<TFn, TArgs...>()) {
+    return false;
+  } else if constexpr (std::is_void_v<TResult>) {
+    return true;
+  } else {
+    using Result = decltype(invokePacked(std::declval<TFn>(), std::declval<TArgs>()...));
+    return std::is_convertible_v<Result, TResult> && (!std::is_reference_v<TResult> || std::is_reference_v<Result>);
+  }
+}
+
+}  // namespace funkypipes::details
+
+#endif  // FUNKYPIPES_DETAILS_INVOKE_PACKED_HPP
@@ -0,0 +1,242 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_DETAILS_JOURNAL_HPP
+#define FUNKYPIPES_DETAILS_JOURNAL_HPP
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "funkypipes/details/mapped_file.hpp"
+
+namespace funkypipes::details {
+
+// The files of a journal directory are named by a kind prefix and a sequence number: journal files by the sequence
+// number of their first record, snapshot files by the sequence number of the last update they include.
+inline constexpr std::string_view kJournalFilePrefix = "journal-";
+inline constexpr std::string_view kSnapshotFilePrefix = "snapshot-";
+
+inline constexpr std::uint64_t kJournalFileMagic = 0x314c4e524a5046ULL;   // "FPJRNL1"
+inline constexpr std::uint64_t kSnapshotFileMagic = 0x3150414e535046ULL;  // "FPSNAP1"
+
+// FNV-1a checksum, used to detect records and snapshots that were written incompletely.
+inline std::uint32_t checksumOf(std::string_view bytes, std::uint32_t checksum = 2166136261U) {
+  for (const char byte : bytes) {
+    checksum = (checksum ^ static_cast<unsigned char>(byte)) * 16777619U;
+  }
+  return checksum;
+}
+
+inline std::filesystem::path journalFilePathOf(const std::filesystem::path& directory, std::string_view prefix,
+                                               std::uint64_t sequence) {
+  char number[21];
+  std::snprintf(number, sizeof(number), "%020llu", static_cast<unsigned long long>(sequence));
+  return directory / (std::string{prefix} + number);
+}
+
+// Returns the sequence numbers of the directory's files with the given prefix in ascending order.
+inline std::vector<std::uint64_t> journalFileSequencesOf(const std::filesystem::path& directory,
+                                                         std::string_view prefix) {
+  std::vector<std::uint64_t> sequences;
+  for (const auto& entry : std::filesystem::directory_iterator{directory}) {
+    const std::string fileName = entry.path().filename().string();
+    const std::string_view number = std::string_view{fileName}.substr(std::min(prefix.size(), fileName.size()));
+    if (fileName.compare(0, prefix.size(), prefix) == 0 && number.size() == 20 &&
+        std::all_of(number.begin(), number.end(), [](char digit) { return digit >= '0' && digit <= '9'; })) {
+      sequences.push_back(std::stoull(std::string{number}));
+    }
+  }
+  std::sort(sequences.begin(), sequences.end());
+  return sequences;
+}
+
+// Makes changes to the directory's entries (created, renamed and removed files) durable.
+inline void syncDirectory(const std::filesystem::path& directory) {
+  const int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (fd == -1 || ::fsync(fd) == -1) {
+    const int error = errno;
+    if (fd != -1) {
+      ::close(fd);
+    }
+    throw std::system_error(error, std::generic_category(), "fsync directory");
+  }
+  ::close(fd);
+}
+
+struct JournalFileHeader {
+  std::uint64_t magic;
+  std::uint64_t firstSequence;
+};
+
+// Each record is aligned to 8 bytes and consists of this header followed by the payload. Unused space of a journal file
+// is zero, so a record size of zero marks the end of the records.
+struct JournalRecordHeader {
+  std::uint32_t payloadSize;
+  std::uint32_t checksum;
+  std::uint64_t sequence;
+};
+
+inline std::size_t alignedRecordSizeOf(std::size_t payloadSize) {
+  return (sizeof(JournalRecordHeader) + payloadSize + 7) & ~std::size_t{7};
+}
+
+// Appends records to a memory mapped journal file of fixed size. Appending only writes to memory, so the records
+// survive a crash of the process immediately, but need to be synced to survive a crash of the system.
+class JournalWriter {
+ public:
+  // Creates the journal file for records starting at the given sequence number, sized for at least one record of the
+  // given payload size.
+  JournalWriter(const std::filesystem::path& directory, std::uint64_t firstSequence, std::size_t fileSize,
+                std::size_t minPayloadSize)
+      : firstSequence_{firstSequence},
+        file_{MappedFile::create(journalFilePathOf(directory, kJournalFilePrefix, firstSequence).string(),
+                                 std::max(fileSize, sizeof(JournalFileHeader) + alignedRecordSizeOf(minPayloadSize)))},
+        offset_{sizeof(JournalFileHeader)} {
+    const JournalFileHeader header{kJournalFileMagic, firstSequence};
+    std::memcpy(file_.data(), &header, sizeof(header));
+    syncDirectory(directory);
+  }
+
+  [[nodiscard]] std::uint64_t firstSequence() const { return firstSequence_; }
+
+  // Appends a record unless the file is too full for it, in which case false is returned.
+  bool tryAppend(std::uint64_t sequence, std::string_view payload) {
+    const std::size_t recordSize = alignedRecordSizeOf(payload.size());
+    if (file_.size() - offset_ < recordSize) {
+      return false;
+    }
+    const JournalRecordHeader header{static_cast<std::uint32_t>(payload.size()), checksumOf(payload), sequence};
+    std::memcpy(file_.data() + offset_ + sizeof(header), payload.data(), payload.size());
+    std::memcpy(file_.data() + offset_, &header, sizeof(header));
+    offset_ += recordSize;
+    return true;
+  }
+
+  void sync() const { file_.sync(); }
+
+ private:
+  std::uint64_t firstSequence_;
+  MappedFile file_;
+  std::size_t offset_;
+};
+
+// Calls fn(sequence, payload) for the records of the given journal file in order, as long as fn returns true. Stops at
+// the first record that was written incompletely. Returns false if stopped early.
+template <typename TFn>
+bool forEachJournalRecord(const std::filesystem::path& path, TFn&& fn) {
+  const MappedFile file = MappedFile::openReadOnly(path.string());
+  JournalFileHeader fileHeader{};
+  if (file.size() < sizeof(fileHeader)) {
+    return false;
+  }
+  std::memcpy(&fileHeader, file.data(), sizeof(fileHeader));
+  if (fileHeader.magic != kJournalFileMagic) {
+    return false;
+  }
+
+  std::size_t offset = sizeof(fileHeader);
+  while (file.size() - offset >= sizeof(JournalRecordHeader)) {
+    JournalRecordHeader header{};
+    std::memcpy(&header, file.data() + offset, sizeof(header));
+    if (header.payloadSize == 0 && header.sequence == 0) {
+      return true;
+    }
+    if (file.size() - offset < alignedRecordSizeOf(header.payloadSize)) {
+      return false;
+    }
+    const std::string_view payload{file.data() + offset + sizeof(header), header.payloadSize};
+    if (checksumOf(payload) != header.checksum || !fn(header.sequence, payload)) {
+      return false;
+    }
+    offset += alignedRecordSizeOf(header.payloadSize);
+  }
+  return true;
+}
+
+struct SnapshotFileHeader {
+  std::uint64_t magic;
+  std::uint64_t sequence;
+  std::uint64_t payloadSize;
+  std::uint64_t checksum;
+};
+
+// Writes a snapshot file including the updates up to the given sequence number. The file is written under a temporary
+// name and renamed once it is durable, so a snapshot file is either complete or missing.
+inline void writeSnapshotFile(const std::filesystem::path& directory, std::uint64_t sequence,
+                              std::string_view payload) {
+  const auto path = journalFilePathOf(directory, kSnapshotFilePrefix, sequence);
+  const auto temporaryPath = std::filesystem::path{path}.concat(".tmp");
+
+  const int fd = ::open(temporaryPath.c_str(), O_CREAT | O_WRONLY | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+  if (fd == -1) {
+    throw std::system_error(errno, std::generic_category(), "open");
+  }
+  const SnapshotFileHeader header{kSnapshotFileMagic, sequence, payload.size(), checksumOf(payload)};
+  const auto writeAll = [fd](const char* data, std::size_t size) {
+    while (size > 0) {
+      const ssize_t written = ::write(fd, data, size);
+      if (written == -1 && errno != EINTR) {
+        return false;
+      }
+      if (written > 0) {
+        data += written;
+        size -= static_cast<std::size_t>(written);
+      }
+    }
+    return true;
+  };
+  if (!writeAll(reinterpret_cast<const char*>(&header), sizeof(header)) ||
+      !writeAll(payload.data(), payload.size()) || ::fdatasync(fd) == -1) {
+    const int error = errno;
+    ::close(fd);
+    std::filesystem::remove(temporaryPath);
+    throw std::system_error(error, std::generic_category(), "write snapshot");
+  }
+  ::close(fd);
+
+  std::filesystem::rename(temporaryPath, path);
+  syncDirectory(directory);
+}
+
+// Calls fn(sequence, payload) with the contents of the given snapshot file, which is mapped rather than read. Returns
+// false without calling fn if the file is not a complete snapshot.
+template <typename TFn>
+bool readSnapshotFile(const std::filesystem::path& path, TFn&& fn) {
+  const MappedFile file = MappedFile::openReadOnly(path.string());
+  SnapshotFileHeader header{};
+  if (file.size() < sizeof(header)) {
+    return false;
+  }
+  std::memcpy(&header, file.data(), sizeof(header));
+  if (header.magic != kSnapshotFileMagic || file.size() - sizeof(header) != header.payloadSize) {
+    return false;
+  }
+  const std::string_view payload{file.data() + sizeof(header), static_cast<std::size_t>(header.payloadSize)};
+  if (checksumOf(payload) != header.checksum) {
+    return false;
+  }
+  fn(header.sequence, payload);
+  return true;
+}
+
+}  // namespace funkypipes::details
+
+#endif  // FUNKYPIPES_DETAILS_JOURNAL_HPP
@@ -0,0 +1,56 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_DETAILS_LENS_STEP_HPP
+#define FUNKYPIPES_DETAILS_LENS_STEP_HPP
+
+#include <type_traits>
+#include <utility>
+
+namespace funkypipes::details {
+
+// Whether the part of the container at the given key can be modified in place, which is the case if the non-const at
+// returns a non-const reference (std containers) but not for immutable containers (see persistent_vector.hpp).
+template <typename TContainer, typename TKey, typename = void>
+constexpr bool IsModifiableAt = false;
+
+template <typename TContainer, typename TKey>
+constexpr bool IsModifiableAt<TContainer, TKey,
+                              std::void_t<decltype(std::declval<TContainer&>().at(std::declval<const TKey&>()))>> =
+    std::is_lvalue_reference_v<decltype(std::declval<TContainer&>().at(std::declval<const TKey&>()))> &&
+    !std::is_const_v<std::remove_reference_t<decltype(std::declval<TContainer&>().at(std::declval<const TKey&>()))>>;
+
+// Returns the part of the whole selected by the step, which is either a pointer to a data member or a key passed to
+// the whole's at.
+template <typename TWhole, typename TStep>
+const auto& partOf(const TWhole& whole, const TStep& step) {
+  if constexpr (std::is_member_object_pointer_v<TStep>) {
+    return whole.*step;
+  } else {
+    return whole.at(step);
+  }
+}
+
+// Calls the function with a modifiable reference to the part of the whole selected by the step. A part of an immutable
+// container is modified on a copy, which then replaces the original part via the container's set.
+template <typename TWhole, typename TStep, typename TFn>
+void modifyPartOf(TWhole& whole, const TStep& step, TFn&& fn) {
+  if constexpr (std::is_member_object_pointer_v<TStep>) {
+    std::forward<TFn>(fn)(whole.*step);
+  } else if constexpr (IsModifiableAt<TWhole, TStep>) {
+    std::forward<TFn>(fn)(whole.at(step));
+  } else {
+    auto part = whole.at(step);
+    std::forward<TFn>(fn)(part);
+    whole = whole.set(step, std::move(part));
+  }
+}
+
+}  // namespace funkypipes::details
+
+#endif  // FUNKYPIPES_DETAILS_LENS_STEP_HPP
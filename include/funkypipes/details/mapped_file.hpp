@@ -0,0 +1,109 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_DETAILS_MAPPED_FILE_HPP
+#define FUNKYPIPES_DETAILS_MAPPED_FILE_HPP
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <system_error>
+#include <utility>
+
+namespace funkypipes::details {
+
+// RAII wrapper around a memory mapped file (open + mmap). A created file is mapped read-write and its descriptor is
+// kept for syncing, an existing file can be mapped read-only. Failing system calls are reported by throwing
+// std::system_error.
+class MappedFile {
+ public:
+  // Creates (or replaces) the file with the given size, filled with zeros, and maps it read-write.
+  static MappedFile create(const std::string& path, std::size_t size) {
+    const int fd = ::open(path.c_str(), O_CREAT | O_RDWR | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    throwOnFailure(fd == -1, "open");
+    if (::ftruncate(fd, static_cast<off_t>(size)) == -1) {
+      const int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), "ftruncate");
+    }
+    return MappedFile{fd, size, PROT_READ | PROT_WRITE};
+  }
+
+  // Maps the whole existing file read-only.
+  static MappedFile openReadOnly(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    throwOnFailure(fd == -1, "open");
+    struct stat status {};
+    if (::fstat(fd, &status) == -1) {
+      const int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), "fstat");
+    }
+    return MappedFile{fd, static_cast<std::size_t>(status.st_size), PROT_READ};
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile(MappedFile&& other) noexcept
+      : fd_{std::exchange(other.fd_, -1)}, data_{std::exchange(other.data_, nullptr)}, size_{other.size_} {}
+  MappedFile& operator=(MappedFile&&) = delete;
+
+  ~MappedFile() {
+    if (data_ != nullptr) {
+      ::munmap(data_, size_);
+    }
+    if (fd_ != -1) {
+      ::close(fd_);
+    }
+  }
+
+  [[nodiscard]] char* data() const { return data_; }
+  [[nodiscard]] std::size_t size() const { return size_; }
+
+  // Writes the file's modified pages and the metadata needed to read them to the storage device.
+  void sync() const { throwOnFailure(::fdatasync(fd_) == -1, "fdatasync"); }
+
+ private:
+  MappedFile(int fd, std::size_t size, int protection) : size_{size} {
+    if (size == 0) {
+      ::close(fd);  // Note: empty files cannot be mapped, they are represented by a null mapping
+      return;
+    }
+    void* data = ::mmap(nullptr, size, protection, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+      const int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), "mmap");
+    }
+    data_ = static_cast<char*>(data);
+    if ((protection & PROT_WRITE) != 0) {
+      fd_ = fd;
+    } else {
+      ::close(fd);  // Note: the mapping stays valid after closing the descriptor
+    }
+  }
+
+  static void throwOnFailure(bool failed, const char* what) {
+    if (failed) {
+      throw std::system_error(errno, std::generic_category(), what);
+    }
+  }
+
+  int fd_{-1};
+  char* data_{nullptr};
+  std::size_t size_;
+};
+
+}  // namespace funkypipes::details
+
+#endif  // FUNKYPIPES_DETAILS_MAPPED_FILE_HPP
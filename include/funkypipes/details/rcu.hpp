@@ -0,0 +1,131 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_DETAILS_RCU_HPP
+#define FUNKYPIPES_DETAILS_RCU_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace funkypipes::details {
+
+// A read-copy-update cell holding a value on the heap. Readers access the current value via a ReadGuard, which is
+// wait-free: it increments a reader counter, loads the pointer to the value and decrements the counter when released.
+// An update publishes a new value and then waits until all readers that may still access the old value are released
+// (the grace period), before the old value is destroyed.
+//
+// Reader counters come in two sets, selected by the parity of an epoch which an update flips twice, so that readers
+// starting during the grace period do not prolong it. Each set is striped over several cache lines to keep readers of
+// different threads from contending.
+//
+// Updates are serialized by a mutex. An update must not be made while the updating thread holds a ReadGuard of the
+// same cell, as it would wait for itself.
+template <typename T>
+class Rcu {
+ public:
+  // Grants access to the value that was current when the guard was created, for as long as the guard lives.
+  class ReadGuard {
+   public:
+    explicit ReadGuard(const Rcu& rcu) noexcept;
+    ~ReadGuard() { counter_->fetch_sub(1, std::memory_order_release); }
+    ReadGuard(const ReadGuard&) = delete;
+    ReadGuard& operator=(const ReadGuard&) = delete;
+    ReadGuard(ReadGuard&&) = delete;
+    ReadGuard& operator=(ReadGuard&&) = delete;
+
+    T& operator*() const noexcept { return *value_; }
+    T* operator->() const noexcept { return value_; }
+
+   private:
+    std::atomic<std::uint64_t>* counter_;
+    T* value_;
+  };
+
+  explicit Rcu(std::unique_ptr<T> value) : value_{value.release()} {}
+  Rcu(const Rcu&) = delete;
+  Rcu& operator=(const Rcu&) = delete;
+  Rcu(Rcu&&) = delete;
+  Rcu& operator=(Rcu&&) = delete;
+  ~Rcu() { delete value_.load(std::memory_order_relaxed); }
+
+  [[nodiscard]] ReadGuard read() const noexcept { return ReadGuard{*this}; }
+
+  // Publishes the given value and destroys the previous one once no reader accesses it anymore.
+  void update(std::unique_ptr<T> value);
+
+  // Returns the number of completed updates.
+  [[nodiscard]] std::uint64_t version() const noexcept { return version_.load(std::memory_order_acquire); }
+
+ private:
+  static constexpr std::size_t kCacheLineSize = 64;
+  static constexpr std::size_t kStripeCount = 16;
+
+  struct alignas(kCacheLineSize) Stripe {
+    std::atomic<std::uint64_t> readerCount{0};
+  };
+
+  using Stripes = std::array<Stripe, kStripeCount>;
+
+  // Returns the stripe index of the calling thread, assigned round robin on first use.
+  static std::size_t stripeIndexOfThisThread() noexcept;
+
+  // Waits until no reader holds a guard counted by the stripes of the given parity.
+  void awaitReadersOf(std::uint64_t parity) const;
+
+  std::atomic<T*> value_;
+  std::atomic<std::uint64_t> epoch_{0};
+  std::atomic<std::uint64_t> version_{0};
+  mutable std::array<Stripes, 2> stripesOfParity_{};
+  std::mutex updateMutex_;
+};
+
+template <typename T>
+Rcu<T>::ReadGuard::ReadGuard(const Rcu& rcu) noexcept
+    : counter_{&rcu.stripesOfParity_[rcu.epoch_.load(std::memory_order_relaxed) & 1U][stripeIndexOfThisThread()]
+                    .readerCount} {
+  // Note: seq_cst orders the increment before the load of the value, see update
+  counter_->fetch_add(1, std::memory_order_seq_cst);
+  value_ = rcu.value_.load(std::memory_order_seq_cst);
+}
+
+template <typename T>
+void Rcu<T>::update(std::unique_ptr<T> value) {
+  std::lock_guard<std::mutex> lock{updateMutex_};
+  std::unique_ptr<T> previousValue{value_.exchange(value.release(), std::memory_order_seq_cst)};
+
+  // Note: a reader either incremented its counter before it is awaited below, or it loads the new value. Both sets are
+  // awaited, as a reader may have read the epoch before any number of flips.
+  awaitReadersOf(epoch_.fetch_add(1, std::memory_order_seq_cst) & 1U);
+  awaitReadersOf(epoch_.fetch_add(1, std::memory_order_seq_cst) & 1U);
+  version_.fetch_add(1, std::memory_order_release);
+}
+
+template <typename T>
+std::size_t Rcu<T>::stripeIndexOfThisThread() noexcept {
+  static std::atomic<std::size_t> nextStripeIndex{0};
+  thread_local const std::size_t stripeIndex = nextStripeIndex.fetch_add(1, std::memory_order_relaxed) % kStripeCount;
+  return stripeIndex;
+}
+
+template <typename T>
+void Rcu<T>::awaitReadersOf(std::uint64_t parity) const {
+  for (const Stripe& stripe : stripesOfParity_[parity]) {
+    while (stripe.readerCount.load(std::memory_order_seq_cst) != 0) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+}  // namespace funkypipes::details
+
+#endif  // FUNKYPIPES_DETAILS_RCU_HPP
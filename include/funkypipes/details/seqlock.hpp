@@ -0,0 +1,104 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_DETAILS_SEQLOCK_HPP
+#define FUNKYPIPES_DETAILS_SEQLOCK_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <thread>
+#include <type_traits>
+
+namespace funkypipes::details {
+
+// A sequence lock protecting a trivially copyable value. A single writer stores values in place while any number of
+// readers copy optimistically and retry whenever the sequence number changed during their copy. Readers never block
+// the writer and never write to shared memory, which also allows them to operate on read-only mappings.
+//
+// The value is kept in an array of relaxed atomic words instead of a plain object. This keeps concurrent reads and
+// writes free of data races in terms of the C++ memory model, while compiling to plain loads and stores.
+//
+// Writers need to be serialized externally. The type is standard layout and address free, so it can be placed in
+// memory shared between processes.
+template <typename T>
+class Seqlock {
+  static_assert(std::is_trivially_copyable_v<T>, "Seqlock requires a trivially copyable type");
+  static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Seqlock requires lock-free 64 bit atomics");
+
+  using Word = std::uint64_t;
+  static constexpr std::size_t kWordCount = (sizeof(T) + sizeof(Word) - 1) / sizeof(Word);
+  using WordBuffer = std::array<Word, kWordCount>;
+
+ public:
+  explicit Seqlock(const T& value = T{}) {
+    WordBuffer buffer{};
+    std::memcpy(buffer.data(), &value, sizeof(T));
+    for (std::size_t idx = 0; idx < kWordCount; ++idx) {
+      words_[idx].store(buffer[idx], std::memory_order_relaxed);
+    }
+  }
+
+  // Returns a consistent copy of the stored value. Retries, yielding the processor, while a write is in progress, so it
+  // spins as long as a writer is suspended (or died) in the middle of a store, see tryLoad for bounding the retries.
+  [[nodiscard]] T load() const {
+    for (;;) {
+      if (auto value = tryLoad()) {
+        return *value;
+      }
+      std::this_thread::yield();
+    }
+  }
+
+  // Returns a consistent copy of the stored value, or nothing if a write was in progress.
+  [[nodiscard]] std::optional<T> tryLoad() const {
+    const auto sequenceBefore = sequence_.load(std::memory_order_acquire);
+    if ((sequenceBefore & 1U) != 0U) {
+      return std::nullopt;
+    }
+    WordBuffer buffer{};
+    for (std::size_t idx = 0; idx < kWordCount; ++idx) {
+      buffer[idx] = words_[idx].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence_.load(std::memory_order_relaxed) != sequenceBefore) {
+      return std::nullopt;
+    }
+    T value;
+    std::memcpy(&value, buffer.data(), sizeof(T));
+    return value;
+  }
+
+  // Overwrites the stored value. Must not be called concurrently with other stores.
+  void store(const T& value) {
+    WordBuffer buffer{};
+    std::memcpy(buffer.data(), &value, sizeof(T));
+
+    const auto sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (std::size_t idx = 0; idx < kWordCount; ++idx) {
+      words_[idx].store(buffer[idx], std::memory_order_relaxed);
+    }
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  // Returns the number of completed stores.
+  [[nodiscard]] std::uint64_t version() const { return sequence_.load(std::memory_order_acquire) / 2; }
+
+ private:
+  std::atomic<std::uint64_t> sequence_{0};
+  std::array<std::atomic<Word>, kWordCount> words_;
+};
+
+}  // namespace funkypipes::details
+
+#endif  // FUNKYPIPES_DETAILS_SEQLOCK_HPP
@@ -0,0 +1,107 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_DETAILS_SHARED_MEMORY_MAPPING_HPP
+#define FUNKYPIPES_DETAILS_SHARED_MEMORY_MAPPING_HPP
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <system_error>
+#include <utility>
+
+namespace funkypipes::details {
+
+// RAII wrapper around a POSIX shared memory segment (shm_open + mmap). The creating side maps the segment read-write
+// and removes its name on destruction, the opening side maps an existing segment read-only. Failing system calls are
+// reported by throwing std::system_error.
+class SharedMemoryMapping {
+ public:
+  // Creates the named segment with the given size and maps it read-write. The name of an existing segment is removed
+  // first, so its readers keep mapping the old segment instead of observing it being truncated, while creating fails
+  // if another writer created the segment meanwhile.
+  static SharedMemoryMapping create(std::string name, std::size_t size) {
+    throwOnFailure(::shm_unlink(name.c_str()) == -1 && errno != ENOENT, "shm_unlink");
+    const int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    throwOnFailure(fd == -1, "shm_open");
+    if (::ftruncate(fd, static_cast<off_t>(size)) == -1) {
+      const int error = errno;
+      ::close(fd);
+      ::shm_unlink(name.c_str());
+      throw std::system_error(error, std::generic_category(), "ftruncate");
+    }
+    return SharedMemoryMapping{std::move(name), fd, size, PROT_READ | PROT_WRITE, true};
+  }
+
+  // Maps the existing named segment read-only. The segment needs to be at least of the given size.
+  static SharedMemoryMapping openReadOnly(std::string name, std::size_t size) {
+    const int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    throwOnFailure(fd == -1, "shm_open");
+    struct stat status {};
+    if (::fstat(fd, &status) == -1 || static_cast<std::size_t>(status.st_size) < size) {
+      ::close(fd);
+      throw std::system_error(std::make_error_code(std::errc::invalid_argument), "shared memory segment too small");
+    }
+    return SharedMemoryMapping{std::move(name), fd, size, PROT_READ, false};
+  }
+
+  SharedMemoryMapping(const SharedMemoryMapping&) = delete;
+  SharedMemoryMapping& operator=(const SharedMemoryMapping&) = delete;
+  SharedMemoryMapping(SharedMemoryMapping&& other) noexcept
+      : name_{std::move(other.name_)},
+        address_{std::exchange(other.address_, nullptr)},
+        size_{other.size_},
+        isOwner_{std::exchange(other.isOwner_, false)} {}
+  SharedMemoryMapping& operator=(SharedMemoryMapping&&) = delete;
+
+  ~SharedMemoryMapping() {
+    if (address_ != nullptr) {
+      ::munmap(address_, size_);
+    }
+    if (isOwner_) {
+      ::shm_unlink(name_.c_str());
+    }
+  }
+
+  [[nodiscard]] void* address() const { return address_; }
+
+ private:
+  SharedMemoryMapping(std::string name, int fd, std::size_t size, int protection, bool isOwner)
+      : name_{std::move(name)}, size_{size}, isOwner_{isOwner} {
+    void* address = ::mmap(nullptr, size, protection, MAP_SHARED, fd, 0);
+    const int error = errno;
+    ::close(fd);  // Note: the mapping stays valid after closing the descriptor
+    if (address == MAP_FAILED) {
+      if (isOwner) {
+        ::shm_unlink(name_.c_str());
+      }
+      throw std::system_error(error, std::generic_category(), "mmap");
+    }
+    address_ = address;
+  }
+
+  static void throwOnFailure(bool failed, const char* what) {
+    if (failed) {
+      throw std::system_error(errno, std::generic_category(), what);
+    }
+  }
+
+  std::string name_;
+  void* address_{nullptr};
+  std::size_t size_;
+  bool isOwner_;
+};
+
+}  // namespace funkypipes::details
+
+#endif  // FUNKYPIPES_DETAILS_SHARED_MEMORY_MAPPING_HPP
@@ -0,0 +1,70 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_DETAILS_STATE_UPDATE_RESULT_HPP
+#define FUNKYPIPES_DETAILS_STATE_UPDATE_RESULT_HPP
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "funkypipes/details/tuple/separate_tuple_elements.hpp"
+#include "funkypipes/details/tuple/try_flatten_tuple.hpp"
+#include "funkypipes/details/tuple/tuple_traits.hpp"
+
+namespace funkypipes::details {
+
+// Returns the new state held by the result of a state update function. The result is either the new state itself or a
+// tuple whose first element is the new state.
+template <typename TUpdateResult>
+const auto& newStateOf(const TUpdateResult& updateResult) {
+  if constexpr (IsTuple<TUpdateResult>) {
+    return std::get<0>(updateResult);
+  } else {
+    return updateResult;
+  }
+}
+
+// Moves the new state out of the result of a state update function. The remaining elements of a tuple result are left
+// untouched.
+template <typename TUpdateResult>
+auto&& takeNewStateOf(TUpdateResult& updateResult) {
+  if constexpr (IsTuple<TUpdateResult>) {
+    return std::move(std::get<0>(updateResult));
+  } else {
+    return std::move(updateResult);
+  }
+}
+
+// Invokes the state update function with the given state and arguments. The state is moved into the update function if
+// it accepts rvalues, which saves a copy for update functions taking the state by value. Use this only if the state is
+// not needed anymore in case the update function throws.
+template <typename TStateUpdateFn, typename TState, typename... TArgs>
+auto invokeConsumingState(const TStateUpdateFn& updateFn, TState& state, TArgs&&... args) {
+  if constexpr (std::is_invocable_v<const TStateUpdateFn&, TState&&, TArgs&&...>) {
+    return updateFn(std::move(state), std::forward<TArgs>(args)...);
+  } else {
+    return updateFn(state, std::forward<TArgs>(args)...);
+  }
+}
+
+// Returns the additional outputs of a state update function's result: nothing if the result is the new state only, the
+// output itself if there is a single one, or a tuple of all outputs otherwise.
+template <typename TUpdateResult>
+auto outputsOf(TUpdateResult&& updateResult) {
+  using UpdateResult = std::decay_t<TUpdateResult>;
+  if constexpr (IsTuple<UpdateResult>) {
+    auto [_, outputTuple] = separateTupleElements<0>(std::forward<TUpdateResult>(updateResult));
+
+    return tryFlattenTuple(std::move(outputTuple));
+  }
+}
+
+}  // namespace funkypipes::details
+
+#endif  // FUNKYPIPES_DETAILS_STATE_UPDATE_RESULT_HPP
@@ -0,0 +1,109 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_DETAILS_STRAND_HPP
+#define FUNKYPIPES_DETAILS_STRAND_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace funkypipes::details {
+
+// An executor running the posted tasks one after the other, in the order they were posted, on a background thread of
+// its own. Tasks may be move-only and must not throw. Pending tasks are taken from the queue in batches, so a busy
+// strand locks its queue once per batch rather than once per task.
+class Strand {
+ public:
+  Strand() : thread_{[this] { runUntilStopped(); }} {}
+
+  Strand(const Strand&) = delete;
+  Strand(Strand&&) = delete;
+  Strand& operator=(const Strand&) = delete;
+  Strand& operator=(Strand&&) = delete;
+
+  // Runs all remaining tasks before stopping the background thread.
+  ~Strand() {
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      stopRequested_ = true;
+    }
+    wakeUp_.notify_one();
+    thread_.join();
+  }
+
+  // Queues the given task for the background thread.
+  template <typename TTaskFn>
+  void post(TTaskFn&& taskFn) {
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      tasks_.emplace_back(std::forward<TTaskFn>(taskFn));
+    }
+    wakeUp_.notify_one();
+  }
+
+ private:
+  // A type erased, move-only task.
+  class Task {
+   public:
+    template <typename TTaskFn>
+    explicit Task(TTaskFn&& taskFn)
+        : callable_{std::make_unique<Callable<std::decay_t<TTaskFn>>>(std::forward<TTaskFn>(taskFn))} {}
+
+    void operator()() { callable_->call(); }
+
+   private:
+    struct CallableBase {
+      virtual ~CallableBase() = default;
+      virtual void call() = 0;
+    };
+
+    template <typename TTaskFn>
+    struct Callable final : CallableBase {
+      explicit Callable(TTaskFn taskFn) : taskFn_{std::move(taskFn)} {}
+      void call() override { taskFn_(); }
+
+      TTaskFn taskFn_;
+    };
+
+    std::unique_ptr<CallableBase> callable_;
+  };
+
+  void runUntilStopped() {
+    std::deque<Task> batch;
+    for (;;) {
+      {
+        std::unique_lock<std::mutex> lock{mutex_};
+        wakeUp_.wait(lock, [&] { return stopRequested_ || !tasks_.empty(); });
+        if (tasks_.empty()) {
+          return;
+        }
+        batch.swap(tasks_);
+      }
+      for (auto& task : batch) {
+        task();
+      }
+      batch.clear();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable wakeUp_;
+  std::deque<Task> tasks_;
+  bool stopRequested_{false};
+
+  std::thread thread_;
+};
+
+}  // namespace funkypipes::details
+
+#endif  // FUNKYPIPES_DETAILS_STRAND_HPP
@@ -0,0 +1,62 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_DETAILS_SUBSCRIPTION_HPP
+#define FUNKYPIPES_DETAILS_SUBSCRIPTION_HPP
+
+#include <type_traits>
+#include <utility>
+
+namespace funkypipes::details {
+
+// Checks whether the given subscription function is present. Subscription functions that can be tested for emptiness
+// (std::function, function pointers) are present when not empty, any other callable is always present.
+template <typename TSubscriptionFn>
+constexpr bool hasSubscription(const TSubscriptionFn& subscriptionFn) {
+  if constexpr (std::is_constructible_v<bool, const TSubscriptionFn&>) {
+    return static_cast<bool>(subscriptionFn);
+  } else {
+    return true;
+  }
+}
+
+// Whether the given subscription function filters updates that did not change the state, see OnChangeSubscription.
+template <typename TSubscriptionFn, typename TState, typename = void>
+constexpr bool IsFilteringUnchanged = false;
+
+template <typename TSubscriptionFn, typename TState>
+constexpr bool IsFilteringUnchanged<
+    TSubscriptionFn, TState,
+    std::void_t<decltype(std::declval<const TSubscriptionFn&>().isChange(std::declval<const TState&>(),
+                                                                          std::declval<const TState&>()))>> = true;
+
+// Checks whether an update from the old to the new state is to be stored, published and notified, which is the case
+// unless the subscription function filters updates that did not change the state and the states are equal.
+template <typename TSubscriptionFn, typename TState>
+bool isStoredUpdate(const TSubscriptionFn& subscriptionFn, const TState& oldState, const TState& newState) {
+  if constexpr (IsFilteringUnchanged<TSubscriptionFn, TState>) {
+    return subscriptionFn.isChange(oldState, newState);
+  } else {
+    return true;
+  }
+}
+
+// Notifies the subscription function about an update approved by isStoredUpdate, without comparing the states again.
+template <typename TSubscriptionFn, typename TUpdateName, typename TState>
+void notifyStoredUpdate(TSubscriptionFn& subscriptionFn, const TUpdateName& updateName, const TState& oldState,
+                        const TState& newState) {
+  if constexpr (IsFilteringUnchanged<TSubscriptionFn, TState>) {
+    subscriptionFn.notifyChange(updateName, oldState, newState);
+  } else {
+    subscriptionFn(updateName, oldState, newState);
+  }
+}
+
+}  // namespace funkypipes::details
+
+#endif  // FUNKYPIPES_DETAILS_SUBSCRIPTION_HPP
@@ -0,0 +1,246 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_DIFF_HPP
+#define FUNKYPIPES_DIFF_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "funkypipes/details/aggregate_fields.hpp"
+
+namespace funkypipes {
+
+// Diff is the customization point defining the difference between two values of a type, as delivered to diff
+// subscribers (see makeDiffSubscription and SubscriptionHub::subscribeDiff). Specializations are provided for
+// map-like containers (MapDiff), sequence containers (SequenceDiff), aggregates (AggregateDiff, compared field by
+// field) and any other equality comparable type (ValueDiff). Other types, or types whose difference should be
+// represented differently, need a specialization of their own:
+//
+//   template <>
+//   struct funkypipes::Diff<MyType> {
+//     using Type = MyTypeDiff;  // provides bool empty() const, which is true if nothing changed
+//     static Type compute(const MyType& oldValue, const MyType& newValue);
+//   };
+template <typename T, typename = void>
+struct Diff;
+
+// The type of the difference between two values of type T.
+template <typename T>
+using DiffOf = typename Diff<T>::Type;
+
+// Returns the difference between the given values.
+template <typename T>
+DiffOf<T> diff(const T& oldValue, const T& newValue) {
+  return Diff<T>::compute(oldValue, newValue);
+}
+
+// Difference of values compared as a whole: holds both values if they differ.
+template <typename T>
+struct ValueDiff {
+  struct Change {
+    T oldValue;
+    T newValue;
+  };
+
+  std::optional<Change> change;
+
+  [[nodiscard]] bool empty() const { return !change; }
+};
+
+// Difference of maps: the added entries, the differences of the values of the keys present in both maps, and the
+// removed keys.
+template <typename TKey, typename TValue>
+struct MapDiff {
+  std::vector<std::pair<TKey, TValue>> added;
+  std::vector<std::pair<TKey, DiffOf<TValue>>> changed;
+  std::vector<TKey> removed;
+
+  [[nodiscard]] bool empty() const { return added.empty() && changed.empty() && removed.empty(); }
+};
+
+// Difference of sequences compared index by index: the differences of the elements at the indices present in both
+// sequences, the elements appended to the end, and the number of elements removed from the end.
+template <typename TValue>
+struct SequenceDiff {
+  std::vector<std::pair<std::size_t, DiffOf<TValue>>> changed;
+  std::vector<TValue> appended;
+  std::size_t removedCount{0};
+
+  [[nodiscard]] bool empty() const { return changed.empty() && appended.empty() && removedCount == 0; }
+};
+
+// Difference of aggregates: the differences of their fields, in declaration order.
+template <typename... TFieldDiffs>
+struct AggregateDiff {
+  std::tuple<TFieldDiffs...> fields;
+
+  [[nodiscard]] bool empty() const {
+    return std::apply([](const auto&... fieldDiffs) { return (fieldDiffs.empty() && ...); }, fields);
+  }
+};
+
+namespace details {
+
+template <typename T, typename = void>
+constexpr bool IsMapLike = false;
+
+template <typename T>
+constexpr bool IsMapLike<
+    T, std::void_t<typename T::key_type, typename T::mapped_type, decltype(std::declval<const T&>().begin()),
+                   decltype(std::declval<const T&>().count(std::declval<const typename T::key_type&>())),
+                   decltype(std::declval<const T&>().at(std::declval<const typename T::key_type&>()))>> = true;
+
+template <typename T, typename = void>
+constexpr bool IsSequenceLike = false;
+
+// Note: strings are excluded, they are compared as a whole
+template <typename T>
+constexpr bool IsSequenceLike<T, std::void_t<typename T::value_type, decltype(std::declval<const T&>().size()),
+                                             decltype(std::declval<const T&>()[std::size_t{0}])>> =
+    !IsMapLike<T> && !std::is_same_v<T, std::basic_string<typename T::value_type>>;
+
+template <typename T>
+constexpr bool IsDiffedFieldwise =
+    std::is_class_v<T> && std::is_aggregate_v<T> && !IsMapLike<T> && !IsSequenceLike<T>;
+
+template <typename TFields>
+struct AggregateDiffOfFields;
+
+template <typename... TFields>
+struct AggregateDiffOfFields<std::tuple<TFields...>> {
+  using Type = AggregateDiff<DiffOf<std::decay_t<TFields>>...>;
+};
+
+}  // namespace details
+
+template <typename T>
+struct Diff<T, std::enable_if_t<details::IsMapLike<T>>> {
+  using Key = typename T::key_type;
+  using Value = typename T::mapped_type;
+  using Type = MapDiff<Key, Value>;
+
+  static Type compute(const T& oldMap, const T& newMap) {
+    Type result;
+    for (const auto& [key, oldValue] : oldMap) {
+      if (newMap.count(key) == 0) {
+        result.removed.push_back(key);
+        continue;
+      }
+      auto valueDiff = diff<Value>(oldValue, newMap.at(key));
+      if (!valueDiff.empty()) {
+        result.changed.emplace_back(key, std::move(valueDiff));
+      }
+    }
+    for (const auto& [key, newValue] : newMap) {
+      if (oldMap.count(key) == 0) {
+        result.added.emplace_back(key, newValue);
+      }
+    }
+    return result;
+  }
+};
+
+template <typename T>
+struct Diff<T, std::enable_if_t<details::IsSequenceLike<T>>> {
+  using Value = typename T::value_type;
+  using Type = SequenceDiff<Value>;
+
+  static Type compute(const T& oldSequence, const T& newSequence) {
+    Type result;
+    const std::size_t commonSize = std::min(oldSequence.size(), newSequence.size());
+    for (std::size_t index = 0; index < commonSize; ++index) {
+      auto elementDiff = diff<Value>(oldSequence[index], newSequence[index]);
+      if (!elementDiff.empty()) {
+        result.changed.emplace_back(index, std::move(elementDiff));
+      }
+    }
+    for (std::size_t index = commonSize; index < newSequence.size(); ++index) {
+      result.appended.push_back(newSequence[index]);
+    }
+    result.removedCount = oldSequence.size() - commonSize;
+    return result;
+  }
+};
+
+// Note: supports aggregates without base classes and array fields, see details::fieldsOf
+template <typename T>
+struct Diff<T, std::enable_if_t<details::IsDiffedFieldwise<T>>> {
+  using Type = typename details::AggregateDiffOfFields<decltype(details::fieldsOf(std::declval<const T&>()))>::Type;
+
+  static Type compute(const T& oldValue, const T& newValue) {
+    return computeFields(details::fieldsOf(oldValue), details::fieldsOf(newValue),
+                         std::make_index_sequence<std::tuple_size_v<decltype(details::fieldsOf(oldValue))>>{});
+  }
+
+ private:
+  template <typename TFields, std::size_t... Indices>
+  static Type computeFields(const TFields& oldFields, const TFields& newFields, std::index_sequence<Indices...>) {
+    return Type{std::make_tuple(diff(std::get<Indices>(oldFields), std::get<Indices>(newFields))...)};
+  }
+};
+
+template <typename T>
+struct Diff<T, std::enable_if_t<!details::IsMapLike<T> && !details::IsSequenceLike<T> &&
+                                !details::IsDiffedFieldwise<T>>> {
+  using Type = ValueDiff<T>;
+
+  static Type compute(const T& oldValue, const T& newValue) {
+    if (oldValue == newValue) {
+      return Type{};
+    }
+    return Type{typename Type::Change{oldValue, newValue}};
+  }
+};
+
+namespace details {
+
+// Notifies a diff subscription function, which accepts either the update name and the diff, or the update name, the
+// old state, the new state and the diff.
+template <typename TDiffSubscriptionFn, typename TUpdateName, typename TState, typename TDiff>
+void notifyDiffSubscription(const TDiffSubscriptionFn& diffSubscriptionFn, const TUpdateName& updateName,
+                            const TState& oldState, const TState& newState, const TDiff& stateDiff) {
+  if constexpr (std::is_invocable_v<const TDiffSubscriptionFn&, const TUpdateName&, const TState&, const TState&,
+                                    const TDiff&>) {
+    diffSubscriptionFn(updateName, oldState, newState, stateDiff);
+  } else {
+    diffSubscriptionFn(updateName, stateDiff);
+  }
+}
+
+}  // namespace details
+
+// Returns a subscription function for StateStore that notifies the given diff subscription function about the
+// difference between the old and the new state, and only if there is any. The diff subscription function accepts the
+// update name and the diff, or the update name, the old state, the new state and the diff. For notifying several diff
+// subscribers, computing each diff once, see SubscriptionHub::subscribeDiff.
+//
+// Example usage:
+//   StateStore<State> store{makeDiffSubscription<State>([](const std::string& updateName, const DiffOf<State>& diff) {
+//     log(updateName, diff);
+//   })};
+template <typename TState, typename TUpdateName = std::string, typename TDiffSubscriptionFn>
+auto makeDiffSubscription(TDiffSubscriptionFn diffSubscriptionFn) {
+  return [diffSubscriptionFn_ = std::move(diffSubscriptionFn)](const TUpdateName& updateName, const TState& oldState,
+                                                               const TState& newState) {
+    const auto stateDiff = diff(oldState, newState);
+    if (!stateDiff.empty()) {
+      details::notifyDiffSubscription(diffSubscriptionFn_, updateName, oldState, newState, stateDiff);
+    }
+  };
+}
+
+}  // namespace funkypipes
+
+#endif  // FUNKYPIPES_DIFF_HPP
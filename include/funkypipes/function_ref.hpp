@@ -0,0 +1,97 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_FUNCTION_REF_HPP
+#define FUNKYPIPES_FUNCTION_REF_HPP
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "funkypipes/details/invoke_packed.hpp"
+
+namespace funkypipes {
+
+// FunctionRef is a non-owning reference to a pipe, a decorated function (see at, fork and passAlong) or any other
+// callable with the given signature. It consists of two pointers, the referenced callable and a function invoking it,
+// so that constructing, copying and invoking it never allocates. It is meant for parameters of functions invoking the
+// given pipe during their call only, without turning them into templates.
+//
+// The referenced callable must outlive the FunctionRef. This holds for temporaries passed as argument to a function
+// taking a FunctionRef, but not for a FunctionRef variable initialized by a temporary.
+//
+// The callable is invoked like AnyPipe invokes its pipe, including the packing and unpacking of tuple arguments.
+// Reference results are returned as references to the very object returned by the callable.
+//
+// Example usage:
+//   int sumOfResults(FunctionRef<int(int)> pipe) { return pipe(1) + pipe(2); }
+//   sumOfResults(makePipe(incrementFn, doubleFn));
+template <typename TSignature>
+class FunctionRef;
+
+template <typename TResult, typename... TArgs>
+class FunctionRef<TResult(TArgs...)> {
+ public:
+  // Constructor: References the given callable, which is a function or an object with a call operator.
+  template <typename TFn, typename = std::enable_if_t<!std::is_same_v<std::decay_t<TFn>, FunctionRef> &&
+                                                      details::isInvocablePackedReturning<TResult, TFn&, TArgs...>()>>
+  FunctionRef(TFn&& fn) noexcept;  // NOLINT implicit by intention
+
+  // Invokes the referenced callable with the given arguments.
+  TResult operator()(TArgs... args) const { return invoke_(callable_, std::forward<TArgs>(args)...); }
+
+ private:
+  // Note: functions are referenced via function pointer, as they cannot be referenced via object pointer portably
+  union Callable {
+    void* object;
+    void (*function)();
+  };
+
+  template <typename TFn>
+  static TResult invoke(Callable callable, TArgs&&... args);
+
+  Callable callable_;
+  TResult (*invoke_)(Callable callable, TArgs&&... args);
+};
+
+template <typename TResult, typename... TArgs>
+template <typename TFn, typename>
+FunctionRef<TResult(TArgs...)>::FunctionRef(TFn&& fn) noexcept {
+  using Fn = std::remove_reference_t<TFn>;
+  if constexpr (std::is_function_v<Fn>) {
+    callable_.function = reinterpret_cast<void (*)()>(&fn);
+    invoke_ = &invoke<Fn>;
+  } else if constexpr (std::is_pointer_v<Fn> && std::is_function_v<std::remove_pointer_t<Fn>>) {
+    callable_.function = reinterpret_cast<void (*)()>(fn);
+    invoke_ = &invoke<std::remove_pointer_t<Fn>>;
+  } else {
+    callable_.object = const_cast<void*>(static_cast<const volatile void*>(std::addressof(fn)));
+    invoke_ = &invoke<Fn>;
+  }
+}
+
+template <typename TResult, typename... TArgs>
+template <typename TFn>
+TResult FunctionRef<TResult(TArgs...)>::invoke(Callable callable, TArgs&&... args) {
+  auto invokeCallable = [&](auto& fn) -> TResult {
+    if constexpr (std::is_void_v<TResult>) {
+      details::invokePacked(fn, std::forward<TArgs>(args)...);
+    } else {
+      return details::invokePacked(fn, std::forward<TArgs>(args)...);
+    }
+  };
+  if constexpr (std::is_function_v<TFn>) {
+    return invokeCallable(*reinterpret_cast<TFn*>(callable.function));
+  } else {
+    return invokeCallable(*static_cast<TFn*>(callable.object));
+  }
+}
+
+}  // namespace funkypipes
+
+#endif  // FUNKYPIPES_FUNCTION_REF_HPP
@@ -0,0 +1,227 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_HISTORY_STATE_STORE_HPP
+#define FUNKYPIPES_HISTORY_STATE_STORE_HPP
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "funkypipes/details/make_tuple_unpacking.hpp"
+#include "funkypipes/details/state_update_result.hpp"
+#include "funkypipes/details/subscription.hpp"
+
+namespace funkypipes {
+
+// HistoryStateStore is a variant of StateStore that keeps the states of the last updates, e.g. for undo or debugging.
+// It offers the same interface as StateStore (except transaction), see there for the expected signatures of update,
+// transform and subscription functions. Additionally, undo and redo step through the recorded states and stateAt gives
+// access to earlier states, all in constant time.
+//
+// Each recorded state is an immutable, reference counted object, and the store's current state is one of them, so
+// stepping through the history never copies a state. Recording a state is not free though: memory grows by whatever the
+// update function allocated for the new state. Hence the history costs memory proportional to what changed, as long as
+// copies of TState share their unchanged parts, e.g. by holding them via std::shared_ptr<const T> or by using
+// persistent containers. A state holding a large std::vector costs the full vector per history entry instead.
+//
+// Undo and redo are state transitions as well and notify the subscription with the given update name.
+template <typename TState, typename TUpdateName = std::string,
+          typename TSubscriptionFn = std::function<void(const TUpdateName&, const TState&, const TState&)>>
+class HistoryStateStore {
+ public:
+  using UpdateName = TUpdateName;
+  using SubscriptionFn = TSubscriptionFn;
+
+  // Constructor: Initializes the store keeping up to historyDepth earlier states, with an optional subscription
+  // callback and initial state.
+  explicit HistoryStateStore(std::size_t historyDepth, SubscriptionFn subscriptionFn = SubscriptionFn{},
+                             TState initialState = TState{});
+
+  // Constructor: Initializes the store keeping up to historyDepth earlier states, with an initial state.
+  HistoryStateStore(std::size_t historyDepth, TState initialState);
+
+  // Applies an update function to the state with optional arguments, and returns any additional output. States undone
+  // before are discarded, so they cannot be redone anymore.
+  template <typename TStateUpdateFn, typename... TArgs>
+  auto apply(const UpdateName& updateName, const TStateUpdateFn& updateFn, TArgs&&... args);
+
+  // Applies an update function to the state and passes its result to a transformation function, returning the
+  // transformed output.
+  template <typename TStateUpdateFn, typename TTransformFn, typename... TArgs>
+  auto applyAndTransform(const UpdateName& updateName, const TStateUpdateFn& updateFn, const TTransformFn& transformFn,
+                         TArgs&&... args);
+
+  // Returns a callable that, when invoked, applies the update function to the state using the specified update name.
+  template <typename TStateUpdateFn>
+  [[nodiscard]] auto bind(UpdateName updateName, TStateUpdateFn&& updateFn);
+
+  // Returns a callable that, when invoked, applies the update function and then the transform function to the result,
+  // using the specified update name.
+  template <typename TStateUpdateFn, typename TTransformFn>
+  [[nodiscard]] auto bind(UpdateName updateName, TStateUpdateFn&& updateFn, TTransformFn&& transformFn);
+
+  // Restores the state before the last update, notifying the subscription with the given update name. Returns false
+  // if there is no earlier state.
+  bool undo(const UpdateName& updateName);
+
+  // Restores the state the last undo stepped back from, notifying the subscription with the given update name. Returns
+  // false if there is no undone state.
+  bool redo(const UpdateName& updateName);
+
+  // Returns the number of steps undo can go back.
+  [[nodiscard]] std::size_t undoDepth() const { return currentIndex_; }
+
+  // Returns the number of steps redo can go forward.
+  [[nodiscard]] std::size_t redoDepth() const { return history_.size() - currentIndex_ - 1; }
+
+  // Returns the state the given number of steps before the current one, which must not exceed undoDepth. stateAt(0) is
+  // the current state.
+  [[nodiscard]] const TState& stateAt(std::size_t stepsBack) const { return *history_[currentIndex_ - stepsBack]; }
+
+  // Returns the current state value.
+  [[nodiscard]] TState get_state() const;
+
+ private:
+  // Applies an update function to the state, records the new state, notifies the subscription (if present), and
+  // forwards the update result.
+  template <typename TStateUpdateFn, typename... TArgs>
+  auto applyForwardingUpdateResult(const UpdateName& updateName, const TStateUpdateFn& updateFn, TArgs&&... args);
+
+  // Makes the recorded state at the given index the current one and notifies the subscription (if present).
+  void moveTo(std::size_t index, const UpdateName& updateName);
+
+  SubscriptionFn subscriptionFn_;
+  std::size_t historyDepth_;
+  std::deque<std::shared_ptr<const TState>> history_;
+  std::size_t currentIndex_{0};
+};
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+HistoryStateStore<TState, TUpdateName, TSubscriptionFn>::HistoryStateStore(std::size_t historyDepth,
+                                                                           SubscriptionFn subscriptionFn,
+                                                                           TState initialState)
+    : subscriptionFn_{std::move(subscriptionFn)},
+      historyDepth_{historyDepth},
+      history_{std::make_shared<const TState>(std::move(initialState))} {}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+HistoryStateStore<TState, TUpdateName, TSubscriptionFn>::HistoryStateStore(std::size_t historyDepth,
+                                                                           TState initialState)
+    : subscriptionFn_{},
+      historyDepth_{historyDepth},
+      history_{std::make_shared<const TState>(std::move(initialState))} {}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+template <typename TStateUpdateFn, typename... TArgs>
+auto HistoryStateStore<TState, TUpdateName, TSubscriptionFn>::apply(const UpdateName& updateName,
+                                                                    const TStateUpdateFn& updateFn, TArgs&&... args) {
+  namespace fpd = ::funkypipes::details;
+
+  auto updateResult = applyForwardingUpdateResult(updateName, updateFn, std::forward<decltype(args)>(args)...);
+
+  return fpd::outputsOf(std::move(updateResult));
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+template <typename TStateUpdateFn, typename TTransformFn, typename... TArgs>
+auto HistoryStateStore<TState, TUpdateName, TSubscriptionFn>::applyAndTransform(const UpdateName& updateName,
+                                                                                const TStateUpdateFn& updateFn,
+                                                                                const TTransformFn& transformFn,
+                                                                                TArgs&&... args) {
+  namespace fpd = ::funkypipes::details;
+
+  auto updateResult = applyForwardingUpdateResult(updateName, updateFn, std::forward<decltype(args)>(args)...);
+  auto tupleAwareTransformFn = fpd::makeTupleUnpacking(transformFn);
+  return tupleAwareTransformFn(std::move(updateResult));
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+template <typename TStateUpdateFn>
+[[nodiscard]] auto HistoryStateStore<TState, TUpdateName, TSubscriptionFn>::bind(UpdateName updateName,
+                                                                                 TStateUpdateFn&& updateFn) {
+  return [this, updateName_ = std::move(updateName), updateFn_ = std::forward<decltype(updateFn)>(updateFn)](
+             auto&&... args) { return this->apply(updateName_, updateFn_, std::forward<decltype(args)>(args)...); };
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+template <typename TStateUpdateFn, typename TTransformFn>
+[[nodiscard]] auto HistoryStateStore<TState, TUpdateName, TSubscriptionFn>::bind(UpdateName updateName,
+                                                                                 TStateUpdateFn&& updateFn,
+                                                                                 TTransformFn&& transformFn) {
+  return [this, updateName_ = std::move(updateName), updateFn_ = std::forward<decltype(updateFn)>(updateFn),
+          transformFn_ = std::forward<decltype(transformFn)>(transformFn)](auto&&... args) {
+    return this->applyAndTransform(updateName_, updateFn_, transformFn_, std::forward<decltype(args)>(args)...);
+  };
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+bool HistoryStateStore<TState, TUpdateName, TSubscriptionFn>::undo(const UpdateName& updateName) {
+  if (undoDepth() == 0) {
+    return false;
+  }
+  moveTo(currentIndex_ - 1, updateName);
+  return true;
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+bool HistoryStateStore<TState, TUpdateName, TSubscriptionFn>::redo(const UpdateName& updateName) {
+  if (redoDepth() == 0) {
+    return false;
+  }
+  moveTo(currentIndex_ + 1, updateName);
+  return true;
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+[[nodiscard]] TState HistoryStateStore<TState, TUpdateName, TSubscriptionFn>::get_state() const {
+  return *history_[currentIndex_];
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+template <typename TStateUpdateFn, typename... TArgs>
+auto HistoryStateStore<TState, TUpdateName, TSubscriptionFn>::applyForwardingUpdateResult(
+    const UpdateName& updateName, const TStateUpdateFn& updateFn, TArgs&&... args) {
+  namespace fpd = ::funkypipes::details;
+
+  // Note: the last state is kept alive by this pointer even if it gets dropped from the history below
+  const auto lastState = history_[currentIndex_];
+
+  auto updateResult = updateFn(*lastState, std::forward<TArgs>(args)...);
+
+  history_.erase(history_.begin() + static_cast<std::ptrdiff_t>(currentIndex_) + 1, history_.end());
+  history_.push_back(std::make_shared<const TState>(fpd::newStateOf(updateResult)));
+  if (history_.size() > historyDepth_ + 1) {
+    history_.pop_front();
+  }
+  currentIndex_ = history_.size() - 1;
+
+  if (fpd::hasSubscription(subscriptionFn_)) {
+    subscriptionFn_(updateName, *lastState, *history_[currentIndex_]);
+  }
+
+  return updateResult;
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+void HistoryStateStore<TState, TUpdateName, TSubscriptionFn>::moveTo(std::size_t index, const UpdateName& updateName) {
+  namespace fpd = ::funkypipes::details;
+
+  const std::size_t lastIndex = std::exchange(currentIndex_, index);
+
+  if (fpd::hasSubscription(subscriptionFn_)) {
+    subscriptionFn_(updateName, *history_[lastIndex], *history_[currentIndex_]);
+  }
+}
+
+}  // namespace funkypipes
+
+#endif  // FUNKYPIPES_HISTORY_STATE_STORE_HPP
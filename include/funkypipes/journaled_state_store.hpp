@@ -0,0 +1,515 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_JOURNALED_STATE_STORE_HPP
+#define FUNKYPIPES_JOURNALED_STATE_STORE_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "funkypipes/details/journal.hpp"
+#include "funkypipes/details/make_tuple_unpacking.hpp"
+#include "funkypipes/details/state_update_result.hpp"
+#include "funkypipes/details/subscription.hpp"
+#include "funkypipes/serialization.hpp"
+
+namespace funkypipes {
+
+// Configures how JournaledStateStore persists its updates.
+struct JournalOptions {
+  // Number of journaled updates after which they are synced to disk at the latest.
+  std::size_t syncBatchSize{256};
+
+  // Time after which journaled updates are synced to disk at the latest.
+  std::chrono::milliseconds syncInterval{10};
+
+  // Number of updates after which a snapshot of the state is written, 0 disables automatic snapshots.
+  std::uint64_t snapshotInterval{100000};
+
+  // Size of a journal file. A new journal file is started when the current one is full and with each snapshot.
+  std::size_t journalFileSize{std::size_t{64} * 1024 * 1024};
+};
+
+// JournaledStateStore is a variant of StateStore whose state survives restarts of the process. It relies on update
+// functions being pure, as StateStore encourages: instead of the state, each update is recorded in a write-ahead
+// journal by its name and arguments, and replaying the journal on startup deterministically restores the state. See
+// StateStore for the expected signatures of update, transform and subscription functions.
+//
+// Updates are applied via the callables returned by bind only, which also registers the update function for replay, so
+// each update name can be bound once. The argument types of an update need to be given explicitly, and they, the update
+// name and the state need to be serializable (see Serialization). After binding all updates, recover restores the
+// state and opens the journal for appending, applying updates before is an error.
+//
+// The journal is a sequence of memory mapped, append-only files in the given directory. Appending a record copies it
+// into the mapping, so it survives a crash of the process right away. Syncing to disk (fdatasync) happens in the
+// background for groups of records, after syncBatchSize records or syncInterval at the latest, and sync waits until all
+// updates applied so far are durable. Every snapshotInterval updates a copy of the state is serialized into a snapshot
+// file in the background, after which the older journal files and snapshots are removed, a failure is reported by
+// snapshotError. Recovery maps the latest snapshot and replays only the journal records following it, also across a
+// journal file ending in a record that was written incompletely. Replayed updates are not notified to the subscription.
+//
+// Example usage:
+//   JournaledStateStore<State> store{"/var/lib/app/state", State{}};
+//   auto addSample = store.bind<double>("addSample", addSampleFn);
+//   store.recover();
+//   addSample(21.5);
+template <typename TState, typename TUpdateName = std::string,
+          typename TSubscriptionFn = std::function<void(const TUpdateName&, const TState&, const TState&)>>
+class JournaledStateStore {
+ public:
+  using UpdateName = TUpdateName;
+  using SubscriptionFn = TSubscriptionFn;
+
+  // Constructor: Initializes the store persisting to the given directory, with a subscription callback and the state
+  // to start from if the directory holds no journal yet.
+  JournaledStateStore(std::filesystem::path directory, SubscriptionFn subscriptionFn, TState initialState,
+                      JournalOptions options = JournalOptions{});
+
+  // Constructor: Initializes the store persisting to the given directory, with the state to start from if the
+  // directory holds no journal yet.
+  JournaledStateStore(std::filesystem::path directory, TState initialState, JournalOptions options = JournalOptions{});
+
+  JournaledStateStore(const JournaledStateStore&) = delete;
+  JournaledStateStore(JournaledStateStore&&) = delete;
+  JournaledStateStore& operator=(const JournaledStateStore&) = delete;
+  JournaledStateStore& operator=(JournaledStateStore&&) = delete;
+
+  // Syncs the journal and finishes a pending snapshot.
+  ~JournaledStateStore();
+
+  // Registers the update function for replay and returns a callable taking arguments of the given types that, when
+  // invoked, journals and applies the update using the specified update name.
+  template <typename... TArgs, typename TStateUpdateFn>
+  [[nodiscard]] auto bind(UpdateName updateName, TStateUpdateFn&& updateFn);
+
+  // Registers the update function for replay and returns a callable taking arguments of the given types that, when
+  // invoked, journals and applies the update and then the transform function to the result, using the specified update
+  // name.
+  template <typename... TArgs, typename TStateUpdateFn, typename TTransformFn>
+  [[nodiscard]] auto bind(UpdateName updateName, TStateUpdateFn&& updateFn, TTransformFn&& transformFn);
+
+  // Restores the state from the directory's latest snapshot and the journal records following it, and opens a new
+  // journal file for appending. Needs to be called once, after binding all updates. Returns the number of replayed
+  // updates.
+  std::uint64_t recover();
+
+  // Waits until all updates applied so far are synced to disk.
+  void sync();
+
+  // Writes a snapshot of the current state in the background.
+  void snapshot();
+
+  // Returns the error of the latest snapshot written in the background if it failed, nullptr otherwise.
+  [[nodiscard]] std::exception_ptr snapshotError();
+
+  // Returns the current state value.
+  [[nodiscard]] TState get_state() const;
+
+  // Returns the number of updates applied since the directory was first used.
+  [[nodiscard]] std::uint64_t sequence() const { return sequence_; }
+
+ private:
+  using ReplayFn = std::function<void(std::string_view)>;
+
+  // Registers the update function for replay and returns the serialized update name.
+  template <typename... TArgs, typename TStateUpdateFn>
+  std::string registerReplay(const UpdateName& updateName, const TStateUpdateFn& updateFn);
+
+  // Applies an update function to the state, journals it, notifies the subscription (if present), and forwards the
+  // update result.
+  template <typename... TArgs, typename TStateUpdateFn>
+  auto applyForwardingUpdateResult(const UpdateName& updateName, const std::string& serializedName,
+                                   const TStateUpdateFn& updateFn, TArgs&&... args);
+
+  // Appends a record to the journal, starting a new journal file if the current one is full.
+  void append(std::string_view payload);
+
+  // Starts a new journal file for the records following the current sequence number.
+  void startJournalFile();
+
+  void syncUntilStopped();
+  void snapshotUntilStopped();
+
+  SubscriptionFn subscriptionFn_;
+  std::filesystem::path directory_;
+  JournalOptions options_;
+  TState currentState_;
+  std::uint64_t sequence_{0};
+  bool isRecovered_{false};
+  std::unordered_map<std::string, ReplayFn> replayFns_;
+  std::string recordBuffer_;
+  std::shared_ptr<details::JournalWriter> journal_;
+
+  std::mutex syncMutex_;
+  std::condition_variable syncRequested_;
+  std::condition_variable synced_;
+  std::vector<std::shared_ptr<details::JournalWriter>> retiredJournals_;
+  std::uint64_t journaledSequence_{0};
+  std::uint64_t durableSequence_{0};
+  std::size_t syncWaiterCount_{0};
+  std::exception_ptr syncError_;
+
+  std::mutex snapshotMutex_;
+  std::condition_variable snapshotRequested_;
+  std::optional<std::pair<std::uint64_t, TState>> pendingSnapshot_;
+  std::uint64_t lastSnapshotSequence_{0};
+  std::exception_ptr snapshotError_;
+
+  bool stopRequested_{false};
+  std::thread syncThread_;
+  std::thread snapshotThread_;
+};
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+JournaledStateStore<TState, TUpdateName, TSubscriptionFn>::JournaledStateStore(std::filesystem::path directory,
+                                                                               SubscriptionFn subscriptionFn,
+                                                                               TState initialState,
+                                                                               JournalOptions options)
+    : subscriptionFn_{std::move(subscriptionFn)},
+      directory_{std::move(directory)},
+      options_{options},
+      currentState_{std::move(initialState)} {}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+JournaledStateStore<TState, TUpdateName, TSubscriptionFn>::JournaledStateStore(std::filesystem::path directory,
+                                                                               TState initialState,
+                                                                               JournalOptions options)
+    : subscriptionFn_{}, directory_{std::move(directory)}, options_{options}, currentState_{std::move(initialState)} {}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+JournaledStateStore<TState, TUpdateName, TSubscriptionFn>::~JournaledStateStore() {
+  {
+    std::scoped_lock lock{syncMutex_, snapshotMutex_};
+    stopRequested_ = true;
+  }
+  syncRequested_.notify_one();
+  snapshotRequested_.notify_one();
+  if (syncThread_.joinable()) {
+    syncThread_.join();
+  }
+  if (snapshotThread_.joinable()) {
+    snapshotThread_.join();
+  }
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+template <typename... TArgs, typename TStateUpdateFn>
+[[nodiscard]] auto JournaledStateStore<TState, TUpdateName, TSubscriptionFn>::bind(UpdateName updateName,
+                                                                                   TStateUpdateFn&& updateFn) {
+  auto serializedName = registerReplay<TArgs...>(updateName, updateFn);
+  return [this, updateName_ = std::move(updateName), serializedName_ = std::move(serializedName),
+          updateFn_ = std::forward<decltype(updateFn)>(updateFn)](TArgs... args) {
+    namespace fpd = ::funkypipes::details;
+
+    auto updateResult =
+        this->applyForwardingUpdateResult(updateName_, serializedName_, updateFn_, std::forward<TArgs>(args)...);
+    return fpd::outputsOf(std::move(updateResult));
+  };
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+template <typename... TArgs, typename TStateUpdateFn, typename TTransformFn>
+[[nodiscard]] auto JournaledStateStore<TState, TUpdateName, TSubscriptionFn>::bind(UpdateName updateName,
+                                                                                   TStateUpdateFn&& updateFn,
+                                                                                   TTransformFn&& transformFn) {
+  auto serializedName = registerReplay<TArgs...>(updateName, updateFn);
+  return [this, updateName_ = std::move(updateName), serializedName_ = std::move(serializedName),
+          updateFn_ = std::forward<decltype(updateFn)>(updateFn),
+          transformFn_ = std::forward<decltype(transformFn)>(transformFn)](TArgs... args) {
+    namespace fpd = ::funkypipes::details;
+
+    auto updateResult =
+        this->applyForwardingUpdateResult(updateName_, serializedName_, updateFn_, std::forward<TArgs>(args)...);
+    auto tupleAwareTransformFn = fpd::makeTupleUnpacking(transformFn_);
+    return tupleAwareTransformFn(std::move(updateResult));
+  };
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+std::uint64_t JournaledStateStore<TState, TUpdateName, TSubscriptionFn>::recover() {
+  namespace fpd = ::funkypipes::details;
+
+  if (isRecovered_) {
+    throw std::logic_error("JournaledStateStore: recover called twice");
+  }
+  std::filesystem::create_directories(directory_);
+
+  const auto snapshotSequences = fpd::journalFileSequencesOf(directory_, fpd::kSnapshotFilePrefix);
+  for (auto it = snapshotSequences.rbegin(); it != snapshotSequences.rend(); ++it) {
+    const auto path = fpd::journalFilePathOf(directory_, fpd::kSnapshotFilePrefix, *it);
+    if (fpd::readSnapshotFile(path, [this](std::uint64_t sequence, std::string_view payload) {
+          currentState_ = Serialization<TState>::read(payload);
+          sequence_ = sequence;
+        })) {
+      break;
+    }
+  }
+  lastSnapshotSequence_ = sequence_;
+
+  // Note: a journal file may end with an incomplete record after a crash, so replay continues with the next file if it
+  // follows on seamlessly. Records behind a gap cannot be replayed, so they are removed to not be replayed later.
+  std::uint64_t replayCount = 0;
+  bool isGap = false;
+  for (const auto firstSequence : fpd::journalFileSequencesOf(directory_, fpd::kJournalFilePrefix)) {
+    const auto path = fpd::journalFilePathOf(directory_, fpd::kJournalFilePrefix, firstSequence);
+    isGap = isGap || firstSequence > sequence_ + 1;
+    if (isGap) {
+      std::filesystem::remove(path);
+      continue;
+    }
+    fpd::forEachJournalRecord(path, [&](std::uint64_t sequence, std::string_view payload) {
+      if (sequence <= sequence_) {
+        return true;
+      }
+      if (sequence != sequence_ + 1) {
+        isGap = true;
+        return false;
+      }
+      const auto nameSize = static_cast<std::size_t>(Serialization<std::uint32_t>::read(payload));
+      const auto replayFn = replayFns_.find(std::string{payload.substr(0, nameSize)});
+      if (replayFn == replayFns_.end()) {
+        throw std::runtime_error("JournaledStateStore: journal contains an update that is not bound");
+      }
+      replayFn->second(payload.substr(nameSize));
+      ++sequence_;
+      ++replayCount;
+      return true;
+    });
+  }
+
+  journaledSequence_ = sequence_;
+  durableSequence_ = sequence_;
+  startJournalFile();
+  isRecovered_ = true;
+  syncThread_ = std::thread{[this] { syncUntilStopped(); }};
+  snapshotThread_ = std::thread{[this] { snapshotUntilStopped(); }};
+  if (replayCount > 0) {
+    snapshot();
+  }
+  return replayCount;
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+void JournaledStateStore<TState, TUpdateName, TSubscriptionFn>::sync() {
+  std::unique_lock<std::mutex> lock{syncMutex_};
+  const auto targetSequence = journaledSequence_;
+  ++syncWaiterCount_;
+  syncRequested_.notify_one();
+  synced_.wait(lock, [&] { return durableSequence_ >= targetSequence || syncError_; });
+  --syncWaiterCount_;
+  if (syncError_) {
+    std::rethrow_exception(syncError_);
+  }
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+void JournaledStateStore<TState, TUpdateName, TSubscriptionFn>::snapshot() {
+  if (!isRecovered_ || lastSnapshotSequence_ == sequence_) {
+    return;
+  }
+  if (journal_->firstSequence() != sequence_ + 1) {
+    startJournalFile();  // Note: journal files preceding the snapshot become obsolete once it is written
+  }
+  {
+    std::lock_guard<std::mutex> lock{snapshotMutex_};
+    pendingSnapshot_.emplace(sequence_, currentState_);
+  }
+  lastSnapshotSequence_ = sequence_;
+  snapshotRequested_.notify_one();
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+[[nodiscard]] std::exception_ptr JournaledStateStore<TState, TUpdateName, TSubscriptionFn>::snapshotError() {
+  std::lock_guard<std::mutex> lock{snapshotMutex_};
+  return snapshotError_;
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+[[nodiscard]] TState JournaledStateStore<TState, TUpdateName, TSubscriptionFn>::get_state() const {
+  return currentState_;
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+template <typename... TArgs, typename TStateUpdateFn>
+std::string JournaledStateStore<TState, TUpdateName, TSubscriptionFn>::registerReplay(const UpdateName& updateName,
+                                                                                      const TStateUpdateFn& updateFn) {
+  namespace fpd = ::funkypipes::details;
+
+  std::string serializedName;
+  Serialization<UpdateName>::write(serializedName, updateName);
+
+  ReplayFn replayFn = [this, updateFn]([[maybe_unused]] std::string_view argBytes) {
+    // Note: braced initialization reads the arguments in order
+    std::tuple<std::decay_t<TArgs>...> args{Serialization<std::decay_t<TArgs>>::read(argBytes)...};
+    auto updateResult = std::apply([&](auto&... arg) { return updateFn(currentState_, std::move(arg)...); }, args);
+    currentState_ = fpd::takeNewStateOf(updateResult);
+  };
+  if (!replayFns_.emplace(serializedName, std::move(replayFn)).second) {
+    throw std::invalid_argument("JournaledStateStore: update name bound twice");
+  }
+  return serializedName;
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+template <typename... TArgs, typename TStateUpdateFn>
+auto JournaledStateStore<TState, TUpdateName, TSubscriptionFn>::applyForwardingUpdateResult(
+    const UpdateName& updateName, const std::string& serializedName, const TStateUpdateFn& updateFn, TArgs&&... args) {
+  namespace fpd = ::funkypipes::details;
+
+  if (!isRecovered_) {
+    throw std::logic_error("JournaledStateStore: update applied before recover");
+  }
+
+  recordBuffer_.clear();
+  Serialization<std::uint32_t>::write(recordBuffer_, static_cast<std::uint32_t>(serializedName.size()));
+  recordBuffer_.append(serializedName);
+  (Serialization<std::decay_t<TArgs>>::write(recordBuffer_, args), ...);
+
+  auto updateResult = updateFn(currentState_, std::forward<TArgs>(args)...);
+
+  // Note: the update is journaled before it takes effect, so a failing append leaves the store unchanged
+  append(recordBuffer_);
+  auto lastState = std::exchange(currentState_, fpd::newStateOf(updateResult));
+
+  if (options_.snapshotInterval != 0 && sequence_ % options_.snapshotInterval == 0) {
+    snapshot();
+  }
+
+  if (fpd::hasSubscription(subscriptionFn_)) {
+    subscriptionFn_(updateName, std::as_const(lastState), std::as_const(currentState_));
+  }
+
+  return updateResult;
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+void JournaledStateStore<TState, TUpdateName, TSubscriptionFn>::append(std::string_view payload) {
+  if (!journal_->tryAppend(sequence_ + 1, payload)) {
+    startJournalFile();
+    journal_->tryAppend(sequence_ + 1, payload);
+  }
+  ++sequence_;
+
+  std::lock_guard<std::mutex> lock{syncMutex_};
+  journaledSequence_ = sequence_;
+  if (journaledSequence_ - durableSequence_ == options_.syncBatchSize) {
+    syncRequested_.notify_one();
+  }
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+void JournaledStateStore<TState, TUpdateName, TSubscriptionFn>::startJournalFile() {
+  auto journal = std::make_shared<details::JournalWriter>(directory_, sequence_ + 1, options_.journalFileSize,
+                                                          recordBuffer_.size());
+
+  std::lock_guard<std::mutex> lock{syncMutex_};
+  if (journal_) {
+    retiredJournals_.push_back(std::move(journal_));
+  }
+  journal_ = std::move(journal);
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+void JournaledStateStore<TState, TUpdateName, TSubscriptionFn>::syncUntilStopped() {
+  const auto hasUnsyncedRecords = [&] { return journaledSequence_ != durableSequence_ || !retiredJournals_.empty(); };
+  const auto isSyncDue = [&] {
+    return syncWaiterCount_ > 0 || journaledSequence_ - durableSequence_ >= options_.syncBatchSize;
+  };
+
+  std::unique_lock<std::mutex> lock{syncMutex_};
+  for (;;) {
+    syncRequested_.wait_for(lock, options_.syncInterval,
+                            [&] { return stopRequested_ || (hasUnsyncedRecords() && isSyncDue()); });
+    if (!hasUnsyncedRecords()) {
+      if (stopRequested_) {
+        return;
+      }
+      continue;
+    }
+
+    // Note: a single sync covers all records journaled so far, while the writer continues appending
+    const auto targetSequence = journaledSequence_;
+    auto journals = std::exchange(retiredJournals_, {});
+    journals.push_back(journal_);
+    lock.unlock();
+    try {
+      for (const auto& journal : journals) {
+        journal->sync();
+      }
+    } catch (...) {
+      lock.lock();
+      syncError_ = std::current_exception();
+      synced_.notify_all();
+      return;
+    }
+    journals.clear();
+    lock.lock();
+    durableSequence_ = targetSequence;
+    synced_.notify_all();
+  }
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+void JournaledStateStore<TState, TUpdateName, TSubscriptionFn>::snapshotUntilStopped() {
+  namespace fpd = ::funkypipes::details;
+
+  for (;;) {
+    std::unique_lock<std::mutex> lock{snapshotMutex_};
+    snapshotRequested_.wait(lock, [&] { return stopRequested_ || pendingSnapshot_; });
+    if (!pendingSnapshot_) {
+      return;
+    }
+    auto [sequence, state] = std::move(*pendingSnapshot_);
+    pendingSnapshot_.reset();
+    lock.unlock();
+
+    // Note: a failed snapshot only costs recovery time, as the journal files are removed after a successful one only
+    std::exception_ptr error;
+    try {
+      std::string payload;
+      Serialization<TState>::write(payload, state);
+      fpd::writeSnapshotFile(directory_, sequence, payload);
+
+      for (const auto snapshotSequence : fpd::journalFileSequencesOf(directory_, fpd::kSnapshotFilePrefix)) {
+        if (snapshotSequence < sequence) {
+          std::filesystem::remove(fpd::journalFilePathOf(directory_, fpd::kSnapshotFilePrefix, snapshotSequence));
+        }
+      }
+      for (const auto firstSequence : fpd::journalFileSequencesOf(directory_, fpd::kJournalFilePrefix)) {
+        if (firstSequence <= sequence) {
+          std::filesystem::remove(fpd::journalFilePathOf(directory_, fpd::kJournalFilePrefix, firstSequence));
+        }
+      }
+    } catch (...) {
+      error = std::current_exception();
+    }
+    lock.lock();
+    snapshotError_ = error;
+  }
+}
+
+}  // namespace funkypipes
+
+#endif  // FUNKYPIPES_JOURNALED_STATE_STORE_HPP
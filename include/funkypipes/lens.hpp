@@ -0,0 +1,80 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_LENS_HPP
+#define FUNKYPIPES_LENS_HPP
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+#include "funkypipes/details/lens_step.hpp"
+
+namespace funkypipes {
+
+// Lens focuses on a part of a nested state, reached by a path of steps starting at the state. Each step is either a
+// pointer to a data member or a key of a container, which is looked up via the container's at (std::out_of_range is
+// thrown for missing keys, so keys are never added).
+//
+// Modifying the focused part via a lens rebuilds nothing but the path to it: parts within std containers and structs
+// are modified in place, parts within immutable containers (see persistent_vector.hpp) are replaced via their set,
+// which copies the container's path to the part only. See StateStore::applyAt for applying update functions to the
+// focused part of a store's state.
+//
+// Example usage:
+//   auto thresholdLens = lens(&State::sensors, sensorId, &Sensor::threshold);
+//   double threshold = thresholdLens.get(state);
+//   thresholdLens.modify(state, [](double& threshold) { threshold *= 2; });
+template <typename... TSteps>
+class Lens {
+ public:
+  explicit Lens(TSteps... steps) : steps_{std::move(steps)...} {}
+
+  // Returns the focused part of the given whole.
+  template <typename TWhole>
+  [[nodiscard]] const auto& get(const TWhole& whole) const {
+    return getFrom<0>(whole);
+  }
+
+  // Calls the given function with a modifiable reference to the focused part of the given whole.
+  template <typename TWhole, typename TFn>
+  void modify(TWhole& whole, TFn&& fn) const {
+    modifyIn<0>(whole, fn);
+  }
+
+ private:
+  template <std::size_t Index, typename TPart>
+  const auto& getFrom(const TPart& part) const {
+    if constexpr (Index == sizeof...(TSteps)) {
+      return part;
+    } else {
+      return getFrom<Index + 1>(details::partOf(part, std::get<Index>(steps_)));
+    }
+  }
+
+  template <std::size_t Index, typename TPart, typename TFn>
+  void modifyIn(TPart& part, TFn& fn) const {
+    if constexpr (Index == sizeof...(TSteps)) {
+      fn(part);
+    } else {
+      details::modifyPartOf(part, std::get<Index>(steps_), [&](auto& subpart) { modifyIn<Index + 1>(subpart, fn); });
+    }
+  }
+
+  std::tuple<TSteps...> steps_;
+};
+
+// Returns a lens focusing on the part reached by the given steps, see Lens.
+template <typename... TSteps>
+auto lens(TSteps... steps) {
+  return Lens<TSteps...>{std::move(steps)...};
+}
+
+}  // namespace funkypipes
+
+#endif  // FUNKYPIPES_LENS_HPP
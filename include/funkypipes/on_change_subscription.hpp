@@ -0,0 +1,85 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_ON_CHANGE_SUBSCRIPTION_HPP
+#define FUNKYPIPES_ON_CHANGE_SUBSCRIPTION_HPP
+
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "funkypipes/details/subscription.hpp"
+
+namespace funkypipes {
+
+// OnChangeSubscription is a subscription function for StateStore (as well as SeqlockStateStore and
+// SharedMemoryStateStore) that is notified only if an update changed the state, i.e. if the old and the new state are
+// not equal according to the given comparator (operator== by default). Stores recognize it and compare the states
+// before storing the new one, so updates that change nothing (e.g. setting a flag that is already set) are neither
+// stored nor published, do not change the store's version and are not notified.
+//
+// Example usage:
+//   StateStore<State, std::string, OnChangeSubscription<SubscriptionFn>> store{OnChangeSubscription{subscriptionFn}};
+//   auto store = makeStateStore(State{}, makeOnChangeSubscription(subscriptionFn));
+template <typename TSubscriptionFn, typename TIsEqualFn = std::equal_to<>>
+class OnChangeSubscription {
+  template <typename TUpdateName, typename TState>
+  static constexpr bool IsNotifiable =
+      std::is_invocable_v<const TSubscriptionFn&, const TUpdateName&, const TState&, const TState&>;
+
+ public:
+  explicit OnChangeSubscription(TSubscriptionFn subscriptionFn, TIsEqualFn isEqualFn = TIsEqualFn{})
+      : subscriptionFn_{std::move(subscriptionFn)}, isEqualFn_{std::move(isEqualFn)} {}
+
+  // Returns whether the new state differs from the old one.
+  template <typename TState>
+  [[nodiscard]] bool isChange(const TState& oldState, const TState& newState) const {
+    return !isEqualFn_(oldState, newState);
+  }
+
+  // Notifies the wrapped subscription function if the new state differs from the old one.
+  // Note: only invocable with the arguments the wrapped subscription function accepts, see StateStore::transaction
+  template <typename TUpdateName, typename TState, typename = std::enable_if_t<IsNotifiable<TUpdateName, TState>>>
+  void operator()(const TUpdateName& updateName, const TState& oldState, const TState& newState) const {
+    if (isChange(oldState, newState)) {
+      subscriptionFn_(updateName, oldState, newState);
+    }
+  }
+
+  // Notifies the wrapped subscription function about a change already checked by isChange.
+  template <typename TUpdateName, typename TState, typename = std::enable_if_t<IsNotifiable<TUpdateName, TState>>>
+  void notifyChange(const TUpdateName& updateName, const TState& oldState, const TState& newState) const {
+    subscriptionFn_(updateName, oldState, newState);
+  }
+
+  // Returns whether the wrapped subscription function is present, see details::hasSubscription.
+  explicit operator bool() const { return details::hasSubscription(subscriptionFn_); }
+
+ private:
+  TSubscriptionFn subscriptionFn_;
+  TIsEqualFn isEqualFn_;
+};
+
+// Returns an OnChangeSubscription notifying the given subscription function about states that differ according to
+// the given comparator, operator== by default.
+template <typename TSubscriptionFn, typename TIsEqualFn = std::equal_to<>>
+auto makeOnChangeSubscription(TSubscriptionFn subscriptionFn, TIsEqualFn isEqualFn = TIsEqualFn{}) {
+  return OnChangeSubscription<TSubscriptionFn, TIsEqualFn>{std::move(subscriptionFn), std::move(isEqualFn)};
+}
+
+// Returns a comparator considering states equal if the given hash function yields the same value for both, for states
+// that keep a cheap hash (e.g. a version or checksum field) but are expensive to compare. Different states with the
+// same hash are considered equal, so their changes are not notified.
+template <typename THashFn>
+auto equalByHash(THashFn hashFn) {
+  return [hashFn_ = std::move(hashFn)](const auto& lhs, const auto& rhs) { return hashFn_(lhs) == hashFn_(rhs); };
+}
+
+}  // namespace funkypipes
+
+#endif  // FUNKYPIPES_ON_CHANGE_SUBSCRIPTION_HPP
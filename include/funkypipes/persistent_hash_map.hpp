@@ -0,0 +1,427 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_PERSISTENT_HASH_MAP_HPP
+#define FUNKYPIPES_PERSISTENT_HASH_MAP_HPP
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "funkypipes/details/edit_token.hpp"
+
+namespace funkypipes {
+
+// PersistentHashMap is an immutable unordered map meant for states updated by pure functions. Copying it is O(1), and
+// modifications return a new map in O(log n) that shares all unchanged parts with the original one.
+//
+// The entries are stored in a hash array mapped trie (HAMT) that consumes 5 bits of a key's hash per level. Each node
+// holds the entries whose hash fragment is unique within the node inline and refers to subnodes for the others, both
+// compactly indexed by bitmaps. Keys whose full hashes are equal end up in collision nodes.
+//
+// Several modifications in a row can be done on a Transient, which modifies the nodes it created in place instead of
+// copying them again.
+//
+// Example usage:
+//   PersistentHashMap<DeviceId, Reading> readings;
+//   readings = readings.set(deviceId, reading);
+//   if (const Reading* reading = readings.find(deviceId)) {...}
+template <typename TKey, typename TValue, typename THash = std::hash<TKey>, typename TKeyEqual = std::equal_to<TKey>>
+class PersistentHashMap {
+  static constexpr unsigned kBits = 5;
+  static constexpr std::size_t kHashBits = sizeof(std::size_t) * 8;
+
+  using Entry = std::pair<TKey, TValue>;
+
+  struct Node {
+    details::EditToken owner{details::kPersistentEditToken};
+    std::uint32_t entryMap{0};  // Hash fragments of the inline entries
+    std::uint32_t childMap{0};  // Hash fragments of the subnodes
+    std::vector<Entry> entries;
+    std::vector<std::shared_ptr<Node>> children;
+  };
+
+ public:
+  using key_type = TKey;
+  using mapped_type = TValue;
+  using value_type = Entry;
+  using size_type = std::size_t;
+
+  class const_iterator;
+  class Transient;
+
+  PersistentHashMap() = default;
+
+  PersistentHashMap(std::initializer_list<Entry> entries) {
+    const auto token = details::makeEditToken();
+    for (const auto& entry : entries) {
+      setEntry(entry.first, entry.second, token);
+    }
+  }
+
+  [[nodiscard]] std::size_t size() const { return size_; }
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+
+  // Returns a pointer to the value of the given key, or nullptr if there is none.
+  [[nodiscard]] const TValue* find(const TKey& key) const {
+    const std::size_t hash = THash{}(key);
+    const Node* node = root_.get();
+    for (unsigned shift = 0; node != nullptr; shift += kBits) {
+      if (shift >= kHashBits) {
+        for (const auto& entry : node->entries) {
+          if (TKeyEqual{}(entry.first, key)) {
+            return &entry.second;
+          }
+        }
+        return nullptr;
+      }
+      const std::uint32_t bit = bitOf(hash, shift);
+      if ((node->entryMap & bit) != 0) {
+        const auto& entry = node->entries[indexOf(node->entryMap, bit)];
+        return TKeyEqual{}(entry.first, key) ? &entry.second : nullptr;
+      }
+      if ((node->childMap & bit) == 0) {
+        return nullptr;
+      }
+      node = node->children[indexOf(node->childMap, bit)].get();
+    }
+    return nullptr;
+  }
+
+  // Returns the value of the given key, throws std::out_of_range if there is none.
+  [[nodiscard]] const TValue& at(const TKey& key) const {
+    const TValue* value = find(key);
+    if (value == nullptr) {
+      throw std::out_of_range("PersistentHashMap::at");
+    }
+    return *value;
+  }
+
+  [[nodiscard]] bool contains(const TKey& key) const { return find(key) != nullptr; }
+  [[nodiscard]] std::size_t count(const TKey& key) const { return contains(key) ? 1 : 0; }
+
+  [[nodiscard]] const_iterator begin() const { return const_iterator{root_.get()}; }
+  [[nodiscard]] const_iterator end() const { return const_iterator{}; }
+
+  // Returns a map in which the given key maps to the given value.
+  [[nodiscard]] PersistentHashMap set(TKey key, TValue value) const {
+    PersistentHashMap result{*this};
+    result.setEntry(std::move(key), std::move(value), details::makeEditToken());
+    return result;
+  }
+
+  // Returns a map without the given key.
+  [[nodiscard]] PersistentHashMap erase(const TKey& key) const {
+    PersistentHashMap result{*this};
+    result.eraseEntry(key, details::makeEditToken());
+    return result;
+  }
+
+  // Returns a transient for modifying a copy of this map in place.
+  [[nodiscard]] Transient transient() const { return Transient{*this}; }
+
+  friend bool operator==(const PersistentHashMap& lhs, const PersistentHashMap& rhs) {
+    if (lhs.size() != rhs.size()) {
+      return false;
+    }
+    for (const auto& [key, value] : lhs) {
+      const TValue* rhsValue = rhs.find(key);
+      if (rhsValue == nullptr || !(*rhsValue == value)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  friend bool operator!=(const PersistentHashMap& lhs, const PersistentHashMap& rhs) { return !(lhs == rhs); }
+
+ private:
+  static std::uint32_t bitOf(std::size_t hash, unsigned shift) {
+    return std::uint32_t{1} << ((hash >> shift) & ((std::size_t{1} << kBits) - 1));
+  }
+
+  static std::size_t indexOf(std::uint32_t map, std::uint32_t bit) {
+    return std::bitset<32>(map & (bit - 1)).count();
+  }
+
+  static std::shared_ptr<Node> makeNode(details::EditToken token) {
+    auto node = std::make_shared<Node>();
+    node->owner = token;
+    return node;
+  }
+
+  // Returns a node holding both entries, whose hash fragments are equal up to the given shift.
+  static std::shared_ptr<Node> mergeEntries(unsigned shift, Entry entry1, std::size_t hash1, Entry entry2,
+                                            std::size_t hash2, details::EditToken token) {
+    auto node = makeNode(token);
+    if (shift >= kHashBits) {
+      node->entries.push_back(std::move(entry1));
+      node->entries.push_back(std::move(entry2));
+      return node;
+    }
+    const std::uint32_t bit1 = bitOf(hash1, shift);
+    const std::uint32_t bit2 = bitOf(hash2, shift);
+    if (bit1 == bit2) {
+      node->childMap = bit1;
+      node->children.push_back(
+          mergeEntries(shift + kBits, std::move(entry1), hash1, std::move(entry2), hash2, token));
+    } else {
+      node->entryMap = bit1 | bit2;
+      if (bit1 < bit2) {
+        node->entries.push_back(std::move(entry1));
+        node->entries.push_back(std::move(entry2));
+      } else {
+        node->entries.push_back(std::move(entry2));
+        node->entries.push_back(std::move(entry1));
+      }
+    }
+    return node;
+  }
+
+  void setEntry(TKey key, TValue value, details::EditToken token) {
+    const std::size_t hash = THash{}(key);
+    if (!root_) {
+      root_ = makeNode(token);
+    }
+    if (setIn(root_, 0, hash, key, value, token)) {
+      ++size_;
+    }
+  }
+
+  // Sets the entry within the given subtree and returns whether it was added.
+  static bool setIn(std::shared_ptr<Node>& nodePtr, unsigned shift, std::size_t hash, TKey& key, TValue& value,
+                    details::EditToken token) {
+    if (shift >= kHashBits) {
+      for (auto& entry : nodePtr->entries) {
+        if (TKeyEqual{}(entry.first, key)) {
+          details::makeEditable(nodePtr, token);
+          setCollidingValue(*nodePtr, key, value);
+          return false;
+        }
+      }
+      details::makeEditable(nodePtr, token).entries.emplace_back(std::move(key), std::move(value));
+      return true;
+    }
+
+    const std::uint32_t bit = bitOf(hash, shift);
+    if ((nodePtr->entryMap & bit) != 0) {
+      const std::size_t index = indexOf(nodePtr->entryMap, bit);
+      auto& node = details::makeEditable(nodePtr, token);
+      if (TKeyEqual{}(node.entries[index].first, key)) {
+        node.entries[index].second = std::move(value);
+        return false;
+      }
+      // Note: the inline entry moves into a new subnode together with the added one
+      const std::size_t existingHash = THash{}(node.entries[index].first);
+      auto child = mergeEntries(shift + kBits, std::move(node.entries[index]), existingHash,
+                                Entry{std::move(key), std::move(value)}, hash, token);
+      node.entries.erase(node.entries.begin() + static_cast<std::ptrdiff_t>(index));
+      node.entryMap &= ~bit;
+      node.children.insert(node.children.begin() + static_cast<std::ptrdiff_t>(indexOf(node.childMap, bit)),
+                           std::move(child));
+      node.childMap |= bit;
+      return true;
+    }
+    if ((nodePtr->childMap & bit) != 0) {
+      auto& node = details::makeEditable(nodePtr, token);
+      return setIn(node.children[indexOf(node.childMap, bit)], shift + kBits, hash, key, value, token);
+    }
+    auto& node = details::makeEditable(nodePtr, token);
+    node.entries.emplace(node.entries.begin() + static_cast<std::ptrdiff_t>(indexOf(node.entryMap, bit)),
+                         std::move(key), std::move(value));
+    node.entryMap |= bit;
+    return true;
+  }
+
+  static void setCollidingValue(Node& node, const TKey& key, TValue& value) {
+    for (auto& entry : node.entries) {
+      if (TKeyEqual{}(entry.first, key)) {
+        entry.second = std::move(value);
+      }
+    }
+  }
+
+  void eraseEntry(const TKey& key, details::EditToken token) {
+    if (root_ && eraseIn(root_, 0, THash{}(key), key, token)) {
+      --size_;
+      if (root_->entries.empty() && root_->children.empty()) {
+        root_.reset();
+      }
+    }
+  }
+
+  // Erases the entry from the given subtree and returns whether it was present. A subnode left with a single entry is
+  // replaced by that entry, so equal maps have equal trees.
+  static bool eraseIn(std::shared_ptr<Node>& nodePtr, unsigned shift, std::size_t hash, const TKey& key,
+                      details::EditToken token) {
+    if (shift >= kHashBits) {
+      for (std::size_t index = 0; index < nodePtr->entries.size(); ++index) {
+        if (TKeyEqual{}(nodePtr->entries[index].first, key)) {
+          auto& node = details::makeEditable(nodePtr, token);
+          node.entries.erase(node.entries.begin() + static_cast<std::ptrdiff_t>(index));
+          return true;
+        }
+      }
+      return false;
+    }
+
+    const std::uint32_t bit = bitOf(hash, shift);
+    if ((nodePtr->entryMap & bit) != 0) {
+      const std::size_t index = indexOf(nodePtr->entryMap, bit);
+      if (!TKeyEqual{}(nodePtr->entries[index].first, key)) {
+        return false;
+      }
+      auto& node = details::makeEditable(nodePtr, token);
+      node.entries.erase(node.entries.begin() + static_cast<std::ptrdiff_t>(index));
+      node.entryMap &= ~bit;
+      return true;
+    }
+    if ((nodePtr->childMap & bit) == 0) {
+      return false;
+    }
+
+    const std::size_t childIndex = indexOf(nodePtr->childMap, bit);
+    std::shared_ptr<Node> child = nodePtr->children[childIndex];
+    if (!eraseIn(child, shift + kBits, hash, key, token)) {
+      return false;
+    }
+    auto& node = details::makeEditable(nodePtr, token);
+    if (child->children.empty() && child->entries.size() <= 1) {
+      node.children.erase(node.children.begin() + static_cast<std::ptrdiff_t>(childIndex));
+      node.childMap &= ~bit;
+      if (!child->entries.empty()) {
+        node.entries.insert(node.entries.begin() + static_cast<std::ptrdiff_t>(indexOf(node.entryMap, bit)),
+                            child->entries.front());
+        node.entryMap |= bit;
+      }
+    } else {
+      node.children[childIndex] = std::move(child);
+    }
+    return true;
+  }
+
+  std::shared_ptr<Node> root_;
+  std::size_t size_{0};
+};
+
+// Iterates the entries of a PersistentHashMap in an unspecified order, walking its trie depth first.
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+class PersistentHashMap<TKey, TValue, THash, TKeyEqual>::const_iterator {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = Entry;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const Entry*;
+  using reference = const Entry&;
+
+  const_iterator() = default;
+
+  reference operator*() const { return current().node->entries[current().entryIndex]; }
+  pointer operator->() const { return &**this; }
+
+  const_iterator& operator++() {
+    ++current().entryIndex;
+    settle();
+    return *this;
+  }
+
+  const_iterator operator++(int) {
+    const_iterator previous{*this};
+    ++*this;
+    return previous;
+  }
+
+  friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) {
+    if (lhs.path_.empty() || rhs.path_.empty()) {
+      return lhs.path_.empty() && rhs.path_.empty();
+    }
+    return &*lhs == &*rhs;
+  }
+  friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs) { return !(lhs == rhs); }
+
+ private:
+  friend class PersistentHashMap;
+
+  struct Position {
+    const Node* node;
+    std::size_t entryIndex;
+    std::size_t childIndex;
+  };
+
+  explicit const_iterator(const Node* root) {
+    if (root != nullptr) {
+      path_.push_back({root, 0, 0});
+      settle();
+    }
+  }
+
+  Position& current() { return path_.back(); }
+  const Position& current() const { return path_.back(); }
+
+  // Moves on to the next entry unless the current position refers to one already, the entries of a node are visited
+  // before its subnodes.
+  void settle() {
+    while (!path_.empty()) {
+      auto& position = current();
+      if (position.entryIndex < position.node->entries.size()) {
+        return;
+      }
+      if (position.childIndex < position.node->children.size()) {
+        const Node* child = position.node->children[position.childIndex++].get();
+        path_.push_back({child, 0, 0});
+      } else {
+        path_.pop_back();
+      }
+    }
+  }
+
+  std::vector<Position> path_;
+};
+
+// Modifies a copy of a PersistentHashMap in place, for applying many modifications at the cost of a single copy of
+// each touched node. A transient must not be shared between threads.
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+class PersistentHashMap<TKey, TValue, THash, TKeyEqual>::Transient {
+ public:
+  // Note: copies would share the edit token and thus modify each other's nodes in place
+  Transient(const Transient&) = delete;
+  Transient& operator=(const Transient&) = delete;
+  Transient(Transient&&) noexcept = default;
+  Transient& operator=(Transient&&) noexcept = default;
+  ~Transient() = default;
+
+  [[nodiscard]] std::size_t size() const { return map_.size(); }
+  [[nodiscard]] const TValue* find(const TKey& key) const { return map_.find(key); }
+
+  void set(TKey key, TValue value) { map_.setEntry(std::move(key), std::move(value), token_); }
+  void erase(const TKey& key) { map_.eraseEntry(key, token_); }
+
+  // Returns the modified map. The transient stays usable, but copies nodes again from now on.
+  [[nodiscard]] PersistentHashMap persistent() {
+    token_ = details::makeEditToken();
+    return map_;
+  }
+
+ private:
+  friend class PersistentHashMap;
+
+  explicit Transient(PersistentHashMap map) : map_{std::move(map)}, token_{details::makeEditToken()} {}
+
+  PersistentHashMap map_;
+  details::EditToken token_;
+};
+
+}  // namespace funkypipes
+
+#endif  // FUNKYPIPES_PERSISTENT_HASH_MAP_HPP
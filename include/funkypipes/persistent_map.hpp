@@ -0,0 +1,336 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_PERSISTENT_MAP_HPP
+#define FUNKYPIPES_PERSISTENT_MAP_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "funkypipes/details/edit_token.hpp"
+
+namespace funkypipes {
+
+// PersistentMap is an immutable ordered map meant for states updated by pure functions. Copying it is O(1), and
+// modifications return a new map in O(log n) that shares all unchanged parts with the original one.
+//
+// The entries are stored in an AVL tree. A modification copies the path from the root to the modified node only
+// (path copying), including the nodes touched by rebalancing.
+//
+// Several modifications in a row can be done on a Transient, which modifies the nodes it created in place instead of
+// copying them again.
+//
+// Example usage:
+//   PersistentMap<Timestamp, Event> events;
+//   events = events.set(timestamp, event);
+//   for (const auto& [timestamp, event] : events) {...}
+template <typename TKey, typename TValue, typename TCompare = std::less<TKey>>
+class PersistentMap {
+  using Entry = std::pair<TKey, TValue>;
+
+  struct Node {
+    details::EditToken owner{details::kPersistentEditToken};
+    Entry entry;
+    std::shared_ptr<Node> left;
+    std::shared_ptr<Node> right;
+    int height{1};
+  };
+  using NodePtr = std::shared_ptr<Node>;
+
+ public:
+  using key_type = TKey;
+  using mapped_type = TValue;
+  using value_type = Entry;
+  using size_type = std::size_t;
+
+  class const_iterator;
+  class Transient;
+
+  PersistentMap() = default;
+
+  PersistentMap(std::initializer_list<Entry> entries) {
+    const auto token = details::makeEditToken();
+    for (const auto& entry : entries) {
+      setEntry(entry.first, entry.second, token);
+    }
+  }
+
+  [[nodiscard]] std::size_t size() const { return size_; }
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+
+  // Returns a pointer to the value of the given key, or nullptr if there is none.
+  [[nodiscard]] const TValue* find(const TKey& key) const {
+    const Node* node = root_.get();
+    while (node != nullptr) {
+      if (TCompare{}(key, node->entry.first)) {
+        node = node->left.get();
+      } else if (TCompare{}(node->entry.first, key)) {
+        node = node->right.get();
+      } else {
+        return &node->entry.second;
+      }
+    }
+    return nullptr;
+  }
+
+  // Returns the value of the given key, throws std::out_of_range if there is none.
+  [[nodiscard]] const TValue& at(const TKey& key) const {
+    const TValue* value = find(key);
+    if (value == nullptr) {
+      throw std::out_of_range("PersistentMap::at");
+    }
+    return *value;
+  }
+
+  [[nodiscard]] bool contains(const TKey& key) const { return find(key) != nullptr; }
+  [[nodiscard]] std::size_t count(const TKey& key) const { return contains(key) ? 1 : 0; }
+
+  // Iterates the entries in ascending key order.
+  [[nodiscard]] const_iterator begin() const { return const_iterator{root_.get()}; }
+  [[nodiscard]] const_iterator end() const { return const_iterator{}; }
+
+  // Returns a map in which the given key maps to the given value.
+  [[nodiscard]] PersistentMap set(TKey key, TValue value) const {
+    PersistentMap result{*this};
+    result.setEntry(std::move(key), std::move(value), details::makeEditToken());
+    return result;
+  }
+
+  // Returns a map without the given key.
+  [[nodiscard]] PersistentMap erase(const TKey& key) const {
+    PersistentMap result{*this};
+    result.eraseEntry(key, details::makeEditToken());
+    return result;
+  }
+
+  // Returns a transient for modifying a copy of this map in place.
+  [[nodiscard]] Transient transient() const { return Transient{*this}; }
+
+  friend bool operator==(const PersistentMap& lhs, const PersistentMap& rhs) {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+  friend bool operator!=(const PersistentMap& lhs, const PersistentMap& rhs) { return !(lhs == rhs); }
+
+ private:
+  static int heightOf(const NodePtr& node) { return node ? node->height : 0; }
+
+  static void updateHeight(Node& node) { node.height = 1 + std::max(heightOf(node.left), heightOf(node.right)); }
+
+  // Rotates the subtree so that its left child becomes its root.
+  static void rotateRight(NodePtr& nodePtr, details::EditToken token) {
+    auto& node = details::makeEditable(nodePtr, token);
+    NodePtr pivot = std::move(node.left);
+    auto& editablePivot = details::makeEditable(pivot, token);
+    node.left = std::move(editablePivot.right);
+    updateHeight(node);
+    editablePivot.right = std::move(nodePtr);
+    updateHeight(editablePivot);
+    nodePtr = std::move(pivot);
+  }
+
+  // Rotates the subtree so that its right child becomes its root.
+  static void rotateLeft(NodePtr& nodePtr, details::EditToken token) {
+    auto& node = details::makeEditable(nodePtr, token);
+    NodePtr pivot = std::move(node.right);
+    auto& editablePivot = details::makeEditable(pivot, token);
+    node.right = std::move(editablePivot.left);
+    updateHeight(node);
+    editablePivot.left = std::move(nodePtr);
+    updateHeight(editablePivot);
+    nodePtr = std::move(pivot);
+  }
+
+  // Restores the AVL balance of the editable subtree root after one of its subtrees changed height by one.
+  static void rebalance(NodePtr& nodePtr, details::EditToken token) {
+    Node& node = *nodePtr;
+    updateHeight(node);
+    const int balance = heightOf(node.left) - heightOf(node.right);
+    if (balance > 1) {
+      if (heightOf(node.left->left) < heightOf(node.left->right)) {
+        rotateLeft(node.left, token);
+      }
+      rotateRight(nodePtr, token);
+    } else if (balance < -1) {
+      if (heightOf(node.right->right) < heightOf(node.right->left)) {
+        rotateRight(node.right, token);
+      }
+      rotateLeft(nodePtr, token);
+    }
+  }
+
+  void setEntry(TKey key, TValue value, details::EditToken token) {
+    if (setIn(root_, key, value, token)) {
+      ++size_;
+    }
+  }
+
+  // Sets the entry within the given subtree and returns whether it was added.
+  static bool setIn(NodePtr& nodePtr, TKey& key, TValue& value, details::EditToken token) {
+    if (!nodePtr) {
+      nodePtr = std::make_shared<Node>();
+      nodePtr->owner = token;
+      nodePtr->entry = Entry{std::move(key), std::move(value)};
+      return true;
+    }
+    auto& node = details::makeEditable(nodePtr, token);
+    bool isAdded = false;
+    if (TCompare{}(key, node.entry.first)) {
+      isAdded = setIn(node.left, key, value, token);
+    } else if (TCompare{}(node.entry.first, key)) {
+      isAdded = setIn(node.right, key, value, token);
+    } else {
+      node.entry.second = std::move(value);
+    }
+    if (isAdded) {
+      rebalance(nodePtr, token);
+    }
+    return isAdded;
+  }
+
+  void eraseEntry(const TKey& key, details::EditToken token) {
+    if (eraseIn(root_, key, token)) {
+      --size_;
+    }
+  }
+
+  // Erases the entry from the given subtree and returns whether it was present.
+  static bool eraseIn(NodePtr& nodePtr, const TKey& key, details::EditToken token) {
+    if (!nodePtr) {
+      return false;
+    }
+    const bool isLess = TCompare{}(key, nodePtr->entry.first);
+    const bool isGreater = TCompare{}(nodePtr->entry.first, key);
+    if (isLess || isGreater) {
+      NodePtr child = isLess ? nodePtr->left : nodePtr->right;
+      if (!eraseIn(child, key, token)) {
+        return false;
+      }
+      auto& node = details::makeEditable(nodePtr, token);
+      (isLess ? node.left : node.right) = std::move(child);
+    } else if (!nodePtr->left || !nodePtr->right) {
+      nodePtr = nodePtr->left ? nodePtr->left : nodePtr->right;
+      return true;
+    } else {
+      auto& node = details::makeEditable(nodePtr, token);
+      node.entry = takeMinimum(node.right, token);
+    }
+    rebalance(nodePtr, token);
+    return true;
+  }
+
+  // Removes the entry with the smallest key from the non-empty subtree and returns it.
+  static Entry takeMinimum(NodePtr& nodePtr, details::EditToken token) {
+    if (!nodePtr->left) {
+      Entry entry = nodePtr->entry;
+      nodePtr = nodePtr->right;
+      return entry;
+    }
+    auto& node = details::makeEditable(nodePtr, token);
+    Entry entry = takeMinimum(node.left, token);
+    rebalance(nodePtr, token);
+    return entry;
+  }
+
+  NodePtr root_;
+  std::size_t size_{0};
+};
+
+// Iterates the entries of a PersistentMap in ascending key order.
+template <typename TKey, typename TValue, typename TCompare>
+class PersistentMap<TKey, TValue, TCompare>::const_iterator {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = Entry;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const Entry*;
+  using reference = const Entry&;
+
+  const_iterator() = default;
+
+  reference operator*() const { return path_.back()->entry; }
+  pointer operator->() const { return &path_.back()->entry; }
+
+  const_iterator& operator++() {
+    const Node* node = path_.back();
+    path_.pop_back();
+    descendLeft(node->right.get());
+    return *this;
+  }
+
+  const_iterator operator++(int) {
+    const_iterator previous{*this};
+    ++*this;
+    return previous;
+  }
+
+  friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) {
+    if (lhs.path_.empty() || rhs.path_.empty()) {
+      return lhs.path_.empty() && rhs.path_.empty();
+    }
+    return lhs.path_.back() == rhs.path_.back();
+  }
+  friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs) { return !(lhs == rhs); }
+
+ private:
+  friend class PersistentMap;
+
+  explicit const_iterator(const Node* root) { descendLeft(root); }
+
+  void descendLeft(const Node* node) {
+    for (; node != nullptr; node = node->left.get()) {
+      path_.push_back(node);
+    }
+  }
+
+  // Holds the nodes whose entries are still to be visited, the current one at the back.
+  std::vector<const Node*> path_;
+};
+
+// Modifies a copy of a PersistentMap in place, for applying many modifications at the cost of a single copy of each
+// touched node. A transient must not be shared between threads.
+template <typename TKey, typename TValue, typename TCompare>
+class PersistentMap<TKey, TValue, TCompare>::Transient {
+ public:
+  // Note: copies would share the edit token and thus modify each other's nodes in place
+  Transient(const Transient&) = delete;
+  Transient& operator=(const Transient&) = delete;
+  Transient(Transient&&) noexcept = default;
+  Transient& operator=(Transient&&) noexcept = default;
+  ~Transient() = default;
+
+  [[nodiscard]] std::size_t size() const { return map_.size(); }
+  [[nodiscard]] const TValue* find(const TKey& key) const { return map_.find(key); }
+
+  void set(TKey key, TValue value) { map_.setEntry(std::move(key), std::move(value), token_); }
+  void erase(const TKey& key) { map_.eraseEntry(key, token_); }
+
+  // Returns the modified map. The transient stays usable, but copies nodes again from now on.
+  [[nodiscard]] PersistentMap persistent() {
+    token_ = details::makeEditToken();
+    return map_;
+  }
+
+ private:
+  friend class PersistentMap;
+
+  explicit Transient(PersistentMap map) : map_{std::move(map)}, token_{details::makeEditToken()} {}
+
+  PersistentMap map_;
+  details::EditToken token_;
+};
+
+}  // namespace funkypipes
+
+#endif  // FUNKYPIPES_PERSISTENT_MAP_HPP
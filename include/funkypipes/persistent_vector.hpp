@@ -0,0 +1,376 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_PERSISTENT_VECTOR_HPP
+#define FUNKYPIPES_PERSISTENT_VECTOR_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "funkypipes/details/edit_token.hpp"
+
+namespace funkypipes {
+
+// PersistentVector is an immutable sequence meant for states updated by pure functions
+// ([](State state) { ...; return state; }). Copying it is O(1), and modifications return a new vector in O(log n)
+// that shares all unchanged parts with the original one, so the update functions of a StateStore no longer copy the
+// whole container.
+//
+// The elements are stored in a radix balanced tree with 32 elements per leaf plus a tail leaf for appending, like
+// Clojure's vector. An offset of the first element allows dropping elements at the front, so it also serves as a
+// queue (push_back and pop_front), e.g. for a sliding window of samples.
+//
+// Several modifications in a row can be done on a Transient, which modifies the nodes it created in place instead of
+// copying them again.
+//
+// Example usage:
+//   PersistentVector<double> samples;
+//   samples = samples.push_back(20.5).push_back(21.0);
+//   if (samples.size() > windowSize) samples = samples.pop_front();
+template <typename T>
+class PersistentVector {
+  static constexpr unsigned kBits = 5;
+  static constexpr std::size_t kWidth = std::size_t{1} << kBits;
+  static constexpr std::size_t kMask = kWidth - 1;
+
+  struct Node {
+    details::EditToken owner{details::kPersistentEditToken};
+  };
+  struct Leaf : Node {
+    std::vector<T> values;
+  };
+  struct Branch : Node {
+    std::array<std::shared_ptr<Node>, kWidth> children;
+  };
+
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  class const_iterator;
+  class Transient;
+
+  PersistentVector() = default;
+
+  PersistentVector(std::initializer_list<T> values) {
+    const auto token = details::makeEditToken();
+    for (const auto& value : values) {
+      pushBack(value, token);
+    }
+  }
+
+  [[nodiscard]] std::size_t size() const { return end_ - origin_; }
+  [[nodiscard]] bool empty() const { return size() == 0; }
+
+  // Returns the element at the given index, which must be less than size.
+  [[nodiscard]] const T& operator[](std::size_t index) const {
+    const std::size_t position = origin_ + index;
+    if (position >= tailBegin()) {
+      return tail_->values[position - tailBegin()];
+    }
+    return leafAt(position).values[position & kMask];
+  }
+
+  // Returns the element at the given index, throws std::out_of_range if there is none.
+  [[nodiscard]] const T& at(std::size_t index) const {
+    if (index >= size()) {
+      throw std::out_of_range("PersistentVector::at");
+    }
+    return (*this)[index];
+  }
+
+  [[nodiscard]] const T& front() const { return (*this)[0]; }
+  [[nodiscard]] const T& back() const { return (*this)[size() - 1]; }
+
+  [[nodiscard]] const_iterator begin() const { return const_iterator{this, 0}; }
+  [[nodiscard]] const_iterator end() const { return const_iterator{this, size()}; }
+
+  // Returns a vector with the given element appended.
+  [[nodiscard]] PersistentVector push_back(T value) const {
+    PersistentVector result{*this};
+    result.pushBack(std::move(value), details::makeEditToken());
+    return result;
+  }
+
+  // Returns a vector without the last element, the vector must not be empty.
+  [[nodiscard]] PersistentVector pop_back() const {
+    PersistentVector result{*this};
+    result.popBack(details::makeEditToken());
+    return result;
+  }
+
+  // Returns a vector without the first element, the vector must not be empty.
+  [[nodiscard]] PersistentVector pop_front() const {
+    PersistentVector result{*this};
+    result.popFront(details::makeEditToken());
+    return result;
+  }
+
+  // Returns a vector with the element at the given index replaced, the index must be less than size.
+  [[nodiscard]] PersistentVector set(std::size_t index, T value) const {
+    PersistentVector result{*this};
+    result.setAt(index, std::move(value), details::makeEditToken());
+    return result;
+  }
+
+  // Returns a transient for modifying a copy of this vector in place.
+  [[nodiscard]] Transient transient() const { return Transient{*this}; }
+
+  friend bool operator==(const PersistentVector& lhs, const PersistentVector& rhs) {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+  friend bool operator!=(const PersistentVector& lhs, const PersistentVector& rhs) { return !(lhs == rhs); }
+
+ private:
+  // Returns the tree position of the tail's first element. Tree positions of elements are never shifted, so
+  // the first element is at position origin_.
+  [[nodiscard]] std::size_t tailBegin() const { return end_ == 0 ? 0 : ((end_ - 1) >> kBits) << kBits; }
+
+  [[nodiscard]] const Leaf& leafAt(std::size_t position) const {
+    const Node* node = root_.get();
+    for (unsigned level = shift_; level > 0; level -= kBits) {
+      node = static_cast<const Branch*>(node)->children[(position >> level) & kMask].get();
+    }
+    return *static_cast<const Leaf*>(node);
+  }
+
+  // Returns a pointer to the element at the given index and the number of elements stored contiguously from there.
+  [[nodiscard]] std::pair<const T*, std::size_t> chunkAt(std::size_t index) const {
+    const std::size_t position = origin_ + index;
+    if (position >= tailBegin()) {
+      return {&tail_->values[position - tailBegin()], end_ - position};
+    }
+    return {&leafAt(position).values[position & kMask], kWidth - (position & kMask)};
+  }
+
+  void pushBack(T value, details::EditToken token) {
+    if (tail_ && end_ - tailBegin() < kWidth) {
+      details::makeEditable(tail_, token).values.push_back(std::move(value));
+      ++end_;
+      return;
+    }
+    if (tail_) {
+      insertLeaf(tailBegin(), std::move(tail_), token);
+    }
+    tail_ = std::make_shared<Leaf>();
+    tail_->owner = token;
+    tail_->values.reserve(kWidth);
+    tail_->values.push_back(std::move(value));
+    ++end_;
+  }
+
+  void popBack(details::EditToken token) {
+    if (size() == 1) {
+      *this = PersistentVector{};
+    } else if (end_ - tailBegin() > 1) {
+      details::makeEditable(tail_, token).values.pop_back();
+      --end_;
+    } else {
+      --end_;
+      const std::size_t leafPosition = tailBegin();
+      tail_ = std::static_pointer_cast<Leaf>(removeLeaf(root_, shift_, leafPosition, token));
+    }
+  }
+
+  void popFront(details::EditToken token) {
+    if (size() == 1) {
+      *this = PersistentVector{};
+      return;
+    }
+    ++origin_;
+    if ((origin_ & kMask) == 0 && origin_ <= tailBegin()) {
+      removeLeaf(root_, shift_, origin_ - kWidth, token);  // Note: releases the leaf that got completely dropped
+    }
+  }
+
+  void setAt(std::size_t index, T value, details::EditToken token) {
+    const std::size_t position = origin_ + index;
+    if (position >= tailBegin()) {
+      details::makeEditable(tail_, token).values[position - tailBegin()] = std::move(value);
+      return;
+    }
+    std::shared_ptr<Node>* slot = nullptr;
+    auto* branch = &details::makeEditable(root_, token);
+    for (unsigned level = shift_; level > 0; level -= kBits) {
+      slot = &branch->children[(position >> level) & kMask];
+      if (level > kBits) {
+        auto child = std::static_pointer_cast<Branch>(std::move(*slot));
+        branch = &details::makeEditable(child, token);
+        *slot = std::move(child);
+      }
+    }
+    auto leaf = std::static_pointer_cast<Leaf>(std::move(*slot));
+    details::makeEditable(leaf, token).values[position & kMask] = std::move(value);
+    *slot = std::move(leaf);
+  }
+
+  // Inserts a full leaf holding the elements from the given tree position on, growing the tree if necessary.
+  void insertLeaf(std::size_t position, std::shared_ptr<Leaf> leaf, details::EditToken token) {
+    while ((position >> (shift_ + kBits)) != 0) {
+      if (root_) {
+        auto newRoot = std::make_shared<Branch>();
+        newRoot->owner = token;
+        newRoot->children[0] = std::move(root_);
+        root_ = std::move(newRoot);
+      }
+      shift_ += kBits;
+    }
+
+    auto* branch = root_ ? &details::makeEditable(root_, token) : nullptr;
+    if (branch == nullptr) {
+      root_ = std::make_shared<Branch>();
+      root_->owner = token;
+      branch = root_.get();
+    }
+    for (unsigned level = shift_; level > kBits; level -= kBits) {
+      auto& slot = branch->children[(position >> level) & kMask];
+      auto child = std::static_pointer_cast<Branch>(std::move(slot));
+      if (child) {
+        details::makeEditable(child, token);
+      } else {
+        child = std::make_shared<Branch>();
+        child->owner = token;
+      }
+      branch = child.get();
+      slot = std::move(child);
+    }
+    branch->children[(position >> kBits) & kMask] = std::move(leaf);
+  }
+
+  // Removes the leaf at the given tree position from the subtree and returns it. Branches left without children are
+  // removed as well.
+  static std::shared_ptr<Node> removeLeaf(std::shared_ptr<Branch>& branch, unsigned level, std::size_t position,
+                                          details::EditToken token) {
+    auto& editableBranch = details::makeEditable(branch, token);
+    auto& slot = editableBranch.children[(position >> level) & kMask];
+    std::shared_ptr<Node> leaf;
+    if (level == kBits) {
+      leaf = std::move(slot);
+    } else {
+      auto child = std::static_pointer_cast<Branch>(std::move(slot));
+      leaf = removeLeaf(child, level - kBits, position, token);
+      slot = std::move(child);
+    }
+    const bool isEmpty = std::all_of(editableBranch.children.begin(), editableBranch.children.end(),
+                                     [](const auto& child) { return child == nullptr; });
+    if (isEmpty) {
+      branch.reset();
+    }
+    return leaf;
+  }
+
+  std::size_t origin_{0};
+  std::size_t end_{0};
+  unsigned shift_{kBits};
+  std::shared_ptr<Branch> root_;
+  std::shared_ptr<Leaf> tail_;
+};
+
+// Iterates the elements of a PersistentVector, stepping through the elements of a leaf without a tree lookup.
+template <typename T>
+class PersistentVector<T>::const_iterator {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const T*;
+  using reference = const T&;
+
+  const_iterator() = default;
+
+  reference operator*() const { return *chunk_; }
+  pointer operator->() const { return chunk_; }
+
+  const_iterator& operator++() {
+    ++index_;
+    if (--chunkSize_ > 0) {
+      ++chunk_;
+    } else {
+      loadChunk();
+    }
+    return *this;
+  }
+
+  const_iterator operator++(int) {
+    const_iterator previous{*this};
+    ++*this;
+    return previous;
+  }
+
+  friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) { return lhs.index_ == rhs.index_; }
+  friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs) { return lhs.index_ != rhs.index_; }
+
+ private:
+  friend class PersistentVector;
+
+  const_iterator(const PersistentVector* vector, std::size_t index) : vector_{vector}, index_{index} { loadChunk(); }
+
+  void loadChunk() {
+    if (index_ < vector_->size()) {
+      std::tie(chunk_, chunkSize_) = vector_->chunkAt(index_);
+    }
+  }
+
+  const PersistentVector* vector_{nullptr};
+  std::size_t index_{0};
+  const T* chunk_{nullptr};
+  std::size_t chunkSize_{0};
+};
+
+// Modifies a copy of a PersistentVector in place, for applying many modifications at the cost of a single copy of
+// each touched node. A transient must not be shared between threads.
+//
+// Example usage:
+//   auto transient = samples.transient();
+//   for (double sample : newSamples) transient.push_back(sample);
+//   samples = transient.persistent();
+template <typename T>
+class PersistentVector<T>::Transient {
+ public:
+  // Note: copies would share the edit token and thus modify each other's nodes in place
+  Transient(const Transient&) = delete;
+  Transient& operator=(const Transient&) = delete;
+  Transient(Transient&&) noexcept = default;
+  Transient& operator=(Transient&&) noexcept = default;
+  ~Transient() = default;
+
+  [[nodiscard]] std::size_t size() const { return vector_.size(); }
+  [[nodiscard]] bool empty() const { return vector_.empty(); }
+  [[nodiscard]] const T& operator[](std::size_t index) const { return vector_[index]; }
+
+  void push_back(T value) { vector_.pushBack(std::move(value), token_); }
+  void pop_back() { vector_.popBack(token_); }
+  void pop_front() { vector_.popFront(token_); }
+  void set(std::size_t index, T value) { vector_.setAt(index, std::move(value), token_); }
+
+  // Returns the modified vector. The transient stays usable, but copies nodes again from now on.
+  [[nodiscard]] PersistentVector persistent() {
+    token_ = details::makeEditToken();
+    return vector_;
+  }
+
+ private:
+  friend class PersistentVector;
+
+  explicit Transient(PersistentVector vector) : vector_{std::move(vector)}, token_{details::makeEditToken()} {}
+
+  PersistentVector vector_;
+  details::EditToken token_;
+};
+
+}  // namespace funkypipes
+
+#endif  // FUNKYPIPES_PERSISTENT_VECTOR_HPP
@@ -0,0 +1,207 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_REPLICATED_STATE_STORE_HPP
+#define FUNKYPIPES_REPLICATED_STATE_STORE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "funkypipes/details/make_tuple_unpacking.hpp"
+#include "funkypipes/details/state_update_result.hpp"
+
+namespace funkypipes {
+
+// ReplicatedStateStore is a variant of StateStore for states whose updates commute, like counters and histograms,
+// that are updated by many threads. Each thread applies its updates to a replica of its own, which lives on a cache
+// line of its own, so updates of different threads never contend and scale with the number of cores.
+//
+// The state is the combination of all replicas by the given merge function, which must be associative and commutative
+// and have the given identity as neutral element (i.e. form a commutative monoid). It is computed on each get_state,
+// from replicas read one after the other, so it may miss updates applied concurrently.
+//
+// The update and transform functions work like those of StateStore (see there), but operate on the replica of the
+// calling thread, starting from the identity. Hence an update must be expressible as merging a contribution into the
+// replica, e.g. increment a counter. As the merged state does not change with a single update, there are neither
+// update names nor a subscription.
+//
+// Replicas are kept per thread for the lifetime of the store, so threads should be long-lived (e.g. a thread pool).
+// Each thread caches its replica of the store it used last, alternating between several stores of the same type costs
+// a lookup under a mutex.
+//
+// Example usage:
+//   ReplicatedStateStore<std::uint64_t> requestCount{std::plus<>{}};
+//   auto countRequest = requestCount.bind([](std::uint64_t count) { return count + 1; });
+//   countRequest();  // from any thread
+//   std::uint64_t total = requestCount.get_state();
+template <typename TState, typename TMergeFn = std::function<TState(const TState&, const TState&)>>
+class ReplicatedStateStore {
+ public:
+  using MergeFn = TMergeFn;
+
+  // Constructor: Initializes the store with the merge function and its identity, which each replica starts from.
+  explicit ReplicatedStateStore(MergeFn mergeFn, TState identity = TState{});
+
+  // Applies an update function to the calling thread's replica with optional arguments, and returns any additional
+  // output.
+  template <typename TStateUpdateFn, typename... TArgs>
+  auto apply(const TStateUpdateFn& updateFn, TArgs&&... args);
+
+  // Applies an update function to the calling thread's replica and passes its result to a transformation function,
+  // returning the transformed output.
+  template <typename TStateUpdateFn, typename TTransformFn, typename... TArgs>
+  auto applyAndTransform(const TStateUpdateFn& updateFn, const TTransformFn& transformFn, TArgs&&... args);
+
+  // Returns a callable that, when invoked, applies the update function to the calling thread's replica.
+  template <typename TStateUpdateFn>
+  [[nodiscard]] auto bind(TStateUpdateFn&& updateFn);
+
+  // Returns a callable that, when invoked, applies the update function to the calling thread's replica and then the
+  // transform function to the result.
+  template <typename TStateUpdateFn, typename TTransformFn>
+  [[nodiscard]] auto bind(TStateUpdateFn&& updateFn, TTransformFn&& transformFn);
+
+  // Returns the merged state of all replicas. May be called concurrently with updates from any thread.
+  [[nodiscard]] TState get_state() const;
+
+ private:
+  static constexpr std::size_t kCacheLineSize = 64;
+
+  struct alignas(kCacheLineSize) Replica {
+    explicit Replica(TState initialState) : state{std::move(initialState)} {}
+
+    // Note: contended by get_state only, as each replica is updated by a single thread
+    std::mutex mutex;
+    TState state;
+  };
+
+  // Returns a number identifying this store, which differs from those of all stores created before.
+  static std::uint64_t makeStoreId();
+
+  // Returns the replica of the calling thread, creating it on first use.
+  Replica& localReplica();
+
+  // Applies an update function to the calling thread's replica and forwards the update result.
+  template <typename TStateUpdateFn, typename... TArgs>
+  auto applyForwardingUpdateResult(const TStateUpdateFn& updateFn, TArgs&&... args);
+
+  MergeFn mergeFn_;
+  TState identity_;
+  std::uint64_t storeId_;
+  mutable std::mutex replicasMutex_;
+  std::vector<std::unique_ptr<Replica>> replicas_;
+  std::unordered_map<std::thread::id, Replica*> replicaOfThread_;
+};
+
+template <typename TState, typename TMergeFn>
+ReplicatedStateStore<TState, TMergeFn>::ReplicatedStateStore(MergeFn mergeFn, TState identity)
+    : mergeFn_{std::move(mergeFn)}, identity_{std::move(identity)}, storeId_{makeStoreId()} {}
+
+template <typename TState, typename TMergeFn>
+template <typename TStateUpdateFn, typename... TArgs>
+auto ReplicatedStateStore<TState, TMergeFn>::apply(const TStateUpdateFn& updateFn, TArgs&&... args) {
+  namespace fpd = ::funkypipes::details;
+
+  auto updateResult = applyForwardingUpdateResult(updateFn, std::forward<decltype(args)>(args)...);
+
+  return fpd::outputsOf(std::move(updateResult));
+}
+
+template <typename TState, typename TMergeFn>
+template <typename TStateUpdateFn, typename TTransformFn, typename... TArgs>
+auto ReplicatedStateStore<TState, TMergeFn>::applyAndTransform(const TStateUpdateFn& updateFn,
+                                                               const TTransformFn& transformFn, TArgs&&... args) {
+  namespace fpd = ::funkypipes::details;
+
+  auto updateResult = applyForwardingUpdateResult(updateFn, std::forward<decltype(args)>(args)...);
+  auto tupleAwareTransformFn = fpd::makeTupleUnpacking(transformFn);
+  return tupleAwareTransformFn(std::move(updateResult));
+}
+
+template <typename TState, typename TMergeFn>
+template <typename TStateUpdateFn>
+[[nodiscard]] auto ReplicatedStateStore<TState, TMergeFn>::bind(TStateUpdateFn&& updateFn) {
+  return [this, updateFn_ = std::forward<decltype(updateFn)>(updateFn)](auto&&... args) {
+    return this->apply(updateFn_, std::forward<decltype(args)>(args)...);
+  };
+}
+
+template <typename TState, typename TMergeFn>
+template <typename TStateUpdateFn, typename TTransformFn>
+[[nodiscard]] auto ReplicatedStateStore<TState, TMergeFn>::bind(TStateUpdateFn&& updateFn,
+                                                                TTransformFn&& transformFn) {
+  return [this, updateFn_ = std::forward<decltype(updateFn)>(updateFn),
+          transformFn_ = std::forward<decltype(transformFn)>(transformFn)](auto&&... args) {
+    return this->applyAndTransform(updateFn_, transformFn_, std::forward<decltype(args)>(args)...);
+  };
+}
+
+template <typename TState, typename TMergeFn>
+[[nodiscard]] TState ReplicatedStateStore<TState, TMergeFn>::get_state() const {
+  TState mergedState = identity_;
+  std::lock_guard<std::mutex> replicasLock{replicasMutex_};
+  for (const auto& replica : replicas_) {
+    std::lock_guard<std::mutex> lock{replica->mutex};
+    mergedState = mergeFn_(mergedState, replica->state);
+  }
+  return mergedState;
+}
+
+template <typename TState, typename TMergeFn>
+std::uint64_t ReplicatedStateStore<TState, TMergeFn>::makeStoreId() {
+  static std::atomic<std::uint64_t> nextStoreId{1};
+  return nextStoreId.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename TState, typename TMergeFn>
+auto ReplicatedStateStore<TState, TMergeFn>::localReplica() -> Replica& {
+  // Note: identified by id rather than address, as a new store may reuse the address of a destroyed one
+  struct CachedReplica {
+    std::uint64_t storeId{0};
+    Replica* replica{nullptr};
+  };
+  thread_local CachedReplica cachedReplica;
+  if (cachedReplica.storeId == storeId_) {
+    return *cachedReplica.replica;
+  }
+
+  std::lock_guard<std::mutex> replicasLock{replicasMutex_};
+  Replica*& replica = replicaOfThread_[std::this_thread::get_id()];
+  if (replica == nullptr) {
+    replica = replicas_.emplace_back(std::make_unique<Replica>(identity_)).get();
+  }
+  cachedReplica = CachedReplica{storeId_, replica};
+  return *replica;
+}
+
+template <typename TState, typename TMergeFn>
+template <typename TStateUpdateFn, typename... TArgs>
+auto ReplicatedStateStore<TState, TMergeFn>::applyForwardingUpdateResult(const TStateUpdateFn& updateFn,
+                                                                        TArgs&&... args) {
+  namespace fpd = ::funkypipes::details;
+
+  Replica& replica = localReplica();
+  std::lock_guard<std::mutex> lock{replica.mutex};
+
+  auto updateResult = updateFn(replica.state, std::forward<TArgs>(args)...);
+
+  replica.state = fpd::newStateOf(updateResult);
+
+  return updateResult;
+}
+
+}  // namespace funkypipes
+
+#endif  // FUNKYPIPES_REPLICATED_STATE_STORE_HPP
@@ -0,0 +1,166 @@
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_SEQLOCK_STATE_STORE_HPP
+#define FUNKYPIPES_SEQLOCK_STATE_STORE_HPP
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <type_traits>
+
+#include "funkypipes/details/make_tuple_unpacking.hpp"
+#include "funkypipes/details/seqlock.hpp"
+#include "funkypipes/details/state_update_result.hpp"
+#include "funkypipes/details/subscription.hpp"
+
+namespace funkypipes {
+
+// SeqlockStateStore is a variant of StateStore for small, trivially copyable states (counters, a few doubles, fixed
+// arrays) that are read by many threads. It offers the same interface as StateStore, see there for the expected
+// signatures of update, transform and subscription functions.
+//
+// The state is published through a sequence lock: updates are applied to a private copy and then written in place into
+// a version stamped buffer, while readers copy the buffer optimistically and retry if it was written meanwhile. Hence
+// get_state is lock-free and does not write to shared memory, so reads scale with the number of cores. Updates are
+// serialized by a mutex, the subscription function is called while holding it. With an OnChangeSubscription (see
+// on_change_subscription.hpp), updates that do not change the state are not published.
+template <typename TState, typename TUpdateName = std::string,
+          typename TSubscriptionFn = std::function<void(const TUpdateName&, const TState&, const TState&)>>
+class SeqlockStateStore {
+  static_assert(std::is_trivially_copyable_v<TState>, "SeqlockStateStore requires a trivially copyable state");
+
+ public:
+  using UpdateName = TUpdateName;
+  using SubscriptionFn = TSubscriptionFn;
+
+  // Constructor: Initializes the store with an optional subscription callback and initial state.
+  explicit SeqlockStateStore(SubscriptionFn subscriptionFn = SubscriptionFn{}, TState initialState = TState{});
+
+  // Constructor: Initializes the store with an initial state.
+  explicit SeqlockStateStore(TState initialState);
+
+  // Applies an update function to the state with optional arguments, and returns any additional output.
+  template <typename TStateUpdateFn, typename... TArgs>
+  auto apply(const UpdateName& updateName, const TStateUpdateFn& updateFn, TArgs&&... args);
+
+  // Applies an update function to the state and passes its result to a transformation function, returning the
+  // transformed output.
+  template <typename TStateUpdateFn, typename TTransformFn, typename... TArgs>
+  auto applyAndTransform(const UpdateName& updateName, const TStateUpdateFn& updateFn, const TTransformFn& transformFn,
+                         TArgs&&... args);
+
+  // Returns a callable that, when invoked, applies the update function to the state using the specified update name.
+  template <typename TStateUpdateFn>
+  [[nodiscard]] auto bind(UpdateName updateName, TStateUpdateFn&& updateFn);
+
+  // Returns a callable that, when invoked, applies the update function and then the transform function to the result,
+  // using the specified update name.
+  template <typename TStateUpdateFn, typename TTransformFn>
+  [[nodiscard]] auto bind(UpdateName updateName, TStateUpdateFn&& updateFn, TTransformFn&& transformFn);
+
+  // Returns the current state value. Lock-free, may be called concurrently with updates from any thread.
+  [[nodiscard]] TState get_state() const;
+
+ private:
+  // Applies an update function to the state, publishes the new state, notifies the subscription (if present), and
+  // forwards the update result.
+  template <typename TStateUpdateFn, typename... TArgs>
+  auto applyForwardingUpdateResult(const UpdateName& updateName, const TStateUpdateFn& updateFn, TArgs&&... args);
+
+  SubscriptionFn subscriptionFn_;
+  std::mutex updateMutex_;
+  TState writerState_;
+  details::Seqlock<TState> publishedState_;
+};
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+SeqlockStateStore<TState, TUpdateName, TSubscriptionFn>::SeqlockStateStore(SubscriptionFn subscriptionFn,
+                                                                           TState initialState)
+    : subscriptionFn_{std::move(subscriptionFn)}, writerState_{initialState}, publishedState_{initialState} {}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+SeqlockStateStore<TState, TUpdateName, TSubscriptionFn>::SeqlockStateStore(TState initialState)
+    : subscriptionFn_{}, writerState_{initialState}, publishedState_{initialState} {}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+template <typename TStateUpdateFn, typename... TArgs>
+auto SeqlockStateStore<TState, TUpdateName, TSubscriptionFn>::apply(const UpdateName& updateName,
+                                                                    const TStateUpdateFn& updateFn, TArgs&&... args) {
+  namespace fpd = ::funkypipes::details;
+
+  auto updateResult = applyForwardingUpdateResult(updateName, updateFn, std::forward<decltype(args)>(args)...);
+
+  return fpd::outputsOf(std::move(updateResult));
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+template <typename TStateUpdateFn, typename TTransformFn, typename... TArgs>
+auto SeqlockStateStore<TState, TUpdateName, TSubscriptionFn>::applyAndTransform(const UpdateName& updateName,
+                                                                                const TStateUpdateFn& updateFn,
+                                                                                const TTransformFn& transformFn,
+                                                                                TArgs&&... args) {
+  namespace fpd = ::funkypipes::details;
+
+  auto updateResult = applyForwardingUpdateResult(updateName, updateFn, std::forward<decltype(args)>(args)...);
+  auto tupleAwareTransformFn = fpd::makeTupleUnpacking(transformFn);
+  return tupleAwareTransformFn(std::move(updateResult));
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+template <typename TStateUpdateFn>
+[[nodiscard]] auto SeqlockStateStore<TState, TUpdateName, TSubscriptionFn>::bind(UpdateName updateName,
+                                                                                 TStateUpdateFn&& updateFn) {
+  return [this, updateName_ = std::move(updateName), updateFn_ = std::forward<decltype(updateFn)>(updateFn)](
+             auto&&... args) { return this->apply(updateName_, updateFn_, std::forward<decltype(args)>(args)...); };
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+template <typename TStateUpdateFn, typename TTransformFn>
+[[nodiscard]] auto SeqlockStateStore<TState, TUpdateName, TSubscriptionFn>::bind(UpdateName updateName,
+                                                                                 TStateUpdateFn&& updateFn,
+                                                                                 TTransformFn&& transformFn) {
+  return [this, updateName_ = std::move(updateName), updateFn_ = std::forward<decltype(updateFn)>(updateFn),
+          transformFn_ = std::forward<decltype(transformFn)>(transformFn)](auto&&... args) {
+    return this->applyAndTransform(updateName_, updateFn_, transformFn_, std::forward<decltype(args)>(args)...);
+  };
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+[[nodiscard]] TState SeqlockStateStore<TState, TUpdateName, TSubscriptionFn>::get_state() const {
+  return publishedState_.load();
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+template <typename TStateUpdateFn, typename... TArgs>
+auto SeqlockStateStore<TState, TUpdateName, TSubscriptionFn>::applyForwardingUpdateResult(
+    const UpdateName& updateName, const TStateUpdateFn& updateFn, TArgs&&... args) {
+  namespace fpd = ::funkypipes::details;
+
+  std::lock_guard<std::mutex> lock{updateMutex_};
+
+  const auto lastState = writerState_;
+
+  auto updateResult = updateFn(writerState_, std::forward<TArgs>(args)...);
+
+  if (!fpd::isStoredUpdate(subscriptionFn_, writerState_, fpd::newStateOf(updateResult))) {
+    return updateResult;
+  }
+
+  writerState_ = fpd::newStateOf(updateResult);
+  publishedState_.store(writerState_);
+
+  if (fpd::hasSubscription(subscriptionFn_)) {
+    fpd::notifyStoredUpdate(subscriptionFn_, updateName, lastState, writerState_);
+  }
+
+  return updateResult;
+}
+
+}  // namespace funkypipes
+
+#endif  // FUNKYPIPES_SEQLOCK_STATE_STORE_HPP
@@ -0,0 +1,109 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_SERIALIZATION_HPP
+#define FUNKYPIPES_SERIALIZATION_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace funkypipes {
+
+// Serialization is the customization point defining how values are written to and read from binary buffers, as done by
+// JournaledStateStore for update arguments and state snapshots. Specializations are provided for trivially copyable
+// types (written bytewise, so they must not hold pointers), std::string and std::vector. Other types need a
+// specialization of their own:
+//
+//   template <>
+//   struct funkypipes::Serialization<MyType> {
+//     static void write(std::string& buffer, const MyType& value);  // appends the value to buffer
+//     static MyType read(std::string_view& buffer);                 // consumes the value from the front of buffer
+//   };
+//
+// The binary format is host specific, it is meant for files written and read on the same machine.
+template <typename T, typename = void>
+struct Serialization;
+
+namespace details {
+
+// Removes the given number of bytes from the front of the buffer and returns a pointer to them.
+inline const char* consumeBytes(std::string_view& buffer, std::size_t size) {
+  if (buffer.size() < size) {
+    throw std::out_of_range("serialized value exceeds buffer");
+  }
+  const char* bytes = buffer.data();
+  buffer.remove_prefix(size);
+  return bytes;
+}
+
+}  // namespace details
+
+template <typename T>
+struct Serialization<T, std::enable_if_t<std::is_trivially_copyable_v<T>>> {
+  static void write(std::string& buffer, const T& value) {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  static T read(std::string_view& buffer) {
+    T value;
+    std::memcpy(&value, details::consumeBytes(buffer, sizeof(T)), sizeof(T));
+    return value;
+  }
+};
+
+template <>
+struct Serialization<std::string> {
+  static void write(std::string& buffer, const std::string& value) {
+    Serialization<std::uint64_t>::write(buffer, value.size());
+    buffer.append(value);
+  }
+
+  static std::string read(std::string_view& buffer) {
+    const auto size = static_cast<std::size_t>(Serialization<std::uint64_t>::read(buffer));
+    return std::string{details::consumeBytes(buffer, size), size};
+  }
+};
+
+template <typename T>
+struct Serialization<std::vector<T>> {
+  static void write(std::string& buffer, const std::vector<T>& values) {
+    Serialization<std::uint64_t>::write(buffer, values.size());
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      buffer.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+    } else {
+      for (const auto& value : values) {
+        Serialization<T>::write(buffer, value);
+      }
+    }
+  }
+
+  static std::vector<T> read(std::string_view& buffer) {
+    const auto size = static_cast<std::size_t>(Serialization<std::uint64_t>::read(buffer));
+    std::vector<T> values;
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      const char* bytes = details::consumeBytes(buffer, size * sizeof(T));
+      values.resize(size);
+      std::memcpy(values.data(), bytes, size * sizeof(T));
+    } else {
+      values.reserve(size);
+      for (std::size_t idx = 0; idx < size; ++idx) {
+        values.push_back(Serialization<T>::read(buffer));
+      }
+    }
+    return values;
+  }
+};
+
+}  // namespace funkypipes
+
+#endif  // FUNKYPIPES_SERIALIZATION_HPP
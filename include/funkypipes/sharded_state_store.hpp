@@ -0,0 +1,283 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_SHARDED_STATE_STORE_HPP
+#define FUNKYPIPES_SHARDED_STATE_STORE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "funkypipes/details/make_tuple_unpacking.hpp"
+#include "funkypipes/details/state_update_result.hpp"
+#include "funkypipes/details/subscription.hpp"
+#include "funkypipes/persistent_hash_map.hpp"
+
+namespace funkypipes {
+
+// ShardedStateStore is a variant of StateStore for states that are maps from keys (e.g. device ids) to values, updated
+// one key at a time. The keys are partitioned by hash across a number of shards, each guarded by a mutex of its own,
+// so updates of keys in different shards run in parallel while the updates of a key are serialized in the order they
+// acquire its shard.
+//
+// The update, transform and subscription functions work like those of StateStore (see there), but on the value of a
+// single key instead of the whole state, and apply takes the key in addition to the update name. Keys without a value
+// start from a default constructed one. The subscription function is called while holding the key's shard, with the
+// update name, the key, the old value and the new value:
+//   void subscriptionFn(const std::string& updateName, const Key& key, const Value& oldValue, const Value& newValue);
+// It must not apply updates to the store itself.
+//
+// Each shard holds its values in a persistent map modified in place (see persistent_hash_map.hpp), so snapshot returns
+// a consistent view of all values: it holds all shards just long enough to detach their maps in O(1), without copying
+// any value.
+//
+// Example usage:
+//   ShardedStateStore<DeviceId, Reading> store{16};
+//   auto addSample = store.bind("addSample", addSampleFn);
+//   addSample(deviceId, sample);  // from any thread
+//   auto snapshot = store.snapshot();
+template <typename TKey, typename TValue, typename TUpdateName = std::string,
+          typename TSubscriptionFn = std::function<void(const TUpdateName&, const TKey&, const TValue&, const TValue&)>,
+          typename THash = std::hash<TKey>>
+class ShardedStateStore {
+  using Values = PersistentHashMap<TKey, TValue, THash>;
+
+ public:
+  using UpdateName = TUpdateName;
+  using SubscriptionFn = TSubscriptionFn;
+
+  class Snapshot;
+
+  // Constructor: Initializes the store with the given number of shards and an optional subscription callback.
+  explicit ShardedStateStore(std::size_t shardCount, SubscriptionFn subscriptionFn = SubscriptionFn{});
+
+  // Applies an update function to the value of the given key with optional arguments, and returns any additional
+  // output.
+  template <typename TValueUpdateFn, typename... TArgs>
+  auto apply(const UpdateName& updateName, const TKey& key, const TValueUpdateFn& updateFn, TArgs&&... args);
+
+  // Applies an update function to the value of the given key and passes its result to a transformation function,
+  // returning the transformed output.
+  template <typename TValueUpdateFn, typename TTransformFn, typename... TArgs>
+  auto applyAndTransform(const UpdateName& updateName, const TKey& key, const TValueUpdateFn& updateFn,
+                         const TTransformFn& transformFn, TArgs&&... args);
+
+  // Returns a callable that, when invoked with a key and optional arguments, applies the update function to the value
+  // of that key using the specified update name.
+  template <typename TValueUpdateFn>
+  [[nodiscard]] auto bind(UpdateName updateName, TValueUpdateFn&& updateFn);
+
+  // Returns a callable that, when invoked with a key and optional arguments, applies the update function and then the
+  // transform function to the result, using the specified update name.
+  template <typename TValueUpdateFn, typename TTransformFn>
+  [[nodiscard]] auto bind(UpdateName updateName, TValueUpdateFn&& updateFn, TTransformFn&& transformFn);
+
+  // Returns the current value of the given key, if any.
+  [[nodiscard]] std::optional<TValue> get(const TKey& key) const;
+
+  // Returns a consistent view of the values of all keys, reflecting all updates completed before.
+  [[nodiscard]] Snapshot snapshot() const;
+
+  [[nodiscard]] std::size_t shardCount() const { return shardCount_; }
+
+ private:
+  static constexpr std::size_t kCacheLineSize = 64;
+
+  struct alignas(kCacheLineSize) Shard {
+    mutable std::mutex mutex;
+    mutable typename Values::Transient values{Values{}.transient()};
+  };
+
+  // Returns the index of the shard holding the given key.
+  static std::size_t shardIndexOf(const TKey& key, std::size_t shardCount);
+
+  [[nodiscard]] Shard& shardOf(const TKey& key) const;
+
+  // Applies an update function to the value of the given key, notifies the subscription (if present), and forwards the
+  // update result.
+  template <typename TValueUpdateFn, typename... TArgs>
+  auto applyForwardingUpdateResult(const UpdateName& updateName, const TKey& key, const TValueUpdateFn& updateFn,
+                                   TArgs&&... args);
+
+  SubscriptionFn subscriptionFn_;
+  std::size_t shardCount_;
+  std::unique_ptr<Shard[]> shards_;
+};
+
+// A consistent view of the values of all keys of a ShardedStateStore at the time it was taken.
+template <typename TKey, typename TValue, typename TUpdateName, typename TSubscriptionFn, typename THash>
+class ShardedStateStore<TKey, TValue, TUpdateName, TSubscriptionFn, THash>::Snapshot {
+ public:
+  [[nodiscard]] std::size_t size() const {
+    std::size_t size = 0;
+    for (const auto& values : shardValues_) {
+      size += values.size();
+    }
+    return size;
+  }
+
+  // Returns a pointer to the value of the given key, or nullptr if there is none.
+  [[nodiscard]] const TValue* find(const TKey& key) const { return valuesOf(key).find(key); }
+
+  // Returns the value of the given key, throws std::out_of_range if there is none.
+  [[nodiscard]] const TValue& at(const TKey& key) const { return valuesOf(key).at(key); }
+
+  [[nodiscard]] bool contains(const TKey& key) const { return find(key) != nullptr; }
+
+  // Calls the given function with each key and its value, in an unspecified order.
+  template <typename TFn>
+  void forEach(TFn&& fn) const {
+    for (const auto& values : shardValues_) {
+      for (const auto& [key, value] : values) {
+        fn(key, value);
+      }
+    }
+  }
+
+ private:
+  friend class ShardedStateStore;
+
+  explicit Snapshot(std::vector<Values> shardValues) : shardValues_{std::move(shardValues)} {}
+
+  [[nodiscard]] const Values& valuesOf(const TKey& key) const {
+    return shardValues_[shardIndexOf(key, shardValues_.size())];
+  }
+
+  std::vector<Values> shardValues_;
+};
+
+template <typename TKey, typename TValue, typename TUpdateName, typename TSubscriptionFn, typename THash>
+ShardedStateStore<TKey, TValue, TUpdateName, TSubscriptionFn, THash>::ShardedStateStore(std::size_t shardCount,
+                                                                                      SubscriptionFn subscriptionFn)
+    : subscriptionFn_{std::move(subscriptionFn)}, shardCount_{shardCount} {
+  if (shardCount == 0) {
+    throw std::invalid_argument("ShardedStateStore requires at least one shard");
+  }
+  shards_ = std::make_unique<Shard[]>(shardCount);
+}
+
+template <typename TKey, typename TValue, typename TUpdateName, typename TSubscriptionFn, typename THash>
+template <typename TValueUpdateFn, typename... TArgs>
+auto ShardedStateStore<TKey, TValue, TUpdateName, TSubscriptionFn, THash>::apply(const UpdateName& updateName,
+                                                                                const TKey& key,
+                                                                                const TValueUpdateFn& updateFn,
+                                                                                TArgs&&... args) {
+  namespace fpd = ::funkypipes::details;
+
+  auto updateResult = applyForwardingUpdateResult(updateName, key, updateFn, std::forward<decltype(args)>(args)...);
+
+  return fpd::outputsOf(std::move(updateResult));
+}
+
+template <typename TKey, typename TValue, typename TUpdateName, typename TSubscriptionFn, typename THash>
+template <typename TValueUpdateFn, typename TTransformFn, typename... TArgs>
+auto ShardedStateStore<TKey, TValue, TUpdateName, TSubscriptionFn, THash>::applyAndTransform(
+    const UpdateName& updateName, const TKey& key, const TValueUpdateFn& updateFn, const TTransformFn& transformFn,
+    TArgs&&... args) {
+  namespace fpd = ::funkypipes::details;
+
+  auto updateResult = applyForwardingUpdateResult(updateName, key, updateFn, std::forward<decltype(args)>(args)...);
+  auto tupleAwareTransformFn = fpd::makeTupleUnpacking(transformFn);
+  return tupleAwareTransformFn(std::move(updateResult));
+}
+
+template <typename TKey, typename TValue, typename TUpdateName, typename TSubscriptionFn, typename THash>
+template <typename TValueUpdateFn>
+[[nodiscard]] auto ShardedStateStore<TKey, TValue, TUpdateName, TSubscriptionFn, THash>::bind(
+    UpdateName updateName, TValueUpdateFn&& updateFn) {
+  return [this, updateName_ = std::move(updateName), updateFn_ = std::forward<decltype(updateFn)>(updateFn)](
+             const TKey& key, auto&&... args) {
+    return this->apply(updateName_, key, updateFn_, std::forward<decltype(args)>(args)...);
+  };
+}
+
+template <typename TKey, typename TValue, typename TUpdateName, typename TSubscriptionFn, typename THash>
+template <typename TValueUpdateFn, typename TTransformFn>
+[[nodiscard]] auto ShardedStateStore<TKey, TValue, TUpdateName, TSubscriptionFn, THash>::bind(
+    UpdateName updateName, TValueUpdateFn&& updateFn, TTransformFn&& transformFn) {
+  return [this, updateName_ = std::move(updateName), updateFn_ = std::forward<decltype(updateFn)>(updateFn),
+          transformFn_ = std::forward<decltype(transformFn)>(transformFn)](const TKey& key, auto&&... args) {
+    return this->applyAndTransform(updateName_, key, updateFn_, transformFn_, std::forward<decltype(args)>(args)...);
+  };
+}
+
+template <typename TKey, typename TValue, typename TUpdateName, typename TSubscriptionFn, typename THash>
+[[nodiscard]] std::optional<TValue> ShardedStateStore<TKey, TValue, TUpdateName, TSubscriptionFn, THash>::get(
+    const TKey& key) const {
+  Shard& shard = shardOf(key);
+  std::lock_guard<std::mutex> lock{shard.mutex};
+  const TValue* value = shard.values.find(key);
+  return value != nullptr ? std::optional<TValue>{*value} : std::nullopt;
+}
+
+template <typename TKey, typename TValue, typename TUpdateName, typename TSubscriptionFn, typename THash>
+[[nodiscard]] auto ShardedStateStore<TKey, TValue, TUpdateName, TSubscriptionFn, THash>::snapshot() const
+    -> Snapshot {
+  // Note: all shards are held at once, so no update is reflected partially. They are acquired in index order, which
+  // cannot deadlock as updates hold a single shard only.
+  std::vector<std::unique_lock<std::mutex>> locks;
+  locks.reserve(shardCount_);
+  for (std::size_t index = 0; index < shardCount_; ++index) {
+    locks.emplace_back(shards_[index].mutex);
+  }
+
+  std::vector<Values> shardValues;
+  shardValues.reserve(shardCount_);
+  for (std::size_t index = 0; index < shardCount_; ++index) {
+    shardValues.push_back(shards_[index].values.persistent());
+  }
+  return Snapshot{std::move(shardValues)};
+}
+
+template <typename TKey, typename TValue, typename TUpdateName, typename TSubscriptionFn, typename THash>
+std::size_t ShardedStateStore<TKey, TValue, TUpdateName, TSubscriptionFn, THash>::shardIndexOf(const TKey& key,
+                                                                                             std::size_t shardCount) {
+  // Note: the hash is mixed, as the shards' maps index their keys by the low bits of the same hash
+  constexpr std::uint64_t kGoldenRatio = 0x9E3779B97F4A7C15ULL;
+  const std::uint64_t mixedHash = static_cast<std::uint64_t>(THash{}(key)) * kGoldenRatio;
+  return static_cast<std::size_t>((mixedHash >> 32) % shardCount);
+}
+
+template <typename TKey, typename TValue, typename TUpdateName, typename TSubscriptionFn, typename THash>
+auto ShardedStateStore<TKey, TValue, TUpdateName, TSubscriptionFn, THash>::shardOf(const TKey& key) const -> Shard& {
+  return shards_[shardIndexOf(key, shardCount_)];
+}
+
+template <typename TKey, typename TValue, typename TUpdateName, typename TSubscriptionFn, typename THash>
+template <typename TValueUpdateFn, typename... TArgs>
+auto ShardedStateStore<TKey, TValue, TUpdateName, TSubscriptionFn, THash>::applyForwardingUpdateResult(
+    const UpdateName& updateName, const TKey& key, const TValueUpdateFn& updateFn, TArgs&&... args) {
+  namespace fpd = ::funkypipes::details;
+
+  Shard& shard = shardOf(key);
+  std::lock_guard<std::mutex> lock{shard.mutex};
+
+  const TValue* currentValue = shard.values.find(key);
+  const TValue lastValue = currentValue != nullptr ? *currentValue : TValue{};
+
+  auto updateResult = updateFn(lastValue, std::forward<TArgs>(args)...);
+
+  shard.values.set(key, fpd::newStateOf(updateResult));
+
+  if (fpd::hasSubscription(subscriptionFn_)) {
+    subscriptionFn_(updateName, key, lastValue, *shard.values.find(key));
+  }
+
+  return updateResult;
+}
+
+}  // namespace funkypipes
+
+#endif  // FUNKYPIPES_SHARDED_STATE_STORE_HPP
@@ -0,0 +1,280 @@
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_SHARED_MEMORY_STATE_STORE_HPP
+#define FUNKYPIPES_SHARED_MEMORY_STATE_STORE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+
+#include "funkypipes/details/make_tuple_unpacking.hpp"
+#include "funkypipes/details/seqlock.hpp"
+#include "funkypipes/details/shared_memory_mapping.hpp"
+#include "funkypipes/details/state_update_result.hpp"
+#include "funkypipes/details/subscription.hpp"
+
+namespace funkypipes {
+
+namespace details {
+
+// Layout of a shared memory segment holding a state. The magic number is written last, so a reader that finds it has
+// a fully initialized segment in front of it.
+template <typename TState>
+struct SharedMemoryStateSegment {
+  static constexpr std::uint64_t kMagic = 0x66756e6b79737473;  // "funkysts"
+
+  explicit SharedMemoryStateSegment(const TState& initialState) : state{initialState} {
+    magic.store(kMagic, std::memory_order_release);
+  }
+
+  [[nodiscard]] bool isValid() const {
+    return magic.load(std::memory_order_acquire) == kMagic && stateSize == sizeof(TState);
+  }
+
+  std::atomic<std::uint64_t> magic{0};
+  std::uint64_t stateSize{sizeof(TState)};
+  Seqlock<TState> state;
+};
+
+}  // namespace details
+
+// SharedMemoryStateStore is a variant of StateStore whose state lives in a named POSIX shared memory segment, so that
+// other processes on the same host can read it via SharedMemoryStateReader. It offers the same interface as StateStore,
+// see there for the expected signatures of update, transform and subscription functions.
+//
+// The store is the single writer of the segment: updates are applied to a private copy and published through a
+// sequence lock inside the segment. No serialization is involved as the state is required to be trivially copyable,
+// which also implies it must not contain pointers into the writer's address space. The segment is created on
+// construction, removing the name of any existing segment first (its readers keep the old segment), and its name is
+// removed on destruction. Failing system calls are reported by throwing std::system_error.
+template <typename TState, typename TUpdateName = std::string,
+          typename TSubscriptionFn = std::function<void(const TUpdateName&, const TState&, const TState&)>>
+class SharedMemoryStateStore {
+  static_assert(std::is_trivially_copyable_v<TState>, "SharedMemoryStateStore requires a trivially copyable state");
+
+ public:
+  using UpdateName = TUpdateName;
+  using SubscriptionFn = TSubscriptionFn;
+
+  // Constructor: Creates the segment with the given name (e.g. "/my_component") and initializes it with the initial
+  // state. An optional subscription callback is called in the writer process on every update.
+  explicit SharedMemoryStateStore(std::string segmentName, SubscriptionFn subscriptionFn = SubscriptionFn{},
+                                  TState initialState = TState{});
+
+  // Constructor: Creates the segment with the given name and initializes it with the initial state.
+  SharedMemoryStateStore(std::string segmentName, TState initialState);
+
+  // Applies an update function to the state with optional arguments, and returns any additional output.
+  template <typename TStateUpdateFn, typename... TArgs>
+  auto apply(const UpdateName& updateName, const TStateUpdateFn& updateFn, TArgs&&... args);
+
+  // Applies an update function to the state and passes its result to a transformation function, returning the
+  // transformed output.
+  template <typename TStateUpdateFn, typename TTransformFn, typename... TArgs>
+  auto applyAndTransform(const UpdateName& updateName, const TStateUpdateFn& updateFn, const TTransformFn& transformFn,
+                         TArgs&&... args);
+
+  // Returns a callable that, when invoked, applies the update function to the state using the specified update name.
+  template <typename TStateUpdateFn>
+  [[nodiscard]] auto bind(UpdateName updateName, TStateUpdateFn&& updateFn);
+
+  // Returns a callable that, when invoked, applies the update function and then the transform function to the result,
+  // using the specified update name.
+  template <typename TStateUpdateFn, typename TTransformFn>
+  [[nodiscard]] auto bind(UpdateName updateName, TStateUpdateFn&& updateFn, TTransformFn&& transformFn);
+
+  // Returns the current state value.
+  [[nodiscard]] TState get_state() const;
+
+ private:
+  using Segment = details::SharedMemoryStateSegment<TState>;
+
+  // Applies an update function to the state, publishes the new state, notifies the subscription (if present), and
+  // forwards the update result.
+  template <typename TStateUpdateFn, typename... TArgs>
+  auto applyForwardingUpdateResult(const UpdateName& updateName, const TStateUpdateFn& updateFn, TArgs&&... args);
+
+  details::SharedMemoryMapping mapping_;
+  Segment* segment_;
+  SubscriptionFn subscriptionFn_;
+  std::mutex updateMutex_;
+  TState writerState_;
+};
+
+// SharedMemoryStateReader provides read access to the state of a SharedMemoryStateStore living in another process (or
+// in the same one). The segment is mapped read-only and reading the state involves no system call.
+//
+// A read retries while the store publishes an update. Should the writer process die in the middle of publishing, the
+// segment is abandoned and no consistent state can be read anymore: try_get_state returns nothing then, while get_state
+// gives up after the stall timeout and throws std::system_error (std::errc::timed_out).
+template <typename TState>
+class SharedMemoryStateReader {
+  static_assert(std::is_trivially_copyable_v<TState>, "SharedMemoryStateReader requires a trivially copyable state");
+
+ public:
+  // Constructor: Maps the segment with the given name. Throws std::system_error if it does not exist (yet) or was not
+  // created by a SharedMemoryStateStore of the same state type. Reads fail once the store publishes an update for
+  // longer than the stall timeout.
+  explicit SharedMemoryStateReader(std::string segmentName,
+                                   std::chrono::milliseconds stallTimeout = std::chrono::seconds{1});
+
+  // Returns a consistent snapshot of the current state, waiting while the store publishes an update.
+  [[nodiscard]] TState get_state() const;
+
+  // Returns a consistent snapshot of the current state, or nothing if the store is publishing an update right now.
+  [[nodiscard]] std::optional<TState> try_get_state() const;
+
+  // Returns the number of updates published by the store so far.
+  [[nodiscard]] std::uint64_t version() const;
+
+ private:
+  using Segment = details::SharedMemoryStateSegment<TState>;
+
+  details::SharedMemoryMapping mapping_;
+  const Segment* segment_;
+  std::chrono::milliseconds stallTimeout_;
+};
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+SharedMemoryStateStore<TState, TUpdateName, TSubscriptionFn>::SharedMemoryStateStore(std::string segmentName,
+                                                                                     SubscriptionFn subscriptionFn,
+                                                                                     TState initialState)
+    : mapping_{details::SharedMemoryMapping::create(std::move(segmentName), sizeof(Segment))},
+      segment_{new (mapping_.address()) Segment{initialState}},
+      subscriptionFn_{std::move(subscriptionFn)},
+      writerState_{initialState} {}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+SharedMemoryStateStore<TState, TUpdateName, TSubscriptionFn>::SharedMemoryStateStore(std::string segmentName,
+                                                                                     TState initialState)
+    : SharedMemoryStateStore{std::move(segmentName), SubscriptionFn{}, initialState} {}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+template <typename TStateUpdateFn, typename... TArgs>
+auto SharedMemoryStateStore<TState, TUpdateName, TSubscriptionFn>::apply(const UpdateName& updateName,
+                                                                         const TStateUpdateFn& updateFn,
+                                                                         TArgs&&... args) {
+  namespace fpd = ::funkypipes::details;
+
+  auto updateResult = applyForwardingUpdateResult(updateName, updateFn, std::forward<decltype(args)>(args)...);
+
+  return fpd::outputsOf(std::move(updateResult));
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+template <typename TStateUpdateFn, typename TTransformFn, typename... TArgs>
+auto SharedMemoryStateStore<TState, TUpdateName, TSubscriptionFn>::applyAndTransform(const UpdateName& updateName,
+                                                                                     const TStateUpdateFn& updateFn,
+                                                                                     const TTransformFn& transformFn,
+                                                                                     TArgs&&... args) {
+  namespace fpd = ::funkypipes::details;
+
+  auto updateResult = applyForwardingUpdateResult(updateName, updateFn, std::forward<decltype(args)>(args)...);
+  auto tupleAwareTransformFn = fpd::makeTupleUnpacking(transformFn);
+  return tupleAwareTransformFn(std::move(updateResult));
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+template <typename TStateUpdateFn>
+[[nodiscard]] auto SharedMemoryStateStore<TState, TUpdateName, TSubscriptionFn>::bind(UpdateName updateName,
+                                                                                      TStateUpdateFn&& updateFn) {
+  return [this, updateName_ = std::move(updateName), updateFn_ = std::forward<decltype(updateFn)>(updateFn)](
+             auto&&... args) { return this->apply(updateName_, updateFn_, std::forward<decltype(args)>(args)...); };
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+template <typename TStateUpdateFn, typename TTransformFn>
+[[nodiscard]] auto SharedMemoryStateStore<TState, TUpdateName, TSubscriptionFn>::bind(UpdateName updateName,
+                                                                                      TStateUpdateFn&& updateFn,
+                                                                                      TTransformFn&& transformFn) {
+  return [this, updateName_ = std::move(updateName), updateFn_ = std::forward<decltype(updateFn)>(updateFn),
+          transformFn_ = std::forward<decltype(transformFn)>(transformFn)](auto&&... args) {
+    return this->applyAndTransform(updateName_, updateFn_, transformFn_, std::forward<decltype(args)>(args)...);
+  };
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+[[nodiscard]] TState SharedMemoryStateStore<TState, TUpdateName, TSubscriptionFn>::get_state() const {
+  return segment_->state.load();
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn>
+template <typename TStateUpdateFn, typename... TArgs>
+auto SharedMemoryStateStore<TState, TUpdateName, TSubscriptionFn>::applyForwardingUpdateResult(
+    const UpdateName& updateName, const TStateUpdateFn& updateFn, TArgs&&... args) {
+  namespace fpd = ::funkypipes::details;
+
+  std::lock_guard<std::mutex> lock{updateMutex_};
+
+  const auto lastState = writerState_;
+
+  auto updateResult = updateFn(writerState_, std::forward<TArgs>(args)...);
+
+  if (!fpd::isStoredUpdate(subscriptionFn_, writerState_, fpd::newStateOf(updateResult))) {
+    return updateResult;
+  }
+
+  writerState_ = fpd::newStateOf(updateResult);
+  segment_->state.store(writerState_);
+
+  if (fpd::hasSubscription(subscriptionFn_)) {
+    fpd::notifyStoredUpdate(subscriptionFn_, updateName, lastState, writerState_);
+  }
+
+  return updateResult;
+}
+
+template <typename TState>
+SharedMemoryStateReader<TState>::SharedMemoryStateReader(std::string segmentName,
+                                                         std::chrono::milliseconds stallTimeout)
+    : mapping_{details::SharedMemoryMapping::openReadOnly(std::move(segmentName), sizeof(Segment))},
+      segment_{static_cast<const Segment*>(mapping_.address())},
+      stallTimeout_{stallTimeout} {
+  if (!segment_->isValid()) {
+    throw std::system_error(std::make_error_code(std::errc::invalid_argument), "invalid shared memory state segment");
+  }
+}
+
+template <typename TState>
+[[nodiscard]] TState SharedMemoryStateReader<TState>::get_state() const {
+  if (auto state = segment_->state.tryLoad()) {
+    return *state;
+  }
+  const auto deadline = std::chrono::steady_clock::now() + stallTimeout_;
+  for (;;) {
+    std::this_thread::yield();
+    if (auto state = segment_->state.tryLoad()) {
+      return *state;
+    }
+    if (std::chrono::steady_clock::now() >= deadline) {
+      throw std::system_error(std::make_error_code(std::errc::timed_out), "shared memory state writer stalled");
+    }
+  }
+}
+
+template <typename TState>
+[[nodiscard]] std::optional<TState> SharedMemoryStateReader<TState>::try_get_state() const {
+  return segment_->state.tryLoad();
+}
+
+template <typename TState>
+[[nodiscard]] std::uint64_t SharedMemoryStateReader<TState>::version() const {
+  return segment_->state.version();
+}
+
+}  // namespace funkypipes
+
+#endif  // FUNKYPIPES_SHARED_MEMORY_STATE_STORE_HPP
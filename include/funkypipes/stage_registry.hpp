@@ -0,0 +1,196 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_STAGE_REGISTRY_HPP
+#define FUNKYPIPES_STAGE_REGISTRY_HPP
+
+#include <functional>
+#include <initializer_list>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "funkypipes/details/dynamic_stage.hpp"
+
+namespace funkypipes {
+
+// The parameters of a stage as given by configuration, i.e. named strings which are parsed on access.
+class StageParameters {
+ public:
+  StageParameters() = default;
+  StageParameters(std::initializer_list<std::pair<const std::string, std::string>> values) : values_{values} {}
+
+  void set(const std::string& name, std::string value) { values_[name] = std::move(value); }
+
+  [[nodiscard]] bool contains(const std::string& name) const { return values_.count(name) != 0; }
+
+  // Returns the parameter of the given name parsed as T, throws std::invalid_argument if it is missing or cannot be
+  // parsed.
+  template <typename T>
+  [[nodiscard]] T get(const std::string& name) const;
+
+  // Returns the parameter of the given name parsed as T or the given default value if it is missing.
+  template <typename T>
+  [[nodiscard]] T get(const std::string& name, T defaultValue) const {
+    return contains(name) ? get<T>(name) : std::move(defaultValue);
+  }
+
+ private:
+  std::map<std::string, std::string> values_;
+};
+
+// The configuration of a single stage of a dynamic pipe: the name of the stage in the registry and its parameters.
+struct StageConfig {
+  std::string name;
+  StageParameters parameters;
+};
+
+// DynamicPipe is a pipe composed at runtime by a StageRegistry. Its stages are fused into a single sequence, so that a
+// call costs one indirect call per stage. As any stage may break the chain, the result is always a std::optional.
+//
+// Like a pipe, a dynamic pipe must not be invoked concurrently unless its stages allow it.
+template <typename TIn, typename TOut>
+class DynamicPipe {
+ public:
+  explicit DynamicPipe(std::vector<details::DynamicStage> stages) : stages_{std::move(stages)} {}
+
+  // Invokes the stages one after the other, returns the output of the last one or std::nullopt if the chain broke.
+  std::optional<TOut> operator()(TIn input) {
+    std::optional<TOut> output;
+    const details::DynamicStage* firstStage = stages_.data();
+    firstStage->invoke(firstStage, &input, &output);
+    return output;
+  }
+
+  // Returns the number of stages.
+  [[nodiscard]] std::size_t size() const { return stages_.size() - 1; }
+
+ private:
+  // Note: ends with the sink storing the output
+  std::vector<details::DynamicStage> stages_;
+};
+
+// StageRegistry is a collection of named stage factories, which builds dynamic pipes from configuration at runtime
+// (e.g. read at startup) without recompilation. Each stage declares its input and output types on registration, which
+// are checked for adjacent stages when building a pipe.
+//
+// A stage factory creates the stage's function from the stage's parameters. The function takes the declared input,
+// tuples are unpacked for functions taking their elements, and returns the declared output. Like with makeAutoPipe, it
+// may return the output wrapped in a std::optional to be able to break the chain.
+//
+// Example usage:
+//   StageRegistry registry;
+//   registry.add<int, int>("clamp", [](const StageParameters& parameters) {
+//     return [max = parameters.get<int>("max")](int value) { return std::min(value, max); };
+//   });
+//   registry.add<int, std::string>("toString", [](const StageParameters&) { return [](int v) { return ...; }; });
+//   auto pipe = registry.build<int, std::string>({{"clamp", {{"max", "10"}}}, {"toString", {}}});
+//   std::optional<std::string> result = pipe(42);  // "10"
+class StageRegistry {
+ public:
+  // Registers a stage factory under the given name, throws std::invalid_argument if the name is registered already.
+  template <typename TIn, typename TOut, typename TFactory>
+  void add(const std::string& name, TFactory factory);
+
+  [[nodiscard]] bool contains(const std::string& name) const { return entries_.count(name) != 0; }
+
+  // Builds a dynamic pipe from the given stage configurations, which are created by their factories in order. Throws
+  // std::invalid_argument if a stage is not registered or if the types of adjacent stages or of the pipe's ends do not
+  // match.
+  template <typename TIn, typename TOut>
+  [[nodiscard]] DynamicPipe<TIn, TOut> build(const std::vector<StageConfig>& configs) const;
+
+ private:
+  struct Entry {
+    std::type_index inputType;
+    std::type_index outputType;
+    std::function<details::DynamicStage(const StageParameters&)> makeStage;
+  };
+
+  static void checkType(std::type_index expected, std::type_index actual, const std::string& where);
+
+  std::unordered_map<std::string, Entry> entries_;
+};
+
+template <typename T>
+[[nodiscard]] T StageParameters::get(const std::string& name) const {
+  const auto valueIt = values_.find(name);
+  if (valueIt == values_.end()) {
+    throw std::invalid_argument("StageParameters: missing parameter " + name);
+  }
+  if constexpr (std::is_same_v<T, std::string>) {
+    return valueIt->second;
+  } else {
+    std::istringstream stream{valueIt->second};
+    T value{};
+    stream >> std::boolalpha >> value;
+    if (stream.fail() || !(stream >> std::ws).eof()) {
+      throw std::invalid_argument("StageParameters: invalid value of parameter " + name);
+    }
+    return value;
+  }
+}
+
+template <typename TIn, typename TOut, typename TFactory>
+void StageRegistry::add(const std::string& name, TFactory factory) {
+  using Fn = std::decay_t<std::invoke_result_t<const TFactory&, const StageParameters&>>;
+  static_assert(details::isDynamicStageFn<TIn, TOut, Fn>(),
+                "A stage must be invocable with its input type and return its output type or an optional of it.");
+
+  auto makeStage = [factory = std::move(factory)](const StageParameters& parameters) {
+    return details::makeDynamicStage<TIn, TOut>(factory(parameters));
+  };
+  const bool isAdded =
+      entries_.try_emplace(name, Entry{typeid(TIn), typeid(TOut), std::move(makeStage)}).second;
+  if (!isAdded) {
+    throw std::invalid_argument("StageRegistry: stage " + name + " registered twice");
+  }
+}
+
+template <typename TIn, typename TOut>
+[[nodiscard]] DynamicPipe<TIn, TOut> StageRegistry::build(const std::vector<StageConfig>& configs) const {
+  std::vector<details::DynamicStage> stages;
+  stages.reserve(configs.size() + 1);
+
+  std::type_index previousOutputType = typeid(TIn);
+  std::string previousStage = "the pipe's input";
+  for (const StageConfig& config : configs) {
+    const auto entryIt = entries_.find(config.name);
+    if (entryIt == entries_.end()) {
+      throw std::invalid_argument("StageRegistry: unknown stage " + config.name);
+    }
+    const Entry& entry = entryIt->second;
+    checkType(previousOutputType, entry.inputType, previousStage + " to stage " + config.name);
+    stages.push_back(entry.makeStage(config.parameters));
+    previousOutputType = entry.outputType;
+    previousStage = "stage " + config.name;
+  }
+  checkType(previousOutputType, typeid(TOut), previousStage + " to the pipe's output");
+  stages.push_back(details::makeDynamicSink<TOut>());
+
+  return DynamicPipe<TIn, TOut>{std::move(stages)};
+}
+
+inline void StageRegistry::checkType(std::type_index expected, std::type_index actual, const std::string& where) {
+  if (expected != actual) {
+    throw std::invalid_argument("StageRegistry: type mismatch from " + where + ", " + expected.name() +
+                                " is passed to " + actual.name());
+  }
+}
+
+}  // namespace funkypipes
+
+#endif  // FUNKYPIPES_STAGE_REGISTRY_HPP
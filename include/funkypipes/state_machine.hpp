@@ -0,0 +1,290 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_STATE_MACHINE_HPP
+#define FUNKYPIPES_STATE_MACHINE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "funkypipes/state_store.hpp"
+
+namespace funkypipes {
+
+// A transition of a state machine: the handler is applied when the event occurs in the state kFrom.
+template <auto kFrom, auto kEvent, typename THandler>
+struct Transition {
+  using StateId = decltype(kFrom);
+  using Event = decltype(kEvent);
+
+  static constexpr StateId kFromState = kFrom;
+  static constexpr Event kOnEvent = kEvent;
+
+  THandler handler;
+};
+
+// Returns a transition applying the given handler when the event kEvent occurs in the state kFrom, see StateMachine.
+template <auto kFrom, auto kEvent, typename THandler>
+auto transition(THandler handler) {
+  static_assert(std::is_enum_v<decltype(kFrom)> && std::is_enum_v<decltype(kEvent)>,
+                "States and events of transitions need to be enumerators");
+  return Transition<kFrom, kEvent, THandler>{std::move(handler)};
+}
+
+namespace details {
+
+// Marks a slot of a transition table without transition.
+inline constexpr std::size_t kNoTransition = std::numeric_limits<std::size_t>::max();
+
+template <typename TEnum>
+constexpr std::size_t enumIndexOf(TEnum value) {
+  return static_cast<std::size_t>(static_cast<std::underlying_type_t<TEnum>>(value));
+}
+
+// Returns the index of the transition of each slot, given the slot of each transition.
+template <std::size_t SlotCount, std::size_t TransitionCount>
+constexpr std::array<std::size_t, SlotCount> transitionOfSlots(
+    const std::array<std::size_t, TransitionCount>& slotOfTransition) {
+  std::array<std::size_t, SlotCount> transitionOfSlot{};
+  for (auto& transition : transitionOfSlot) {
+    transition = kNoTransition;
+  }
+  for (std::size_t transition = 0; transition < TransitionCount; ++transition) {
+    transitionOfSlot[slotOfTransition[transition]] = transition;
+  }
+  return transitionOfSlot;
+}
+
+template <std::size_t TransitionCount>
+constexpr bool areUnique(const std::array<std::size_t, TransitionCount>& slotOfTransition) {
+  for (std::size_t first = 0; first < TransitionCount; ++first) {
+    for (std::size_t second = first + 1; second < TransitionCount; ++second) {
+      if (slotOfTransition[first] == slotOfTransition[second]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace details
+
+// The transitions of a state machine, arranged at compile time into a dense table with a slot for each pair of state
+// and event (indexed by their underlying values), which holds the index of the pair's transition or kNoTransition.
+template <typename... TTransitions>
+class TransitionTable {
+  static_assert(sizeof...(TTransitions) > 0, "A transition table needs at least one transition");
+
+ public:
+  using StateId = typename std::tuple_element_t<0, std::tuple<TTransitions...>>::StateId;
+  using Event = typename std::tuple_element_t<0, std::tuple<TTransitions...>>::Event;
+
+  static_assert((std::is_same_v<typename TTransitions::StateId, StateId> && ...),
+                "All transitions need to have the same state type");
+  static_assert((std::is_same_v<typename TTransitions::Event, Event> && ...),
+                "All transitions need to have the same event type");
+
+  static constexpr std::size_t kNoTransition = details::kNoTransition;
+  static constexpr std::size_t kStateCount = std::max({details::enumIndexOf(TTransitions::kFromState)...}) + 1;
+  static constexpr std::size_t kEventCount = std::max({details::enumIndexOf(TTransitions::kOnEvent)...}) + 1;
+  static constexpr std::size_t kSlotCount = kStateCount * kEventCount;
+
+  // The slot of each transition.
+  static constexpr std::array<std::size_t, sizeof...(TTransitions)> kSlotOfTransition{
+      (details::enumIndexOf(TTransitions::kFromState) * kEventCount + details::enumIndexOf(TTransitions::kOnEvent))...};
+  static_assert(details::areUnique(kSlotOfTransition), "Each pair of state and event may have one transition only");
+
+  // The index of the transition of each slot, or kNoTransition.
+  static constexpr std::array<std::size_t, kSlotCount> kTransitionOfSlot =
+      details::transitionOfSlots<kSlotCount>(kSlotOfTransition);
+
+  explicit TransitionTable(TTransitions... transitions) : transitions_{std::move(transitions)...} {}
+
+  // Returns the slot of the given state and event, or kSlotCount if there is no transition for either.
+  [[nodiscard]] static constexpr std::size_t slotOf(StateId stateId, Event event) {
+    const std::size_t stateIndex = details::enumIndexOf(stateId);
+    const std::size_t eventIndex = details::enumIndexOf(event);
+    if (stateIndex >= kStateCount || eventIndex >= kEventCount) {
+      return kSlotCount;
+    }
+    return stateIndex * kEventCount + eventIndex;
+  }
+
+  // Returns the handler of the transition with the given index.
+  template <std::size_t Index>
+  [[nodiscard]] const auto& handler() const {
+    return std::get<Index>(transitions_).handler;
+  }
+
+ private:
+  std::tuple<TTransitions...> transitions_;
+};
+
+// Returns a table of the given transitions, see StateMachine.
+template <typename... TTransitions>
+auto makeTransitionTable(TTransitions... transitions) {
+  return TransitionTable<TTransitions...>{std::move(transitions)...};
+}
+
+// StateMachine is a StateStore whose updates are the transitions of a state machine. The state is a struct holding
+// the current state as enumerator (given by a pointer to that member) plus any further fields, the transitions are
+// declared as (state, event) -> handler in a TransitionTable. A handler is a state update function returning the new
+// state, including the new enumerator:
+//   TState handler(TState state, Args... args);
+//
+// Dispatching an event looks up the handler in a jump table built at compile time, which holds a function pointer for
+// each pair of state and event, so the cost does not depend on the number of transitions. All handlers are invoked
+// with the arguments given to dispatch, so they need to accept the same arguments. Events without a transition in the
+// current state are ignored.
+//
+// The subscription works like that of StateStore (see there) with the event as update name, the number of times each
+// transition was taken is counted.
+//
+// Example usage:
+//   const auto doorTransitions = makeTransitionTable(transition<DoorState::kClosed, DoorEvent::kOpen>(openFn),
+//                                                    transition<DoorState::kOpen, DoorEvent::kClose>(closeFn));
+//   auto door = makeStateMachine(Door{}, &Door::state, doorTransitions);
+//   door.dispatch(DoorEvent::kOpen);
+template <typename TState, typename TTransitionTable,
+          typename TSubscriptionFn = std::function<void(const typename TTransitionTable::Event&, const TState&,
+                                                        const TState&)>>
+class StateMachine {
+ public:
+  using StateId = typename TTransitionTable::StateId;
+  using Event = typename TTransitionTable::Event;
+  using SubscriptionFn = TSubscriptionFn;
+
+  // Constructor: Initializes the machine with the initial state, the pointer to the state's enumerator member, the
+  // transitions and an optional subscription callback.
+  StateMachine(TState initialState, StateId TState::*stateId, TTransitionTable transitions,
+               SubscriptionFn subscriptionFn = SubscriptionFn{});
+
+  // Applies the handler of the transition for the given event in the current state with optional arguments. Returns
+  // whether there is such a transition.
+  template <typename... TArgs>
+  bool dispatch(const Event& event, TArgs&&... args);
+
+  // Returns a callable that, when invoked with optional arguments, dispatches the given event.
+  [[nodiscard]] auto bind(Event event);
+
+  // Returns the current state value.
+  [[nodiscard]] TState get_state() const { return store_.get_state(); }
+
+  // Returns the current state's enumerator.
+  [[nodiscard]] StateId stateId() const { return currentStateId_; }
+
+  // Returns how often the transition for the given event in the given state was taken.
+  [[nodiscard]] std::uint64_t transitionCount(StateId from, Event event) const;
+
+  // Returns how often an event was dispatched without a transition in the current state.
+  [[nodiscard]] std::uint64_t unhandledCount() const { return unhandledCount_; }
+
+ private:
+  template <typename... TArgs>
+  using TransitionFn = TState (*)(const TTransitionTable&, const TState&, TArgs&&...);
+
+  template <std::size_t Index, typename... TArgs>
+  static TState invokeTransition(const TTransitionTable& transitions, const TState& state, TArgs&&... args) {
+    return transitions.template handler<Index>()(state, std::forward<TArgs>(args)...);
+  }
+
+  template <std::size_t Slot, typename... TArgs>
+  static constexpr TransitionFn<TArgs...> transitionFnOfSlot() {
+    constexpr std::size_t kTransition = TTransitionTable::kTransitionOfSlot[Slot];
+    if constexpr (kTransition == TTransitionTable::kNoTransition) {
+      return nullptr;
+    } else {
+      return &invokeTransition<kTransition, TArgs...>;
+    }
+  }
+
+  template <typename... TArgs, std::size_t... Slots>
+  static constexpr auto makeJumpTable(std::index_sequence<Slots...> /*slots*/) {
+    return std::array<TransitionFn<TArgs...>, TTransitionTable::kSlotCount>{transitionFnOfSlot<Slots, TArgs...>()...};
+  }
+
+  // The handler of each slot, invoked with the given argument types.
+  template <typename... TArgs>
+  static constexpr std::array<TransitionFn<TArgs...>, TTransitionTable::kSlotCount> kJumpTable =
+      makeJumpTable<TArgs...>(std::make_index_sequence<TTransitionTable::kSlotCount>{});
+
+  StateStore<TState, Event, TSubscriptionFn> store_;
+  StateId TState::*stateId_;
+  StateId currentStateId_;
+  TTransitionTable transitions_;
+  std::array<std::uint64_t, TTransitionTable::kSlotCount> transitionCounts_{};
+  std::uint64_t unhandledCount_{0};
+};
+
+// Creates a StateMachine with the given initial state, pointer to the state's enumerator member and transitions, see
+// StateMachine.
+template <typename TState, typename TStateId, typename TTransitionTable>
+auto makeStateMachine(TState initialState, TStateId TState::*stateId, TTransitionTable transitions) {
+  return StateMachine<TState, TTransitionTable>{std::move(initialState), stateId, std::move(transitions)};
+}
+
+// Creates a StateMachine as above with a subscription function whose type is deduced, so that calls to it can be
+// inlined.
+template <typename TState, typename TStateId, typename TTransitionTable, typename TSubscriptionFn>
+auto makeStateMachine(TState initialState, TStateId TState::*stateId, TTransitionTable transitions,
+                      TSubscriptionFn subscriptionFn) {
+  return StateMachine<TState, TTransitionTable, TSubscriptionFn>{std::move(initialState), stateId,
+                                                                 std::move(transitions), std::move(subscriptionFn)};
+}
+
+template <typename TState, typename TTransitionTable, typename TSubscriptionFn>
+StateMachine<TState, TTransitionTable, TSubscriptionFn>::StateMachine(TState initialState, StateId TState::*stateId,
+                                                                      TTransitionTable transitions,
+                                                                      SubscriptionFn subscriptionFn)
+    : store_{std::move(subscriptionFn), std::move(initialState)},
+      stateId_{stateId},
+      currentStateId_{store_.get_state().*stateId},
+      transitions_{std::move(transitions)} {}
+
+template <typename TState, typename TTransitionTable, typename TSubscriptionFn>
+template <typename... TArgs>
+bool StateMachine<TState, TTransitionTable, TSubscriptionFn>::dispatch(const Event& event, TArgs&&... args) {
+  const std::size_t slot = TTransitionTable::slotOf(currentStateId_, event);
+  const TransitionFn<TArgs...> transitionFn =
+      slot < TTransitionTable::kSlotCount ? kJumpTable<TArgs...>[slot] : nullptr;
+  if (transitionFn == nullptr) {
+    ++unhandledCount_;
+    return false;
+  }
+
+  store_.apply(event, [&](const TState& state) {
+    TState newState = transitionFn(transitions_, state, std::forward<TArgs>(args)...);
+    currentStateId_ = newState.*stateId_;
+    return newState;
+  });
+  ++transitionCounts_[slot];
+  return true;
+}
+
+template <typename TState, typename TTransitionTable, typename TSubscriptionFn>
+[[nodiscard]] auto StateMachine<TState, TTransitionTable, TSubscriptionFn>::bind(Event event) {
+  return [this, event](auto&&... args) { return this->dispatch(event, std::forward<decltype(args)>(args)...); };
+}
+
+template <typename TState, typename TTransitionTable, typename TSubscriptionFn>
+[[nodiscard]] std::uint64_t StateMachine<TState, TTransitionTable, TSubscriptionFn>::transitionCount(
+    StateId from, Event event) const {
+  const std::size_t slot = TTransitionTable::slotOf(from, event);
+  return slot < TTransitionTable::kSlotCount ? transitionCounts_[slot] : 0;
+}
+
+}  // namespace funkypipes
+
+#endif  // FUNKYPIPES_STATE_MACHINE_HPP
@@ -8,13 +8,18 @@
 #ifndef FUNKYPIPES_STATE_STORE_HPP
 #define FUNKYPIPES_STATE_STORE_HPP
 
+#include <cstdint>
 #include <functional>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
+#include "funkypipes/derived.hpp"
 #include "funkypipes/details/make_tuple_unpacking.hpp"
-#include "funkypipes/details/tuple/separate_tuple_elements.hpp"
-#include "funkypipes/details/tuple/try_flatten_tuple.hpp"
-#include "funkypipes/details/tuple/tuple_traits.hpp"
+#include "funkypipes/details/state_update_result.hpp"
+#include "funkypipes/details/subscription.hpp"
+#include "funkypipes/state_store_metrics.hpp"
 
 namespace funkypipes {
 
@@ -27,6 +32,19 @@ namespace funkypipes {
 // bound to the store instance, allowing you to perform state updates on that particular store simply by calling the
 // resulting function.
 //
+// Several updates can be combined into a single state transition using transaction. They are applied to a working copy
+// of the state which is committed at the end, so the subscription is notified once and an update throwing an exception
+// leaves the store untouched.
+//
+// Updates that do not change the state can be ignored using an OnChangeSubscription (see on_change_subscription.hpp) as
+// subscription function: they are then neither stored nor notified, and do not change the store's version.
+//
+// Update functions concerning a single part of a nested state can be applied to that part only using applyAt (and
+// bindAt), given a lens focusing on it (see lens.hpp). This saves rebuilding the whole state for changing a leaf.
+//
+// Values computed from the state can be memoized using derive, which recomputes them only when read after the state
+// changed (see derived.hpp).
+//
 // Expected Signatures:
 //
 // TStateUpdateFn:
@@ -48,11 +66,53 @@ namespace funkypipes {
 //   - Example signature:
 //       void subscriptionFn(const std::string& updateName, const TState& oldState, const TState& newState);
 //
-template <typename TState>
-class StateStore {
+// TUpdateName:
+//   - The type identifying updates, std::string by default. Any copyable type works, e.g. an enum or UpdateId (see
+//     update_id.hpp) which keep the update path free of string allocations and copies.
+//
+// TSubscriptionFn:
+//   - The type of the subscription function, std::function by default. Using the callable's own type (see
+//     makeStateStore) avoids the indirect call and allows the subscription to be inlined into the update path.
+//   - Transactions notify subscription functions that are invocable with a list of update names that way, others are
+//     notified with the transaction's name:
+//       void subscriptionFn(const std::vector<UpdateName>& names, const TState& oldState, const TState& newState);
+//
+// TMetrics:
+//   - The metrics policy, NoMetrics by default, which adds no code to the update path. With CollectMetrics, the store
+//     counts the calls of each update name and measures the latencies of the update functions and the subscription,
+//     available via metrics (see state_store_metrics.hpp).
+//
+template <typename TState, typename TUpdateName = std::string,
+          typename TSubscriptionFn = std::function<void(const TUpdateName&, const TState&, const TState&)>,
+          typename TMetrics = NoMetrics>
+class StateStore : private details::MetricsRecorder<TMetrics, TUpdateName> {
  public:
-  using UpdateName = std::string;
-  using SubscriptionFn = std::function<void(UpdateName, const TState&, const TState&)>;
+  using UpdateName = TUpdateName;
+  using SubscriptionFn = TSubscriptionFn;
+
+  // Collects updates applied within StateStore::transaction, see there.
+  class Transaction {
+   public:
+    // Applies an update function to the transaction's working state with optional arguments, and returns any
+    // additional output.
+    template <typename TStateUpdateFn, typename... TArgs>
+    auto apply(const UpdateName& updateName, const TStateUpdateFn& updateFn, TArgs&&... args);
+
+    // Returns the working state including the updates applied so far.
+    [[nodiscard]] const TState& state() const { return workingState_; }
+
+    // Returns the names of the updates applied so far.
+    [[nodiscard]] const std::vector<UpdateName>& updateNames() const { return updateNames_; }
+
+   private:
+    friend class StateStore;
+    explicit Transaction(TState workingState) : workingState_{std::move(workingState)} {}
+
+    TState workingState_;
+    std::vector<UpdateName> updateNames_;
+    // Note: set once an update threw, as the working state may have been consumed by that update
+    bool isFailed_{false};
+  };
 
   // Constructor: Initializes the store with an optional subscription callback and initial state.
   explicit StateStore(SubscriptionFn subscriptionFn = SubscriptionFn{}, TState initialState = TState{});
@@ -79,44 +139,106 @@ class StateStore {
   template <typename TStateUpdateFn, typename TTransformFn>
   [[nodiscard]] auto bind(UpdateName updateName, TStateUpdateFn&& updateFn, TTransformFn&& transformFn);
 
+  // Applies an update function to the part of the state focused by the lens (see lens.hpp) with optional arguments,
+  // and returns any additional output. The update function accepts and returns the focused part instead of the whole
+  // state, which is then modified along the lens' path only. The previous state is copied for the subscription only.
+  template <typename TLens, typename TPartUpdateFn, typename... TArgs>
+  auto applyAt(const UpdateName& updateName, const TLens& lens, const TPartUpdateFn& updateFn, TArgs&&... args);
+
+  // Returns a callable that, when invoked, applies the update function to the part of the state focused by the lens
+  // using the specified update name.
+  template <typename TLens, typename TPartUpdateFn>
+  [[nodiscard]] auto bindAt(UpdateName updateName, TLens lens, TPartUpdateFn&& updateFn);
+
+  // Calls the given function with a Transaction, whose apply works like StateStore::apply but on a working copy of the
+  // state. Afterwards the working state becomes the store's state in a single transition and the subscription is
+  // notified once, either with the list of applied update names or with the given transaction name (see
+  // TSubscriptionFn). If the function throws, or any of its updates throws even if the function catches the exception,
+  // the store remains unchanged. Returns the function's result.
+  template <typename TTransactionFn>
+  auto transaction(const UpdateName& transactionName, TTransactionFn&& transactionFn);
+
   // Returns the current state value.
   [[nodiscard]] TState get_state() const;
 
+  // Returns the number of state transitions so far.
+  [[nodiscard]] std::uint64_t version() const { return version_; }
+
+  // Returns a memoized value computed from the state by the given function, which is recomputed only when read after
+  // the state changed (see Derived). The derived value refers to the store, so it must not outlive it.
+  template <typename TComputeFn>
+  [[nodiscard]] auto derive(TComputeFn&& computeFn) const;
+
+  // Returns the metrics collected so far along with the current state's size. Requires the CollectMetrics policy.
+  [[nodiscard]] StateStoreMetrics<UpdateName> metrics() const {
+    static_assert(std::is_same_v<TMetrics, CollectMetrics>, "metrics requires the CollectMetrics policy");
+    return metricsRecorder().snapshot(currentState_);
+  }
+
  private:
+  // Note: the metrics recorder is a private base rather than a member, so the empty one of NoMetrics takes no space
+  using MetricsRecorder = details::MetricsRecorder<TMetrics, UpdateName>;
+
+  MetricsRecorder& metricsRecorder() { return *this; }
+  const MetricsRecorder& metricsRecorder() const { return *this; }
+
+  // Input of derived values referring to the store's state.
+  struct StateInput {
+    const StateStore* store;
+
+    [[nodiscard]] std::uint64_t version() const { return store->version_; }
+    [[nodiscard]] const TState& value() const { return store->currentState_; }
+  };
+
   // Applies an update function to the state, updates the state, notifies the subscription (if present), and forwards
   // the update result.
   template <typename TStateUpdateFn, typename... TArgs>
   auto applyForwardingUpdateResult(const UpdateName& updateName, const TStateUpdateFn& updateFn, TArgs&&... args);
 
+  // Calls the subscription function, recording its latency for the given metrics entry.
+  template <typename... TNotificationArgs>
+  void notify(typename MetricsRecorder::Entry metricsEntry, TNotificationArgs&&... notificationArgs);
+
   SubscriptionFn subscriptionFn_;
   TState currentState_;
+  std::uint64_t version_{0};
 };
 
-template <typename TState>
-StateStore<TState>::StateStore(SubscriptionFn subscriptionFn, TState initialState)
+// Creates a StateStore with the given initial state and a subscription function whose type is deduced, so that calls to
+// it can be inlined. The update name type and the metrics policy can be specified explicitly and default to std::string
+// and NoMetrics.
+template <typename TUpdateName = std::string, typename TMetrics = NoMetrics, typename TState, typename TSubscriptionFn>
+auto makeStateStore(TState initialState, TSubscriptionFn subscriptionFn) {
+  return StateStore<TState, TUpdateName, TSubscriptionFn, TMetrics>{std::move(subscriptionFn), std::move(initialState)};
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn, typename TMetrics>
+StateStore<TState, TUpdateName, TSubscriptionFn, TMetrics>::StateStore(SubscriptionFn subscriptionFn,
+                                                                       TState initialState)
     : subscriptionFn_{std::move(subscriptionFn)}, currentState_{std::move(initialState)} {}
 
-template <typename TState>
-StateStore<TState>::StateStore(TState initialState) : subscriptionFn_{}, currentState_{std::move(initialState)} {}
+template <typename TState, typename TUpdateName, typename TSubscriptionFn, typename TMetrics>
+StateStore<TState, TUpdateName, TSubscriptionFn, TMetrics>::StateStore(TState initialState)
+    : subscriptionFn_{}, currentState_{std::move(initialState)} {}
 
-template <typename TState>
+template <typename TState, typename TUpdateName, typename TSubscriptionFn, typename TMetrics>
 template <typename TStateUpdateFn, typename... TArgs>
-auto StateStore<TState>::apply(const UpdateName& updateName, const TStateUpdateFn& updateFn, TArgs&&... args) {
+auto StateStore<TState, TUpdateName, TSubscriptionFn, TMetrics>::apply(const UpdateName& updateName,
+                                                                       const TStateUpdateFn& updateFn,
+                                                                       TArgs&&... args) {
   namespace fpd = ::funkypipes::details;
 
   auto updateResult = applyForwardingUpdateResult(updateName, updateFn, std::forward<decltype(args)>(args)...);
 
-  if constexpr (fpd::IsTuple<decltype(updateResult)>) {
-    auto [_, outputTuple] = fpd::separateTupleElements<0>(std::move(updateResult));
-
-    return fpd::tryFlattenTuple(std::move(outputTuple));
-  }
+  return fpd::outputsOf(std::move(updateResult));
 }
 
-template <typename TState>
+template <typename TState, typename TUpdateName, typename TSubscriptionFn, typename TMetrics>
 template <typename TStateUpdateFn, typename TTransformFn, typename... TArgs>
-auto StateStore<TState>::applyAndTransform(const UpdateName& updateName, const TStateUpdateFn& updateFn,
-                                           const TTransformFn& transformFn, TArgs&&... args) {
+auto StateStore<TState, TUpdateName, TSubscriptionFn, TMetrics>::applyAndTransform(const UpdateName& updateName,
+                                                                                   const TStateUpdateFn& updateFn,
+                                                                                   const TTransformFn& transformFn,
+                                                                                   TArgs&&... args) {
   namespace fpd = ::funkypipes::details;
 
   auto updateResult = applyForwardingUpdateResult(updateName, updateFn, std::forward<decltype(args)>(args)...);
@@ -124,51 +246,183 @@ auto StateStore<TState>::applyAndTransform(const UpdateName& updateName, const T
   return tupleAwareTransformFn(std::move(updateResult));
 }
 
-template <typename TState>
+template <typename TState, typename TUpdateName, typename TSubscriptionFn, typename TMetrics>
 template <typename TStateUpdateFn>
-[[nodiscard]] auto StateStore<TState>::bind(UpdateName updateName, TStateUpdateFn&& updateFn) {
+[[nodiscard]] auto StateStore<TState, TUpdateName, TSubscriptionFn, TMetrics>::bind(UpdateName updateName,
+                                                                                    TStateUpdateFn&& updateFn) {
   return [this, updateName_ = std::move(updateName), updateFn_ = std::forward<decltype(updateFn)>(updateFn)](
              auto&&... args) { return this->apply(updateName_, updateFn_, std::forward<decltype(args)>(args)...); };
 }
 
-template <typename TState>
+template <typename TState, typename TUpdateName, typename TSubscriptionFn, typename TMetrics>
 template <typename TStateUpdateFn, typename TTransformFn>
-[[nodiscard]] auto StateStore<TState>::bind(UpdateName updateName, TStateUpdateFn&& updateFn,
-                                            TTransformFn&& transformFn) {
+[[nodiscard]] auto StateStore<TState, TUpdateName, TSubscriptionFn, TMetrics>::bind(UpdateName updateName,
+                                                                                    TStateUpdateFn&& updateFn,
+                                                                                    TTransformFn&& transformFn) {
   return [this, updateName_ = std::move(updateName), updateFn_ = std::forward<decltype(updateFn)>(updateFn),
           transformFn_ = std::forward<decltype(transformFn)>(transformFn)](auto&&... args) {
     return this->applyAndTransform(updateName_, updateFn_, transformFn_, std::forward<decltype(args)>(args)...);
   };
 }
 
-template <typename TState>
-[[nodiscard]] TState StateStore<TState>::get_state() const {
+template <typename TState, typename TUpdateName, typename TSubscriptionFn, typename TMetrics>
+template <typename TLens, typename TPartUpdateFn, typename... TArgs>
+auto StateStore<TState, TUpdateName, TSubscriptionFn, TMetrics>::applyAt(const UpdateName& updateName,
+                                                                         const TLens& lens,
+                                                                         const TPartUpdateFn& updateFn,
+                                                                         TArgs&&... args) {
+  namespace fpd = ::funkypipes::details;
+
+  const auto stopwatch = metricsRecorder().startStopwatch();
+
+  auto updateResult = updateFn(lens.get(std::as_const(currentState_)), std::forward<TArgs>(args)...);
+
+  auto assignNewPart = [&updateResult](auto& part) { part = fpd::takeNewStateOf(updateResult); };
+  if (fpd::hasSubscription(subscriptionFn_)) {
+    TState lastState = currentState_;
+    lens.modify(currentState_, assignNewPart);
+    const auto metricsEntry = metricsRecorder().recordUpdate(updateName, stopwatch);
+    if (fpd::isStoredUpdate(subscriptionFn_, std::as_const(lastState), std::as_const(currentState_))) {
+      ++version_;
+      notify(metricsEntry, updateName, std::move(lastState), currentState_);
+    } else {
+      currentState_ = std::move(lastState);  // Note: the part was modified in place, though the update is not stored
+    }
+  } else {
+    lens.modify(currentState_, assignNewPart);
+    ++version_;
+    metricsRecorder().recordUpdate(updateName, stopwatch);
+  }
+
+  return fpd::outputsOf(std::move(updateResult));
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn, typename TMetrics>
+template <typename TLens, typename TPartUpdateFn>
+[[nodiscard]] auto StateStore<TState, TUpdateName, TSubscriptionFn, TMetrics>::bindAt(UpdateName updateName, TLens lens,
+                                                                                      TPartUpdateFn&& updateFn) {
+  return [this, updateName_ = std::move(updateName), lens_ = std::move(lens),
+          updateFn_ = std::forward<decltype(updateFn)>(updateFn)](auto&&... args) {
+    return this->applyAt(updateName_, lens_, updateFn_, std::forward<decltype(args)>(args)...);
+  };
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn, typename TMetrics>
+template <typename TTransactionFn>
+auto StateStore<TState, TUpdateName, TSubscriptionFn, TMetrics>::transaction(const UpdateName& transactionName,
+                                                                             TTransactionFn&& transactionFn) {
+  namespace fpd = ::funkypipes::details;
+
+  const auto stopwatch = metricsRecorder().startStopwatch();
+  Transaction transaction{currentState_};
+
+  // Note: commits the working state once the transaction function returned, but not if it or any update threw
+  auto commit = [&]() {
+    if (transaction.isFailed_) {
+      return;
+    }
+    if (!fpd::isStoredUpdate(subscriptionFn_, std::as_const(currentState_), std::as_const(transaction.workingState_))) {
+      metricsRecorder().recordUpdate(transactionName, stopwatch);
+      return;
+    }
+
+    TState lastState = std::exchange(currentState_, std::move(transaction.workingState_));
+    ++version_;
+    const auto metricsEntry = metricsRecorder().recordUpdate(transactionName, stopwatch);
+
+    if (fpd::hasSubscription(subscriptionFn_)) {
+      using UpdateNames = std::vector<UpdateName>;
+      if constexpr (std::is_invocable_v<SubscriptionFn&, const UpdateNames&, const TState&, const TState&>) {
+        notify(metricsEntry, std::as_const(transaction.updateNames_), std::as_const(lastState),
+               std::as_const(currentState_));
+      } else {
+        notify(metricsEntry, transactionName, std::as_const(lastState), std::as_const(currentState_));
+      }
+    }
+  };
+
+  if constexpr (std::is_void_v<std::invoke_result_t<TTransactionFn, Transaction&>>) {
+    std::forward<TTransactionFn>(transactionFn)(transaction);
+    commit();
+  } else {
+    auto result = std::forward<TTransactionFn>(transactionFn)(transaction);
+    commit();
+    return result;
+  }
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn, typename TMetrics>
+[[nodiscard]] TState StateStore<TState, TUpdateName, TSubscriptionFn, TMetrics>::get_state() const {
   return currentState_;
 }
 
-template <typename TState>
+template <typename TState, typename TUpdateName, typename TSubscriptionFn, typename TMetrics>
+template <typename TComputeFn>
+[[nodiscard]] auto StateStore<TState, TUpdateName, TSubscriptionFn, TMetrics>::derive(TComputeFn&& computeFn) const {
+  return Derived<std::decay_t<TComputeFn>, StateInput>{std::forward<TComputeFn>(computeFn), StateInput{this}};
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn, typename TMetrics>
 template <typename TStateUpdateFn, typename... TArgs>
-auto StateStore<TState>::applyForwardingUpdateResult(const UpdateName& updateName, const TStateUpdateFn& updateFn,
-                                                     TArgs&&... args) {
+auto StateStore<TState, TUpdateName, TSubscriptionFn, TMetrics>::applyForwardingUpdateResult(
+    const UpdateName& updateName, const TStateUpdateFn& updateFn, TArgs&&... args) {
   namespace fpd = ::funkypipes::details;
 
+  const auto stopwatch = metricsRecorder().startStopwatch();
+
   auto lastState = currentState_;
 
   auto updateResult = updateFn(currentState_, std::forward<TArgs>(args)...);
 
-  if constexpr (fpd::IsTuple<decltype(updateResult)>) {
-    currentState_ = std::get<0>(updateResult);
-  } else {
-    currentState_ = updateResult;
+  if (!fpd::isStoredUpdate(subscriptionFn_, std::as_const(currentState_), fpd::newStateOf(updateResult))) {
+    metricsRecorder().recordUpdate(updateName, stopwatch);
+    return updateResult;
   }
 
-  if (subscriptionFn_) {
-    subscriptionFn_(updateName, std::move(lastState), currentState_);
+  currentState_ = fpd::newStateOf(updateResult);
+  ++version_;
+  const auto metricsEntry = metricsRecorder().recordUpdate(updateName, stopwatch);
+
+  if (fpd::hasSubscription(subscriptionFn_)) {
+    notify(metricsEntry, updateName, std::move(lastState), currentState_);
   }
 
   return updateResult;
 }
 
+template <typename TState, typename TUpdateName, typename TSubscriptionFn, typename TMetrics>
+template <typename... TNotificationArgs>
+void StateStore<TState, TUpdateName, TSubscriptionFn, TMetrics>::notify(
+    typename details::MetricsRecorder<TMetrics, UpdateName>::Entry metricsEntry,
+    TNotificationArgs&&... notificationArgs) {
+  namespace fpd = ::funkypipes::details;
+
+  const auto stopwatch = metricsRecorder().startStopwatch();
+  fpd::notifyStoredUpdate(subscriptionFn_, std::forward<TNotificationArgs>(notificationArgs)...);
+  metricsRecorder().recordSubscriber(metricsEntry, stopwatch);
+}
+
+template <typename TState, typename TUpdateName, typename TSubscriptionFn, typename TMetrics>
+template <typename TStateUpdateFn, typename... TArgs>
+auto StateStore<TState, TUpdateName, TSubscriptionFn, TMetrics>::Transaction::apply(const UpdateName& updateName,
+                                                                                    const TStateUpdateFn& updateFn,
+                                                                                    TArgs&&... args) {
+  namespace fpd = ::funkypipes::details;
+
+  // Note: the working state is consumed by the update function, as a throwing update fails the transaction anyway
+  try {
+    auto updateResult = fpd::invokeConsumingState(updateFn, workingState_, std::forward<TArgs>(args)...);
+
+    workingState_ = fpd::takeNewStateOf(updateResult);
+    updateNames_.push_back(updateName);
+
+    return fpd::outputsOf(std::move(updateResult));
+  } catch (...) {
+    isFailed_ = true;
+    throw;
+  }
+}
+
 }  // namespace funkypipes
 
 #endif  // FUNKYPIPES_STATE_STORE_HPP
@@ -0,0 +1,119 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_STATE_STORE_METRICS_HPP
+#define FUNKYPIPES_STATE_STORE_METRICS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace funkypipes {
+
+// Metrics policies of StateStore: NoMetrics (the default) collects nothing and costs nothing, CollectMetrics collects
+// the metrics available via StateStore::metrics.
+struct NoMetrics {};
+struct CollectMetrics {};
+
+// StateSize is the customization point defining the size of a state as reported by StateStore::metrics. By default,
+// this is sizeof the state plus, for containers, the size of their elements. States holding containers (or any other
+// memory) need a specialization of their own for the reported size to include it:
+//
+//   template <>
+//   struct funkypipes::StateSize<MyState> {
+//     static std::size_t of(const MyState& state) { return sizeof(MyState) + state.samples.size() * sizeof(double); }
+//   };
+template <typename T, typename = void>
+struct StateSize {
+  static std::size_t of(const T& /*state*/) { return sizeof(T); }
+};
+
+template <typename T>
+struct StateSize<T, std::void_t<typename T::value_type, decltype(std::declval<const T&>().size())>> {
+  static std::size_t of(const T& state) { return sizeof(T) + state.size() * sizeof(typename T::value_type); }
+};
+
+// The metrics of the updates of a single update name. Transactions count as a single update under their name.
+struct UpdateMetrics {
+  std::uint64_t callCount{0};
+  std::chrono::nanoseconds totalUpdateLatency{0};
+  std::chrono::nanoseconds maxUpdateLatency{0};
+  std::chrono::nanoseconds totalSubscriberLatency{0};
+  std::chrono::nanoseconds maxSubscriberLatency{0};
+};
+
+// The metrics of a StateStore at the time StateStore::metrics was called.
+template <typename TUpdateName>
+struct StateStoreMetrics {
+  std::unordered_map<TUpdateName, UpdateMetrics> updates;
+  std::size_t stateSize{0};
+};
+
+namespace details {
+
+// Records the metrics of a StateStore according to its metrics policy. The update latency covers the update function
+// and storing its result, the subscriber latency covers the call to the subscription function.
+template <typename TMetrics, typename TUpdateName>
+class MetricsRecorder;
+
+template <typename TUpdateName>
+class MetricsRecorder<NoMetrics, TUpdateName> {
+ public:
+  struct Stopwatch {};
+  struct Entry {};
+
+  static constexpr Stopwatch startStopwatch() { return Stopwatch{}; }
+  static constexpr Entry recordUpdate(const TUpdateName& /*updateName*/, Stopwatch /*stopwatch*/) { return Entry{}; }
+  static constexpr void recordSubscriber(Entry /*entry*/, Stopwatch /*stopwatch*/) {}
+};
+
+template <typename TUpdateName>
+class MetricsRecorder<CollectMetrics, TUpdateName> {
+ public:
+  using Stopwatch = std::chrono::steady_clock::time_point;
+  using Entry = UpdateMetrics*;
+
+  static Stopwatch startStopwatch() { return std::chrono::steady_clock::now(); }
+
+  Entry recordUpdate(const TUpdateName& updateName, Stopwatch stopwatch) {
+    const auto latency = elapsedSince(stopwatch);
+    UpdateMetrics& metrics = metricsOfUpdate_[updateName];
+    ++metrics.callCount;
+    metrics.totalUpdateLatency += latency;
+    metrics.maxUpdateLatency = std::max(metrics.maxUpdateLatency, latency);
+    return &metrics;
+  }
+
+  static void recordSubscriber(Entry entry, Stopwatch stopwatch) {
+    const auto latency = elapsedSince(stopwatch);
+    entry->totalSubscriberLatency += latency;
+    entry->maxSubscriberLatency = std::max(entry->maxSubscriberLatency, latency);
+  }
+
+  template <typename TState>
+  [[nodiscard]] StateStoreMetrics<TUpdateName> snapshot(const TState& state) const {
+    return StateStoreMetrics<TUpdateName>{metricsOfUpdate_, StateSize<TState>::of(state)};
+  }
+
+ private:
+  static std::chrono::nanoseconds elapsedSince(Stopwatch stopwatch) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - stopwatch);
+  }
+
+  std::unordered_map<TUpdateName, UpdateMetrics> metricsOfUpdate_;
+};
+
+}  // namespace details
+
+}  // namespace funkypipes
+
+#endif  // FUNKYPIPES_STATE_STORE_METRICS_HPP
@@ -0,0 +1,263 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_SUBSCRIPTION_HUB_HPP
+#define FUNKYPIPES_SUBSCRIPTION_HUB_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "funkypipes/diff.hpp"
+
+namespace funkypipes {
+
+namespace details {
+
+// Checks whether an update name passes a filter. An empty filter passes all update names.
+template <typename TUpdateName>
+bool passesUpdateNameFilter(const std::vector<TUpdateName>& filter, const TUpdateName& updateName) {
+  return filter.empty() || std::find(filter.begin(), filter.end(), updateName) != filter.end();
+}
+
+// Type independent interface of the selectors registered at a SubscriptionHub.
+template <typename TState, typename TUpdateName>
+class HubSelectorBase {
+ public:
+  HubSelectorBase() = default;
+  HubSelectorBase(const HubSelectorBase&) = delete;
+  HubSelectorBase(HubSelectorBase&&) = delete;
+  HubSelectorBase& operator=(const HubSelectorBase&) = delete;
+  HubSelectorBase& operator=(HubSelectorBase&&) = delete;
+  virtual ~HubSelectorBase() = default;
+
+  // Notifies the selector's subscribers about the update with the given index in case their slice changed.
+  virtual void notify(std::uint64_t updateIndex, const TUpdateName& updateName, const TState& oldState,
+                      const TState& newState) = 0;
+};
+
+// A selector projecting the state to a slice of type TSlice, together with the subscribers interested in that slice.
+template <typename TState, typename TUpdateName, typename TSlice>
+class HubSelector : public HubSelectorBase<TState, TUpdateName> {
+ public:
+  using SelectFn = std::function<TSlice(const TState&)>;
+  using SliceSubscriptionFn = std::function<void(const TUpdateName&, const TSlice&, const TSlice&)>;
+
+  explicit HubSelector(SelectFn selectFn) : selectFn_{std::move(selectFn)} {}
+
+  void addSubscriber(SliceSubscriptionFn subscriptionFn, std::vector<TUpdateName> updateNameFilter) {
+    subscribers_.push_back({std::move(subscriptionFn), std::move(updateNameFilter)});
+  }
+
+  void notify(std::uint64_t updateIndex, const TUpdateName& updateName, const TState& oldState,
+              const TState& newState) override {
+    const auto isInterested = [&updateName](const Subscriber& subscriber) {
+      return passesUpdateNameFilter(subscriber.updateNameFilter, updateName);
+    };
+    if (std::none_of(subscribers_.begin(), subscribers_.end(), isInterested)) {
+      return;  // Note: selecting is skipped as long as nobody is interested
+    }
+
+    // Note: the new slice of the previous update is the old slice of this one, so it is selected only once
+    const bool isLastSliceCurrent = lastSlice_ && lastUpdateIndex_ + 1 == updateIndex;
+    TSlice oldSlice = isLastSliceCurrent ? std::move(*lastSlice_) : selectFn_(oldState);
+    lastSlice_ = selectFn_(newState);
+    lastUpdateIndex_ = updateIndex;
+
+    if (oldSlice == *lastSlice_) {
+      return;
+    }
+    for (const auto& subscriber : subscribers_) {
+      if (isInterested(subscriber)) {
+        subscriber.subscriptionFn(updateName, oldSlice, *lastSlice_);
+      }
+    }
+  }
+
+ private:
+  struct Subscriber {
+    SliceSubscriptionFn subscriptionFn;
+    std::vector<TUpdateName> updateNameFilter;
+  };
+
+  SelectFn selectFn_;
+  std::vector<Subscriber> subscribers_;
+  std::optional<TSlice> lastSlice_;
+  std::uint64_t lastUpdateIndex_{0};
+};
+
+// The subscribers interested in the difference between the old and the new state, see diff.hpp.
+template <typename TState, typename TUpdateName>
+class HubDiffSubscribers : public HubSelectorBase<TState, TUpdateName> {
+ public:
+  using DiffSubscriptionFn =
+      std::function<void(const TUpdateName&, const TState&, const TState&, const DiffOf<TState>&)>;
+
+  void addSubscriber(DiffSubscriptionFn subscriptionFn, std::vector<TUpdateName> updateNameFilter) {
+    subscribers_.push_back({std::move(subscriptionFn), std::move(updateNameFilter)});
+  }
+
+  void notify(std::uint64_t /*updateIndex*/, const TUpdateName& updateName, const TState& oldState,
+              const TState& newState) override {
+    const auto isInterested = [&updateName](const Subscriber& subscriber) {
+      return passesUpdateNameFilter(subscriber.updateNameFilter, updateName);
+    };
+    if (std::none_of(subscribers_.begin(), subscribers_.end(), isInterested)) {
+      return;  // Note: the diff is not computed as long as nobody is interested
+    }
+
+    const auto stateDiff = diff(oldState, newState);
+    if (stateDiff.empty()) {
+      return;
+    }
+    for (const auto& subscriber : subscribers_) {
+      if (isInterested(subscriber)) {
+        subscriber.subscriptionFn(updateName, oldState, newState, stateDiff);
+      }
+    }
+  }
+
+ private:
+  struct Subscriber {
+    DiffSubscriptionFn subscriptionFn;
+    std::vector<TUpdateName> updateNameFilter;
+  };
+
+  std::vector<Subscriber> subscribers_;
+};
+
+}  // namespace details
+
+// SubscriptionHub is a subscription function for StateStore that fans out notifications to many subscribers. Each
+// subscriber can restrict the updates it is interested in by a list of update names. Subscribers can also observe a
+// slice of the state selected by a selector (a state to slice projection), in which case they are only notified when
+// the selected slice changed, compared by operator==.
+//
+// Selectors are registered once via select and can be shared by any number of subscribers. Each selector is evaluated
+// at most once per update (its previous result is reused as old slice), and not at all as long as none of its
+// subscribers is interested in the update.
+//
+// Diff subscribers receive the difference between the old and the new state (see diff.hpp), and only if there is any.
+// The diff is computed at most once per update, however many diff subscribers there are.
+//
+// Copies share their subscribers, so a hub can be handed to a store and still be subscribed to afterwards. A hub is
+// meant to observe a single store. Subscribing is not synchronized with notifications, so subscribe before applying
+// updates.
+//
+// Example usage:
+//   SubscriptionHub<State> hub;
+//   auto temperature = hub.select([](const State& state) { return state.temperature; });
+//   hub.subscribe(temperature, [](const std::string& updateName, double oldTemperature, double newTemperature) {...});
+//   hub.subscribe(logFn, {"reset"});
+//   StateStore<State> store{hub};
+template <typename TState, typename TUpdateName = std::string>
+class SubscriptionHub {
+ public:
+  using SubscriptionFn = std::function<void(const TUpdateName&, const TState&, const TState&)>;
+  using UpdateNameFilter = std::vector<TUpdateName>;
+
+  // Handle of a registered selector that yields slices of type TSlice.
+  template <typename TSlice>
+  class Selector {
+   public:
+    using Slice = TSlice;
+
+   private:
+    friend class SubscriptionHub;
+    explicit Selector(details::HubSelector<TState, TUpdateName, TSlice>* selector) : selector_{selector} {}
+
+    details::HubSelector<TState, TUpdateName, TSlice>* selector_;
+  };
+
+  SubscriptionHub() : hub_{std::make_shared<Hub>()} {}
+
+  // Subscribes to state changes caused by the updates of the given names, or by any update if no name is given.
+  void subscribe(SubscriptionFn subscriptionFn, UpdateNameFilter updateNameFilter = {}) {
+    hub_->subscribers.push_back({std::move(subscriptionFn), std::move(updateNameFilter)});
+  }
+
+  // Registers the given projection of the state to a slice and returns a handle for subscribing to that slice.
+  template <typename TSelectFn>
+  auto select(TSelectFn&& selectFn) {
+    using Slice = std::decay_t<std::invoke_result_t<TSelectFn, const TState&>>;
+    using HubSelector = details::HubSelector<TState, TUpdateName, Slice>;
+
+    auto selector = std::make_unique<HubSelector>(std::forward<TSelectFn>(selectFn));
+    auto* selectorPtr = selector.get();
+    hub_->selectors.push_back(std::move(selector));
+    return Selector<Slice>{selectorPtr};
+  }
+
+  // Subscribes to changes of the slice of the given selector caused by the updates of the given names, or by any update
+  // if no name is given. The subscription function receives the update name, the old slice and the new slice.
+  template <typename TSlice, typename TSliceSubscriptionFn>
+  void subscribe(const Selector<TSlice>& selector, TSliceSubscriptionFn&& subscriptionFn,
+                 UpdateNameFilter updateNameFilter = {}) {
+    selector.selector_->addSubscriber(std::forward<TSliceSubscriptionFn>(subscriptionFn), std::move(updateNameFilter));
+  }
+
+  // Subscribes to the differences between the old and the new state caused by the updates of the given names, or by
+  // any update if no name is given. The subscription function accepts the update name and the diff, or the update
+  // name, the old state, the new state and the diff.
+  template <typename TDiffSubscriptionFn>
+  void subscribeDiff(TDiffSubscriptionFn diffSubscriptionFn, UpdateNameFilter updateNameFilter = {}) {
+    using HubDiffSubscribers = details::HubDiffSubscribers<TState, TUpdateName>;
+
+    if (hub_->diffSubscribers == nullptr) {
+      auto diffSubscribers = std::make_unique<HubDiffSubscribers>();
+      hub_->diffSubscribers = diffSubscribers.get();
+      hub_->selectors.push_back(std::move(diffSubscribers));
+    }
+    static_cast<HubDiffSubscribers*>(hub_->diffSubscribers)
+        ->addSubscriber(
+            [diffSubscriptionFn_ = std::move(diffSubscriptionFn)](const TUpdateName& updateName, const TState& oldState,
+                                                                  const TState& newState,
+                                                                  const DiffOf<TState>& stateDiff) {
+              details::notifyDiffSubscription(diffSubscriptionFn_, updateName, oldState, newState, stateDiff);
+            },
+            std::move(updateNameFilter));
+  }
+
+  // Notifies the interested subscribers about a state change.
+  void operator()(const TUpdateName& updateName, const TState& oldState, const TState& newState) const {
+    const auto updateIndex = ++hub_->updateCount;
+    for (const auto& subscriber : hub_->subscribers) {
+      if (details::passesUpdateNameFilter(subscriber.updateNameFilter, updateName)) {
+        subscriber.subscriptionFn(updateName, oldState, newState);
+      }
+    }
+    for (const auto& selector : hub_->selectors) {
+      selector->notify(updateIndex, updateName, oldState, newState);
+    }
+  }
+
+ private:
+  struct Subscriber {
+    SubscriptionFn subscriptionFn;
+    UpdateNameFilter updateNameFilter;
+  };
+
+  struct Hub {
+    std::vector<Subscriber> subscribers;
+    std::vector<std::unique_ptr<details::HubSelectorBase<TState, TUpdateName>>> selectors;
+    details::HubSelectorBase<TState, TUpdateName>* diffSubscribers{nullptr};  // Note: held by selectors
+    std::uint64_t updateCount{0};
+  };
+
+  std::shared_ptr<Hub> hub_;
+};
+
+}  // namespace funkypipes
+
+#endif  // FUNKYPIPES_SUBSCRIPTION_HUB_HPP
@@ -0,0 +1,77 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_SWAPPABLE_STAGE_HPP
+#define FUNKYPIPES_SWAPPABLE_STAGE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "funkypipes/any_pipe.hpp"
+#include "funkypipes/details/rcu.hpp"
+
+namespace funkypipes {
+
+// SwappableStage is a stage whose function can be swapped while pipes containing it are invoked from any number of
+// threads, e.g. to apply new thresholds or a new model without pausing traffic. Copies share the function, so one copy
+// is composed into pipes by makePipe or makeAutoPipe like any other stage, while another one is kept for swapping.
+//
+// The function is held by an RCU cell (read-copy-update): invocations are wait-free and keep invoking the function
+// that was current when they started, swap publishes the new function and returns once all invocations of the previous
+// one completed, which is then destroyed. Hence swap must not be called from within the stage's own function.
+//
+// The function is stored in an AnyPipe with the given signature and must allow concurrent invocations if the stage is
+// invoked by several threads.
+//
+// Example usage:
+//   auto threshold = makeSwappableStage<bool(int)>([](int value) { return value > 10; });
+//   auto pipe = makePipe(parseFn, threshold, alertFn);
+//   threshold.swap([](int value) { return value > 20; });  // from any thread, while pipe is invoked
+template <typename TSignature>
+class SwappableStage;
+
+template <typename TResult, typename... TArgs>
+class SwappableStage<TResult(TArgs...)> {
+ public:
+  using Fn = AnyPipe<TResult(TArgs...)>;
+
+  // Constructor: Initializes the stage with the given function.
+  template <typename TFn, typename = std::enable_if_t<!std::is_same_v<std::decay_t<TFn>, SwappableStage>>>
+  explicit SwappableStage(TFn&& fn)
+      : rcu_{std::make_shared<details::Rcu<Fn>>(std::make_unique<Fn>(std::forward<TFn>(fn)))} {}
+
+  // Invokes the current function with the given arguments.
+  TResult operator()(TArgs... args) const {
+    const auto fn = rcu_->read();
+    return (*fn)(std::forward<TArgs>(args)...);
+  }
+
+  // Replaces the function by the given one, returns once no invocation of the previous function is in flight anymore.
+  template <typename TFn>
+  void swap(TFn&& fn) {
+    rcu_->update(std::make_unique<Fn>(std::forward<TFn>(fn)));
+  }
+
+  // Returns the number of completed swaps.
+  [[nodiscard]] std::uint64_t version() const noexcept { return rcu_->version(); }
+
+ private:
+  std::shared_ptr<details::Rcu<Fn>> rcu_;
+};
+
+// Returns a swappable stage of the given signature initialized with the given function, see SwappableStage.
+template <typename TSignature, typename TFn>
+auto makeSwappableStage(TFn&& fn) {
+  return SwappableStage<TSignature>{std::forward<TFn>(fn)};
+}
+
+}  // namespace funkypipes
+
+#endif  // FUNKYPIPES_SWAPPABLE_STAGE_HPP
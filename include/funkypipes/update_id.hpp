@@ -0,0 +1,97 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github/mahush/funkypipes
+//
+
+#ifndef FUNKYPIPES_UPDATE_ID_HPP
+#define FUNKYPIPES_UPDATE_ID_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "funkypipes/serialization.hpp"
+
+namespace funkypipes {
+
+namespace details {
+
+// An entry of the update name intern table. Entries are never removed, so pointers to them stay valid forever.
+struct InternedUpdateName {
+  std::string name;
+  std::uint32_t index;
+};
+
+// Returns the entry for the given name, creating it on first use. Thread-safe.
+inline const InternedUpdateName& internUpdateName(std::string_view name) {
+  static std::mutex mutex;
+  static std::deque<InternedUpdateName> entries;  // Note: deque keeps element addresses stable when growing
+  static std::unordered_map<std::string_view, const InternedUpdateName*> entriesByName;
+
+  std::lock_guard<std::mutex> lock{mutex};
+  if (const auto it = entriesByName.find(name); it != entriesByName.end()) {
+    return *it->second;
+  }
+  const auto index = static_cast<std::uint32_t>(entries.size());
+  const auto& entry = entries.emplace_back(InternedUpdateName{std::string{name}, index});
+  entriesByName.emplace(entry.name, &entry);
+  return entry;
+}
+
+}  // namespace details
+
+// UpdateId is an interned update name intended to be used as StateStore's update name type (StateStore<TState,
+// UpdateId>). Creating an UpdateId looks up its name in a global intern table, afterwards it is a trivially copyable
+// handle: copying, comparing and hashing it as well as retrieving its name for logging neither locks nor allocates.
+//
+// Create the ids of high-rate updates once up front (e.g. as static constants or by passing them to StateStore::bind),
+// then applying updates does not touch any string at all.
+class UpdateId {
+ public:
+  // Interns the given name. Ids created from equal names compare equal.
+  UpdateId(std::string_view name) : entry_{&details::internUpdateName(name)} {}  // NOLINT implicit by intention
+  UpdateId(const char* name) : UpdateId{std::string_view{name}} {}              // NOLINT implicit by intention
+
+  // Returns the name the id was created from.
+  [[nodiscard]] std::string_view name() const { return entry_->name; }
+
+  // Returns a small integer that is unique per name, assigned in the order of first use starting at 0.
+  [[nodiscard]] std::uint32_t index() const { return entry_->index; }
+
+  friend bool operator==(UpdateId lhs, UpdateId rhs) { return lhs.entry_ == rhs.entry_; }
+  friend bool operator!=(UpdateId lhs, UpdateId rhs) { return lhs.entry_ != rhs.entry_; }
+  friend std::ostream& operator<<(std::ostream& stream, UpdateId updateId) { return stream << updateId.name(); }
+
+ private:
+  const details::InternedUpdateName* entry_;
+};
+
+// Serializes an UpdateId by its name, as the address of its intern table entry is meaningless to other processes.
+template <>
+struct Serialization<UpdateId> {
+  static void write(std::string& buffer, UpdateId updateId) {
+    Serialization<std::string>::write(buffer, std::string{updateId.name()});
+  }
+
+  static UpdateId read(std::string_view& buffer) { return UpdateId{Serialization<std::string>::read(buffer)}; }
+};
+
+}  // namespace funkypipes
+
+namespace std {
+template <>
+struct hash<funkypipes::UpdateId> {
+  std::size_t operator()(funkypipes::UpdateId updateId) const noexcept { return updateId.index(); }
+};
+}  // namespace std
+
+#endif  // FUNKYPIPES_UPDATE_ID_HPP
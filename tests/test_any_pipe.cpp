@@ -0,0 +1,113 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "funkypipes/any_pipe.hpp"
+#include "funkypipes/make_pipe.hpp"
+#include "utils/move_only_struct.hpp"
+
+using namespace funkypipes;
+
+namespace {
+
+// Returns whether the given object lies within the bytes of the given owner.
+template <typename TOwner>
+bool isWithin(const void* object, const TOwner& owner) {
+  const auto* ownerBytes = reinterpret_cast<const std::byte*>(&owner);
+  const auto* objectBytes = static_cast<const std::byte*>(object);
+  return std::less_equal<>{}(ownerBytes, objectBytes) && std::less<>{}(objectBytes, ownerBytes + sizeof(TOwner));
+}
+
+}  // namespace
+
+// Ensure that pipes with multiple arguments and tuple results work like the pipe itself
+TEST(AnyPipeTest, MultipleArgumentsAndTupleResults) {
+  // Given: A pipe swapping its two arguments
+  auto swapArgs = [](auto arg1, auto arg2) { return std::make_tuple(arg2, arg1); };
+  AnyPipe<std::tuple<std::string, int>(int, std::string)> pipe = makePipe(swapArgs, swapArgs, swapArgs);
+
+  // When: The pipe is invoked
+  auto result = pipe(42, "answer");
+
+  // Then: The result is that of the pipe
+  EXPECT_EQ(result, std::make_tuple(std::string{"answer"}, 42));
+}
+
+// Ensure that arguments are packed into and unpacked from tuples as done by makePipe
+TEST(AnyPipeTest, ArgumentsArePackedAndUnpacked) {
+  // Given: A callable accepting a tuple and one accepting its elements
+  AnyPipe<int(int, int)> packing = [](const std::tuple<int, int>& args) {
+    return std::get<0>(args) * 10 + std::get<1>(args);
+  };
+  AnyPipe<int(std::tuple<int, int>)> unpacking = [](int arg1, int arg2) { return arg1 * 10 + arg2; };
+
+  // When: Both are invoked
+  // Then: The arguments are packed and unpacked respectively
+  EXPECT_EQ(packing(1, 2), 12);
+  EXPECT_EQ(unpacking(std::make_tuple(3, 4)), 34);
+}
+
+// Ensure that pipes fitting the inline capacity are stored inline, while larger ones are still supported
+TEST(AnyPipeTest, SmallPipesAreStoredInline) {
+  // Given: A small pipe and a pipe exceeding the inline capacity, both reporting the address of their data
+  struct SelfReporting {
+    const void** address;
+    void operator()() { *address = this; }
+  };
+  const void* smallAddress = nullptr;
+  static_assert(AnyPipe<void()>::isStoredInline<SelfReporting>());
+
+  const void* largeAddress = nullptr;
+  std::array<char, 2 * kDefaultAnyPipeInlineCapacity> payload{};
+  auto largePipe = [&largeAddress, payload]() { largeAddress = payload.data(); };
+  static_assert(!AnyPipe<void()>::isStoredInline<decltype(largePipe)>());
+
+  // When: Both are stored in an AnyPipe, moved and invoked
+  AnyPipe<void()> small{SelfReporting{&smallAddress}};
+  AnyPipe<void()> movedSmall{std::move(small)};
+  movedSmall();
+  AnyPipe<void()> large{largePipe};
+  AnyPipe<void()> movedLarge{std::move(large)};
+  movedLarge();
+
+  // Then: The small pipe lives within the AnyPipe, the large one outside of it
+  EXPECT_TRUE(isWithin(smallAddress, movedSmall));
+  EXPECT_FALSE(isWithin(largeAddress, movedLarge));
+  EXPECT_FALSE(static_cast<bool>(small));
+  EXPECT_FALSE(static_cast<bool>(large));
+}
+
+// Ensure that move-only pipes are supported and destroyed exactly once
+TEST(AnyPipeTest, MoveOnlyPipesAreOwned) {
+  // Given: A move-only pipe sharing ownership of a counter
+  auto counter = std::make_shared<int>(0);
+  auto pipe = makePipe(
+      [counter, moveOnly = MoveOnlyStruct{1}](int value) { return *counter += value + moveOnly.value_; });
+
+  // When: It is stored in an AnyPipe, which is moved around and invoked
+  AnyPipe<int(int), 64> anyPipe{std::move(pipe)};
+  AnyPipe<int(int), 64> movedAnyPipe;
+  movedAnyPipe = std::move(anyPipe);
+  const int result = movedAnyPipe(2);
+
+  // Then: The pipe was invoked and is released along with its AnyPipe
+  EXPECT_EQ(result, 3);
+  EXPECT_EQ(counter.use_count(), 2);
+  movedAnyPipe = AnyPipe<int(int), 64>{};
+  EXPECT_EQ(counter.use_count(), 1);
+  EXPECT_THROW(movedAnyPipe(2), std::bad_function_call);
+}
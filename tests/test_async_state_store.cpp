@@ -0,0 +1,140 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "funkypipes/async_state_store.hpp"
+#include "utils/move_only_struct.hpp"
+
+using namespace funkypipes;
+using ::testing::MockFunction;
+
+// Ensure that apply returns a future of the update function's additional output
+TEST(AsyncStateStoreTest, ApplyReturnsFutureOfOutputs) {
+  // Given: A store
+  AsyncStateStore<int> store{10};
+
+  // When: Updates are applied, without and with an additional output
+  std::future<void> done = store.apply("add", [](int state, int summand) { return state + summand; }, 5);
+  std::future<int> output = store.apply("double", [](int state) { return std::make_tuple(state * 2, state); });
+
+  // Then: The futures provide the outputs and the state reflects both updates
+  done.get();
+  EXPECT_EQ(output.get(), 15);
+  EXPECT_EQ(store.get_state().get(), 30);
+}
+
+// Ensure that applyAndTransform returns a future of the transformed output
+TEST(AsyncStateStoreTest, ApplyAndTransformReturnsFutureOfTransformedOutput) {
+  // Given: A store
+  AsyncStateStore<int> store{2};
+
+  // When: An update is applied with a transform function
+  auto transformed = store.applyAndTransform(
+      "increment", [](int state) { return state + 1; }, [](int state) { return std::to_string(state); });
+
+  // Then: The future provides the transformed output
+  EXPECT_EQ(transformed.get(), "3");
+}
+
+// Ensure that bound update functions enqueue their updates and return futures
+TEST(AsyncStateStoreTest, BindProducesAsyncUpdaters) {
+  // Given: A store and bound update functions, one with a transform function
+  AsyncStateStore<int> store;
+  auto add = store.bind("add", [](int state, int summand) { return state + summand; });
+  auto addAndNegate =
+      store.bind("add", [](int state, int summand) { return state + summand; }, [](int state) { return -state; });
+
+  // When: The bound functions are called
+  add(4);
+  auto negated = addAndNegate(3);
+
+  // Then: The updates are applied in order
+  EXPECT_EQ(negated.get(), -7);
+}
+
+// Ensure that updates enqueued from several threads are all applied, each thread's updates in order
+TEST(AsyncStateStoreTest, UpdatesFromSeveralThreadsAreSerialized) {
+  // Given: A store recording the values appended by several threads
+  AsyncStateStore<std::vector<int>> store;
+  auto append = store.bind("append", [](std::vector<int> state, int value) {
+    state.push_back(value);
+    return state;
+  });
+
+  // When: Each thread appends an increasing sequence of its own
+  constexpr int kThreadCount = 4;
+  constexpr int kValueCount = 200;
+  std::vector<std::thread> threads;
+  for (int thread = 0; thread < kThreadCount; ++thread) {
+    threads.emplace_back([&append, thread] {
+      for (int value = 0; value < kValueCount; ++value) {
+        append(thread * kValueCount + value);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // Then: All values were appended and each thread's values appear in order
+  const auto state = store.get_state().get();
+  ASSERT_EQ(state.size(), static_cast<std::size_t>(kThreadCount * kValueCount));
+  std::vector<int> lastValueOfThread(kThreadCount, -1);
+  for (int value : state) {
+    EXPECT_GT(value, lastValueOfThread[value / kValueCount]);
+    lastValueOfThread[value / kValueCount] = value;
+  }
+}
+
+// Ensure that an exception thrown by an update function is passed to its future and leaves the state unchanged
+TEST(AsyncStateStoreTest, ExceptionIsPassedToFuture) {
+  // Given: A store
+  AsyncStateStore<int> store{1};
+
+  // When: An update function throws
+  auto failed = store.apply("fail", [](int) -> int { throw std::runtime_error{"failed"}; });
+
+  // Then: The future rethrows the exception and the state is unchanged
+  EXPECT_THROW(failed.get(), std::runtime_error);
+  EXPECT_EQ(store.get_state().get(), 1);
+}
+
+// Ensure that the subscription is notified about asynchronously applied updates
+TEST(AsyncStateStoreTest, SubscriptionIsNotified) {
+  // Given: A store with a subscription
+  MockFunction<void(const std::string&, const int&, const int&)> subscriptionMock;
+  AsyncStateStore<int> store{subscriptionMock.AsStdFunction(), 1};
+
+  // Then: The subscription is notified about the update
+  EXPECT_CALL(subscriptionMock, Call("increment", 1, 2));
+
+  // When: An update is applied and completed
+  store.apply("increment", [](int state) { return state + 1; }).get();
+}
+
+// Ensure that move-only arguments are moved into the queued update
+TEST(AsyncStateStoreTest, MoveOnlyArgumentsAreSupported) {
+  // Given: A store
+  AsyncStateStore<int> store;
+
+  // When: An update is applied with a move-only argument
+  auto done = store.apply("set", [](int, MoveOnlyStruct value) { return value.value_; }, MoveOnlyStruct{7});
+
+  // Then: The update received the argument
+  done.get();
+  EXPECT_EQ(store.get_state().get(), 7);
+}
@@ -0,0 +1,178 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "funkypipes/async_subscription.hpp"
+#include "funkypipes/state_store.hpp"
+
+using namespace funkypipes;
+
+namespace {
+
+// Records notifications as "name:old->new" strings
+class NotificationRecorder {
+ public:
+  void record(const std::string& updateName, int oldState, int newState) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    notifications_.push_back(updateName + ":" + std::to_string(oldState) + "->" + std::to_string(newState));
+  }
+
+  std::vector<std::string> notifications() {
+    std::lock_guard<std::mutex> lock{mutex_};
+    return notifications_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<std::string> notifications_;
+};
+
+// A subscription function that blocks within its first call until being released
+class BlockingOnFirstCall {
+ public:
+  explicit BlockingOnFirstCall(NotificationRecorder& recorder) : recorder_{recorder} {}
+
+  void operator()(const std::string& updateName, int oldState, int newState) {
+    if (isFirstCall_) {
+      isFirstCall_ = false;
+      entered_.set_value();
+      released_.get_future().wait();
+    }
+    recorder_.record(updateName, oldState, newState);
+  }
+
+  void waitUntilEntered() { entered_.get_future().wait(); }
+  void release() { released_.set_value(); }
+
+ private:
+  NotificationRecorder& recorder_;
+  bool isFirstCall_{true};
+  std::promise<void> entered_;
+  std::promise<void> released_;
+};
+
+auto incrementFn = [](int state) { return state + 1; };
+
+}  // namespace
+
+// Ensure that all notifications are delivered in order
+TEST(AsyncSubscriptionTest, DeliversNotificationsInOrder) {
+  // Given: A store with an asynchronous subscription
+  NotificationRecorder recorder;
+  AsyncSubscription<int> subscription{[&recorder](const std::string& name, int oldState, int newState) {
+    recorder.record(name, oldState, newState);
+  }};
+  auto store = makeStateStore(0, subscription);
+
+  // When: Updates are applied and the subscription is flushed
+  store.apply("increment", incrementFn);
+  store.apply("add", [](int state, int amount) { return state + amount; }, 5);
+  subscription.flush();
+
+  // Then: All notifications got delivered in order
+  EXPECT_EQ(recorder.notifications(), (std::vector<std::string>{"increment:0->1", "add:1->6"}));
+}
+
+// Ensure that applying updates does not wait for the subscription function
+TEST(AsyncSubscriptionTest, ApplyDoesNotWaitForSubscription) {
+  // Given: A store whose subscription blocks
+  NotificationRecorder recorder;
+  BlockingOnFirstCall blockingFn{recorder};
+  AsyncSubscription<int> subscription{std::ref(blockingFn)};
+  StateStore<int> store{subscription};
+
+  // When: Updates are applied while the subscription is blocked
+  store.apply("increment", incrementFn);
+  blockingFn.waitUntilEntered();
+  store.apply("increment", incrementFn);
+  store.apply("increment", incrementFn);
+
+  // Then: The updates took effect and the notifications are delivered once the subscription continues
+  EXPECT_EQ(store.get_state(), 3);
+  EXPECT_TRUE(recorder.notifications().empty());
+  blockingFn.release();
+  subscription.flush();
+  EXPECT_EQ(recorder.notifications(),
+            (std::vector<std::string>{"increment:0->1", "increment:1->2", "increment:2->3"}));
+}
+
+// Ensure that a blocking subscription does not lose notifications even with a tiny queue
+TEST(AsyncSubscriptionTest, BlockPolicyDeliversAllNotifications) {
+  // Given: A store with an asynchronous subscription with a queue of two elements
+  NotificationRecorder recorder;
+  AsyncSubscription<int> subscription{
+      [&recorder](const std::string& name, int oldState, int newState) { recorder.record(name, oldState, newState); },
+      2, OverflowPolicy::kBlock};
+  auto store = makeStateStore(0, subscription);
+
+  // When: Many updates are applied
+  const int updateCount = 1000;
+  for (int idx = 0; idx < updateCount; ++idx) {
+    store.apply("increment", incrementFn);
+  }
+  subscription.flush();
+
+  // Then: All notifications got delivered in order
+  const auto notifications = recorder.notifications();
+  ASSERT_EQ(notifications.size(), static_cast<std::size_t>(updateCount));
+  EXPECT_EQ(notifications.back(), "increment:999->1000");
+  EXPECT_EQ(subscription.droppedCount(), 0U);
+}
+
+// Ensure that the oldest notifications are dropped when the queue overflows
+TEST(AsyncSubscriptionTest, DropOldestPolicyKeepsLatestNotifications) {
+  // Given: A store whose subscription with a queue of two elements is blocked within the first notification
+  NotificationRecorder recorder;
+  BlockingOnFirstCall blockingFn{recorder};
+  AsyncSubscription<int> subscription{std::ref(blockingFn), 2, OverflowPolicy::kDropOldest};
+  auto store = makeStateStore(0, subscription);
+  store.apply("increment", incrementFn);
+  blockingFn.waitUntilEntered();
+
+  // When: More updates are applied than fit into the queue
+  for (int idx = 0; idx < 5; ++idx) {
+    store.apply("increment", incrementFn);
+  }
+  blockingFn.release();
+  subscription.flush();
+
+  // Then: The latest notifications got delivered
+  EXPECT_EQ(recorder.notifications(),
+            (std::vector<std::string>{"increment:0->1", "increment:4->5", "increment:5->6"}));
+  EXPECT_EQ(subscription.droppedCount(), 3U);
+}
+
+// Ensure that overflowing notifications are merged into a single one
+TEST(AsyncSubscriptionTest, CoalesceToLatestPolicyMergesOverflowingNotifications) {
+  // Given: A store whose subscription with a queue of two elements is blocked within the first notification
+  NotificationRecorder recorder;
+  BlockingOnFirstCall blockingFn{recorder};
+  AsyncSubscription<int> subscription{std::ref(blockingFn), 2, OverflowPolicy::kCoalesceToLatest};
+  auto store = makeStateStore(0, subscription);
+  store.apply("increment", incrementFn);
+  blockingFn.waitUntilEntered();
+
+  // When: More updates are applied than fit into the queue
+  store.apply("increment", incrementFn);
+  store.apply("increment", incrementFn);
+  store.apply("add", [](int state, int amount) { return state + amount; }, 10);
+  store.apply("double", [](int state) { return state * 2; });
+  blockingFn.release();
+  subscription.flush();
+
+  // Then: The queued notifications are followed by a merged one spanning the overflowing updates
+  EXPECT_EQ(recorder.notifications(),
+            (std::vector<std::string>{"increment:0->1", "increment:1->2", "increment:2->3", "double:3->26"}));
+  EXPECT_EQ(subscription.droppedCount(), 1U);
+}
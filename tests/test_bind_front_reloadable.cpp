@@ -0,0 +1,83 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+#include <thread>
+
+#include "funkypipes/bind_front_reloadable.hpp"
+#include "funkypipes/make_pipe.hpp"
+
+using namespace funkypipes;
+
+namespace {
+
+struct Limits {
+  int max{0};
+};
+
+using Labels = std::map<int, std::string>;
+
+}  // namespace
+
+// Ensure that reloaded arguments are bound from the next invocation on, without rebuilding the pipe
+TEST(BindFrontReloadableTest, ReloadedArgumentsAreBoundByNextInvocation) {
+  // Given: A pipe composed of a function bound to reloadable limits and labels
+  auto config = makeReloadableArgs(Limits{10}, Labels{{0, "ok"}, {1, "alert"}});
+  auto classify = [](const Limits& limits, const Labels& labels, int value) { return labels.at(value > limits.max); };
+  auto pipe = makePipe([](int value) { return value * 2; }, bindFrontReloadable(classify, config));
+  EXPECT_EQ(pipe(8), "alert");
+
+  // When: The configuration is reloaded
+  config.reload(Limits{20}, Labels{{0, "fine"}, {1, "alarm"}});
+
+  // Then: The pipe uses the new configuration
+  EXPECT_EQ(pipe(8), "fine");
+  EXPECT_EQ(pipe(11), "alarm");
+  EXPECT_EQ(config.version(), 1U);
+}
+
+// Ensure that invocations in flight keep using their snapshot, while a reload waits for them to complete
+TEST(BindFrontReloadableTest, InvocationsInFlightKeepTheirSnapshot) {
+  // Given: A function bound to reloadable limits, which is invoked and blocks until told to proceed
+  auto limits = makeReloadableArgs(Limits{10});
+  std::atomic<bool> isEntered{false};
+  std::atomic<bool> mayProceed{false};
+  auto readMaxTwice = bindFrontReloadable(
+      [&](const Limits& bound) {
+        const int maxBefore = bound.max;
+        isEntered.store(true);
+        while (!mayProceed.load()) {
+          std::this_thread::yield();
+        }
+        return maxBefore + bound.max;
+      },
+      limits);
+  int inFlightResult = 0;
+  std::thread invoker{[&] { inFlightResult = readMaxTwice(); }};
+  while (!isEntered.load()) {
+    std::this_thread::yield();
+  }
+
+  // When: The limits are reloaded meanwhile
+  std::thread reloader{[&] { limits.reload(Limits{30}); }};
+  std::this_thread::sleep_for(std::chrono::milliseconds{10});
+
+  // Then: The reload waits for the invocation in flight, which keeps using the previous snapshot
+  EXPECT_EQ(limits.version(), 0U);
+  mayProceed.store(true);
+  invoker.join();
+  reloader.join();
+  EXPECT_EQ(limits.version(), 1U);
+  EXPECT_EQ(inFlightResult, 20);
+  EXPECT_EQ(readMaxTwice(), 60);
+}
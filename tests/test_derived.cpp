@@ -0,0 +1,136 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <vector>
+
+#include "funkypipes/derived.hpp"
+#include "funkypipes/lens.hpp"
+#include "funkypipes/state_store.hpp"
+
+using namespace funkypipes;
+
+namespace {
+
+struct MovingAverageState {
+  std::vector<double> window;
+  std::size_t windowSize;
+};
+
+auto addSampleFn = [](MovingAverageState state, double sample) {
+  state.window.push_back(sample);
+  if (state.window.size() > state.windowSize) {
+    state.window.erase(state.window.begin());
+  }
+  return state;
+};
+
+}  // namespace
+
+// Ensure that every state transition changes the store's version
+TEST(DerivedTest, StoreVersionCountsStateTransitions) {
+  // Given: A fresh store
+  StateStore<MovingAverageState> store{MovingAverageState{{}, 2}};
+  EXPECT_EQ(store.version(), 0U);
+
+  // When: Applying updates in each way
+  store.apply("add", addSampleFn, 1.0);
+  store.transaction("batch", [](auto& tx) { tx.apply("add", addSampleFn, 2.0); });
+  store.applyAt("resize", lens(&MovingAverageState::windowSize), [](std::size_t) { return std::size_t{3}; });
+
+  // Then: Each transition was counted
+  EXPECT_EQ(store.version(), 3U);
+}
+
+// Ensure that a derived value is computed lazily and only once per state change
+TEST(DerivedTest, ValueIsComputedLazilyOncePerStateChange) {
+  // Given: A store and a derived average counting its computations
+  StateStore<MovingAverageState> store{MovingAverageState{{}, 3}};
+  int computationCount = 0;
+  auto average = store.derive([&computationCount](const MovingAverageState& state) {
+    ++computationCount;
+    return state.window.empty() ? 0.0 : std::accumulate(state.window.begin(), state.window.end(), 0.0) /
+                                            static_cast<double>(state.window.size());
+  });
+
+  // When: Applying updates without reading the average
+  store.apply("add", addSampleFn, 10.0);
+  store.apply("add", addSampleFn, 20.0);
+
+  // Then: Nothing was computed
+  EXPECT_EQ(computationCount, 0);
+
+  // When: Reading the average repeatedly
+  EXPECT_EQ(average(), 15.0);
+  EXPECT_EQ(average(), 15.0);
+
+  // Then: It was computed once
+  EXPECT_EQ(computationCount, 1);
+
+  // When: Reading it after another update
+  store.apply("add", addSampleFn, 30.0);
+
+  // Then: It is recomputed once
+  EXPECT_EQ(average(), 20.0);
+  EXPECT_EQ(computationCount, 2);
+}
+
+// Ensure that composed derived values are recomputed only if their inputs changed
+TEST(DerivedTest, ComposedValueIsRecomputedOnlyIfInputsChanged) {
+  // Given: A derived window size and a value derived from it
+  StateStore<MovingAverageState> store{MovingAverageState{{}, 3}};
+  auto windowSize = store.derive([](const MovingAverageState& state) { return state.windowSize; });
+  int computationCount = 0;
+  auto description = derive(
+      [&computationCount](std::size_t size) {
+        ++computationCount;
+        return size * 2;
+      },
+      windowSize);
+  EXPECT_EQ(description(), 6U);
+
+  // When: Applying an update that leaves the window size unchanged
+  store.apply("add", addSampleFn, 10.0);
+
+  // Then: The composed value is not recomputed
+  EXPECT_EQ(description(), 6U);
+  EXPECT_EQ(computationCount, 1);
+
+  // When: Changing the window size
+  store.applyAt("resize", lens(&MovingAverageState::windowSize), [](std::size_t) { return std::size_t{5}; });
+
+  // Then: The composed value is recomputed
+  EXPECT_EQ(description(), 10U);
+  EXPECT_EQ(computationCount, 2);
+}
+
+// Ensure that a derived value combines several inputs and copies share the memoized value
+TEST(DerivedTest, CombinesSeveralInputs) {
+  // Given: Two stores, a value derived from both and a copy of it
+  StateStore<int> first{1};
+  StateStore<int> second{10};
+  int computationCount = 0;
+  auto sum = derive(
+      [&computationCount](int lhs, int rhs) {
+        ++computationCount;
+        return lhs + rhs;
+      },
+      first.derive([](int state) { return state; }), second.derive([](int state) { return state; }));
+  const auto sumCopy = sum;
+
+  // When: Reading both after changing the second store
+  EXPECT_EQ(sum(), 11);
+  second.apply("set", [](int, int value) { return value; }, 20);
+
+  // Then: Both see the new value, computed once
+  EXPECT_EQ(sum(), 21);
+  EXPECT_EQ(sumCopy(), 21);
+  EXPECT_EQ(computationCount, 2);
+}
@@ -0,0 +1,126 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "funkypipes/diff.hpp"
+#include "funkypipes/persistent_hash_map.hpp"
+#include "funkypipes/persistent_vector.hpp"
+#include "funkypipes/state_store.hpp"
+
+using namespace funkypipes;
+
+namespace {
+
+struct Sensor {
+  std::string name;
+  double threshold;
+};
+
+struct PlantState {
+  std::map<int, Sensor> sensors;
+  std::vector<double> samples;
+  std::string operatorName;
+};
+
+}  // namespace
+
+// Ensure that values without structure are compared as a whole
+TEST(DiffTest, ValueDiffHoldsChangedValues) {
+  EXPECT_TRUE(diff(1, 1).empty());
+  EXPECT_TRUE(diff(std::string{"a"}, std::string{"a"}).empty());
+
+  const auto stringDiff = diff(std::string{"a"}, std::string{"b"});
+  static_assert(std::is_same_v<std::decay_t<decltype(stringDiff)>, ValueDiff<std::string>>);
+  ASSERT_FALSE(stringDiff.empty());
+  EXPECT_EQ(stringDiff.change->oldValue, "a");
+  EXPECT_EQ(stringDiff.change->newValue, "b");
+}
+
+// Ensure that maps are compared by key
+TEST(DiffTest, MapDiffHoldsAddedChangedAndRemovedEntries) {
+  // Given: two maps differing in each way
+  const std::map<std::string, int> oldMap{{"kept", 1}, {"changed", 2}, {"removed", 3}};
+  const std::map<std::string, int> newMap{{"kept", 1}, {"changed", 20}, {"added", 4}};
+
+  // When: computing their diff
+  const auto mapDiff = diff(oldMap, newMap);
+
+  // Then: each difference is reported once
+  ASSERT_EQ(mapDiff.added.size(), 1U);
+  EXPECT_EQ(mapDiff.added[0], (std::pair<std::string, int>{"added", 4}));
+  ASSERT_EQ(mapDiff.changed.size(), 1U);
+  EXPECT_EQ(mapDiff.changed[0].first, "changed");
+  EXPECT_EQ(mapDiff.changed[0].second.change->newValue, 20);
+  EXPECT_EQ(mapDiff.removed, (std::vector<std::string>{"removed"}));
+
+  // Then: persistent maps are compared likewise
+  const PersistentHashMap<int, int> persistentMap{{1, 1}, {2, 2}};
+  const auto persistentDiff = diff(persistentMap, persistentMap.set(2, 3).erase(1));
+  EXPECT_EQ(persistentDiff.changed.size(), 1U);
+  EXPECT_EQ(persistentDiff.removed, (std::vector<int>{1}));
+}
+
+// Ensure that sequences are compared index by index
+TEST(DiffTest, SequenceDiffHoldsChangedAppendedAndRemovedElements) {
+  const auto grown = diff(std::vector<int>{1, 2, 3}, std::vector<int>{1, 5, 3, 4});
+  ASSERT_EQ(grown.changed.size(), 1U);
+  EXPECT_EQ(grown.changed[0].first, 1U);
+  EXPECT_EQ(grown.appended, (std::vector<int>{4}));
+  EXPECT_EQ(grown.removedCount, 0U);
+
+  const auto shrunk = diff(PersistentVector<int>{1, 2, 3}, PersistentVector<int>{1, 2});
+  EXPECT_TRUE(shrunk.changed.empty());
+  EXPECT_EQ(shrunk.removedCount, 1U);
+}
+
+// Ensure that aggregates are compared field by field, recursively
+TEST(DiffTest, AggregateDiffHoldsFieldDiffs) {
+  // Given: two states differing in a nested field only
+  PlantState oldState{{{1, {"boiler", 80.0}}}, {1.0}, "alice"};
+  PlantState newState = oldState;
+  newState.sensors[1].threshold = 90.0;
+
+  // When: computing their diff
+  const auto stateDiff = diff(oldState, newState);
+
+  // Then: only the nested field is reported
+  EXPECT_FALSE(stateDiff.empty());
+  const auto& [sensorsDiff, samplesDiff, operatorNameDiff] = stateDiff.fields;
+  EXPECT_TRUE(samplesDiff.empty());
+  EXPECT_TRUE(operatorNameDiff.empty());
+  ASSERT_EQ(sensorsDiff.changed.size(), 1U);
+  const auto& [nameDiff, thresholdDiff] = sensorsDiff.changed[0].second.fields;
+  EXPECT_TRUE(nameDiff.empty());
+  EXPECT_EQ(thresholdDiff.change->oldValue, 80.0);
+  EXPECT_EQ(thresholdDiff.change->newValue, 90.0);
+  EXPECT_TRUE(diff(oldState, oldState).empty());
+}
+
+// Ensure that a diff subscription is notified about changes only
+TEST(DiffTest, DiffSubscriptionIsNotifiedAboutChangesOnly) {
+  // Given: a store with a diff subscription
+  std::vector<std::string> notifiedUpdates;
+  StateStore<PlantState> store{makeDiffSubscription<PlantState>(
+      [&](const std::string& updateName, const DiffOf<PlantState>&) { notifiedUpdates.push_back(updateName); })};
+
+  // When: applying a changing and an unchanging update
+  store.apply("rename", [](PlantState state) {
+    state.operatorName = "bob";
+    return state;
+  });
+  store.apply("noop", [](const PlantState& state) { return state; });
+
+  // Then: only the changing update is notified
+  EXPECT_EQ(notifiedUpdates, (std::vector<std::string>{"rename"}));
+}
@@ -0,0 +1,102 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+#include "funkypipes/at.hpp"
+#include "funkypipes/fork.hpp"
+#include "funkypipes/function_ref.hpp"
+#include "funkypipes/make_pipe.hpp"
+#include "funkypipes/pass_along.hpp"
+
+using namespace funkypipes;
+
+namespace {
+
+int increment(int value) { return value + 1; }
+
+// A library function invoking the given pipe during its call only.
+template <typename TResult, typename TArg>
+TResult invokeTwice(FunctionRef<TResult(TArg)> pipe, TArg arg) {
+  pipe(arg);
+  return pipe(arg);
+}
+
+}  // namespace
+
+// Ensure that a FunctionRef is as small as two pointers and trivially copyable
+TEST(FunctionRefTest, ConsistsOfTwoPointers) {
+  static_assert(sizeof(FunctionRef<int(int)>) == 2 * sizeof(void*));
+  static_assert(std::is_trivially_copyable_v<FunctionRef<int(int)>>);
+}
+
+// Ensure that pipes, functions and function pointers can be referenced, including stateful pipes
+TEST(FunctionRefTest, ReferencesPipesAndFunctions) {
+  // Given: A stateful pipe, a function and a function pointer
+  int callCount = 0;
+  auto countingPipe = makePipe([&callCount](int value) {
+    ++callCount;
+    return value * 2;
+  });
+  int (*incrementPtr)(int) = &increment;
+
+  // When: They are passed as FunctionRef
+  const int pipeResult = invokeTwice<int, int>(countingPipe, 5);
+  const int functionResult = invokeTwice<int, int>(increment, 5);
+  const int functionPtrResult = invokeTwice<int, int>(incrementPtr, 6);
+
+  // Then: The referenced callables were invoked
+  EXPECT_EQ(pipeResult, 10);
+  EXPECT_EQ(callCount, 2);
+  EXPECT_EQ(functionResult, 6);
+  EXPECT_EQ(functionPtrResult, 7);
+}
+
+// Ensure that decorated functions can be referenced, including their multiple arguments and tuple results
+TEST(FunctionRefTest, ReferencesDecoratedFunctions) {
+  // Given: Functions decorated by at, fork and passAlong
+  auto incrementFn = [](int value) { return value + 1; };
+  auto toStringFn = [](int value) { return std::to_string(value); };
+  auto atSecond = at<1>(incrementFn);
+  auto forked = fork(incrementFn, toStringFn);
+  auto passingAlong = passAlong<0>(incrementFn);
+
+  // When: They are invoked via FunctionRef
+  FunctionRef<std::tuple<double, int>(double, int)> atRef{atSecond};
+  FunctionRef<std::tuple<int, std::string>(int)> forkRef{forked};
+  FunctionRef<std::tuple<int, int>(int)> passAlongRef{passingAlong};
+
+  // Then: The results are those of the decorated functions
+  EXPECT_EQ(atRef(1.5, 2), std::make_tuple(1.5, 3));
+  EXPECT_EQ(forkRef(41), std::make_tuple(42, std::string{"41"}));
+  EXPECT_EQ(passAlongRef(7), std::make_tuple(8, 7));
+}
+
+// Ensure that references returned by the referenced pipe are returned as they are
+TEST(FunctionRefTest, PreservesReferenceResults) {
+  // Given: A pipe forwarding a reference
+  auto forwardReference = [](int& value) -> int& { return value; };
+  auto pipe = makePipe(forwardReference, forwardReference);
+  FunctionRef<int&(int&)> pipeRef{pipe};
+
+  // When: It is invoked via FunctionRef
+  int argument{1};
+  int& result = pipeRef(argument);
+
+  // Then: The result refers to the argument
+  EXPECT_EQ(&result, &argument);
+
+  // Then: References are not bound to temporaries returned by value
+  auto returnByValue = [](int& value) { return value; };
+  static_assert(!std::is_constructible_v<FunctionRef<const int&(int&)>, decltype(returnByValue)&>);
+  static_assert(std::is_constructible_v<FunctionRef<int(int&)>, decltype(returnByValue)&>);
+}
@@ -0,0 +1,206 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "funkypipes/history_state_store.hpp"
+
+using namespace funkypipes;
+using ::testing::MockFunction;
+
+namespace {
+
+auto addFn = [](int state, int amount) { return state + amount; };
+
+// A memory chunk counting its living instances
+struct Chunk {
+  static constexpr std::size_t kSize = 10 * 1024;
+  static inline int liveCount = 0;
+
+  Chunk() { ++liveCount; }
+  Chunk(const Chunk& other) : bytes{other.bytes} { ++liveCount; }
+  Chunk& operator=(const Chunk&) = delete;
+  ~Chunk() { --liveCount; }
+
+  std::array<char, kSize> bytes{};
+};
+
+// A 10 MB state whose copies share all chunks that were not written
+struct ChunkedState {
+  static constexpr std::size_t kChunkCount = 1024;
+
+  ChunkedState() {
+    for (std::size_t idx = 0; idx < kChunkCount; ++idx) {
+      chunks.push_back(std::make_shared<const Chunk>());
+    }
+  }
+
+  std::vector<std::shared_ptr<const Chunk>> chunks;
+};
+
+auto writeByteFn = [](ChunkedState state, std::size_t offset, char value) {
+  auto& chunk = state.chunks[offset / Chunk::kSize];
+  auto modifiedChunk = std::make_shared<Chunk>(*chunk);
+  modifiedChunk->bytes[offset % Chunk::kSize] = value;
+  chunk = std::move(modifiedChunk);
+  return state;
+};
+
+char byteAt(const ChunkedState& state, std::size_t offset) {
+  return state.chunks[offset / Chunk::kSize]->bytes[offset % Chunk::kSize];
+}
+
+// Returns the memory held by the given store's chunks and by the chunk pointers of its recorded states
+template <typename TStore>
+std::size_t historyMemoryOf(const TStore& store) {
+  const std::size_t pointerMemory = sizeof(std::shared_ptr<const Chunk>) * ChunkedState::kChunkCount;
+  return static_cast<std::size_t>(Chunk::liveCount) * sizeof(Chunk) +
+         (store.undoDepth() + store.redoDepth() + 1) * pointerMemory;
+}
+
+}  // namespace
+
+// Ensure that undo and redo step through the recorded states
+TEST(HistoryStateStoreTest, UndoAndRedoStepThroughStates) {
+  // Given: A store with three applied updates
+  HistoryStateStore<int> store{10, 1};
+  store.apply("add", addFn, 1);
+  store.apply("add", addFn, 2);
+  store.apply("add", addFn, 3);
+
+  // When: Two updates are undone and one is redone
+  EXPECT_TRUE(store.undo("undo"));
+  EXPECT_TRUE(store.undo("undo"));
+  EXPECT_TRUE(store.redo("redo"));
+
+  // Then: The state of the second update is the current one
+  EXPECT_EQ(store.get_state(), 4);
+  EXPECT_EQ(store.undoDepth(), 2U);
+  EXPECT_EQ(store.redoDepth(), 1U);
+}
+
+// Ensure that stateAt returns earlier states without changing the current one
+TEST(HistoryStateStoreTest, StateAtReturnsEarlierStates) {
+  // Given: A store with three applied updates
+  HistoryStateStore<int> store{10, 1};
+  store.apply("add", addFn, 1);
+  store.apply("add", addFn, 2);
+  store.apply("add", addFn, 3);
+
+  // When & Then: Earlier states are accessible
+  EXPECT_EQ(store.stateAt(0), 7);
+  EXPECT_EQ(store.stateAt(1), 4);
+  EXPECT_EQ(store.stateAt(3), 1);
+  EXPECT_EQ(store.get_state(), 7);
+}
+
+// Ensure that undo and redo fail at the ends of the history
+TEST(HistoryStateStoreTest, UndoAndRedoFailAtHistoryEnds) {
+  // Given: A store with a single applied update
+  HistoryStateStore<int> store{10, 1};
+  store.apply("add", addFn, 1);
+
+  // When & Then: There is nothing to redo, and nothing to undo beyond the initial state
+  EXPECT_FALSE(store.redo("redo"));
+  EXPECT_TRUE(store.undo("undo"));
+  EXPECT_FALSE(store.undo("undo"));
+  EXPECT_EQ(store.get_state(), 1);
+}
+
+// Ensure that applying an update discards undone states
+TEST(HistoryStateStoreTest, ApplyDiscardsUndoneStates) {
+  // Given: A store with an undone update
+  HistoryStateStore<int> store{10, 1};
+  store.apply("add", addFn, 1);
+  store.apply("add", addFn, 2);
+  store.undo("undo");
+
+  // When: Another update is applied
+  store.apply("add", addFn, 10);
+
+  // Then: The undone state cannot be redone anymore
+  EXPECT_FALSE(store.redo("redo"));
+  EXPECT_EQ(store.get_state(), 12);
+  EXPECT_EQ(store.stateAt(1), 2);
+}
+
+// Ensure that only the configured number of earlier states is kept
+TEST(HistoryStateStoreTest, HistoryIsBoundedByDepth) {
+  // Given: A store keeping two earlier states
+  HistoryStateStore<int> store{2, 0};
+
+  // When: Five updates are applied
+  for (int idx = 1; idx <= 5; ++idx) {
+    store.apply("add", addFn, idx);
+  }
+
+  // Then: Undo can only go back two steps
+  EXPECT_EQ(store.undoDepth(), 2U);
+  EXPECT_EQ(store.stateAt(2), 6);
+}
+
+// Ensure that updates, undo and redo notify the subscription
+TEST(HistoryStateStoreTest, TransitionsNotifySubscription) {
+  // Given: A store with subscription
+  MockFunction<void(const std::string&, const int&, const int&)> subscriptionFn;
+  HistoryStateStore<int> store{10, subscriptionFn.AsStdFunction(), 1};
+
+  // Then: Each transition is notified with its name and states
+  {
+    ::testing::InSequence sequence;
+    EXPECT_CALL(subscriptionFn, Call("add", 1, 3));
+    EXPECT_CALL(subscriptionFn, Call("undo", 3, 1));
+    EXPECT_CALL(subscriptionFn, Call("redo", 1, 3));
+  }
+
+  // When: An update is applied, undone and redone
+  store.apply("add", addFn, 2);
+  store.undo("undo");
+  store.redo("redo");
+}
+
+// Ensure that a 10 MB state with 1000 history entries costs memory proportional to the changes only
+TEST(HistoryStateStoreTest, HistoryOfSharingStateGrowsByChangedPartsOnly) {
+  // Given: A store with a 10 MB state keeping 1000 earlier states
+  HistoryStateStore<ChunkedState> store{1000, ChunkedState{}};
+  const std::size_t stateSize = ChunkedState::kChunkCount * sizeof(Chunk);
+
+  // When: 1000 updates each write a byte to a different chunk
+  for (std::size_t idx = 0; idx < 1000; ++idx) {
+    store.apply("writeByte", writeByteFn, idx * Chunk::kSize, static_cast<char>(1));
+  }
+
+  // Then: The history keeps one chunk per update instead of 1000 full copies (10 GB), and earlier states are intact
+  EXPECT_EQ(store.undoDepth(), 1000U);
+  EXPECT_EQ(Chunk::liveCount, static_cast<int>(ChunkedState::kChunkCount + 1000));
+  EXPECT_LT(historyMemoryOf(store), 4 * stateSize);
+  EXPECT_EQ(byteAt(store.stateAt(0), 999 * Chunk::kSize), 1);
+  EXPECT_EQ(byteAt(store.stateAt(1), 999 * Chunk::kSize), 0);
+  EXPECT_EQ(byteAt(store.stateAt(1000), 0), 0);
+}
+
+// Ensure that states dropped from a bounded history release their memory
+TEST(HistoryStateStoreTest, DroppedStatesReleaseTheirMemory) {
+  // Given: A store with a 10 MB state keeping 10 earlier states
+  HistoryStateStore<ChunkedState> store{10, ChunkedState{}};
+
+  // When: 1000 updates each write a byte to a different chunk
+  for (std::size_t idx = 0; idx < 1000; ++idx) {
+    store.apply("writeByte", writeByteFn, idx * Chunk::kSize, static_cast<char>(1));
+  }
+
+  // Then: Only the chunks written by the last 10 updates are kept in addition to the current state
+  EXPECT_EQ(Chunk::liveCount, static_cast<int>(ChunkedState::kChunkCount + 10));
+}
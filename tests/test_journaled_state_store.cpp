@@ -0,0 +1,291 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "funkypipes/journaled_state_store.hpp"
+
+using namespace funkypipes;
+using ::testing::_;
+using ::testing::MockFunction;
+
+namespace {
+
+struct LogState {
+  std::vector<std::string> entries;
+  int total{0};
+};
+
+auto addFn = [](LogState state, std::string entry, int amount) {
+  state.entries.push_back(std::move(entry));
+  state.total += amount;
+  return state;
+};
+
+auto clearFn = [](LogState state) {
+  state.entries.clear();
+  return state;
+};
+
+auto countFn = [](LogState state) {
+  const auto count = static_cast<int>(state.entries.size());
+  return std::make_tuple(std::move(state), count);
+};
+
+class JournaledStateStoreTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    const auto* testInfo = ::testing::UnitTest::GetInstance()->current_test_info();
+    directory_ = std::filesystem::path{::testing::TempDir()} / (std::string{"funkypipes_"} + testInfo->name());
+    std::filesystem::remove_all(directory_);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(directory_); }
+
+  std::filesystem::path directory_;
+};
+
+}  // namespace
+
+namespace funkypipes {
+
+// Serializes LogState as the entries followed by the total
+template <>
+struct Serialization<LogState> {
+  static void write(std::string& buffer, const LogState& state) {
+    Serialization<std::vector<std::string>>::write(buffer, state.entries);
+    Serialization<int>::write(buffer, state.total);
+  }
+
+  static LogState read(std::string_view& buffer) {
+    LogState state;
+    state.entries = Serialization<std::vector<std::string>>::read(buffer);
+    state.total = Serialization<int>::read(buffer);
+    return state;
+  }
+};
+
+}  // namespace funkypipes
+
+// Ensure that a restarted store restores its state by replaying the journal
+TEST_F(JournaledStateStoreTest, RestoresStateFromJournal) {
+  // Given: A store that applied some updates before being destroyed
+  {
+    JournaledStateStore<LogState> store{directory_, LogState{}};
+    auto add = store.bind<std::string, int>("add", addFn);
+    auto clear = store.bind("clear", clearFn);
+    EXPECT_EQ(store.recover(), 0U);
+    add("a", 1);
+    clear();
+    add("b", 2);
+    add("c", 3);
+  }
+
+  // When: A store using the same directory recovers
+  JournaledStateStore<LogState> store{directory_, LogState{}};
+  auto add = store.bind<std::string, int>("add", addFn);
+  auto clear = store.bind("clear", clearFn);
+  const auto replayCount = store.recover();
+
+  // Then: All updates were replayed
+  EXPECT_EQ(replayCount, 4U);
+  EXPECT_EQ(store.sequence(), 4U);
+  EXPECT_EQ(store.get_state().entries, (std::vector<std::string>{"b", "c"}));
+  EXPECT_EQ(store.get_state().total, 6);
+}
+
+// Ensure that recovery starts from the latest snapshot and replays only the journal records following it
+TEST_F(JournaledStateStoreTest, ReplaysOnlyJournalTailAfterSnapshot) {
+  // Given: A store taking a snapshot every ten updates that applied 25 updates
+  JournalOptions options;
+  options.snapshotInterval = 10;
+  {
+    JournaledStateStore<LogState> store{directory_, LogState{}, options};
+    auto add = store.bind<std::string, int>("add", addFn);
+    store.recover();
+    for (int idx = 0; idx < 25; ++idx) {
+      add(std::to_string(idx), idx);
+    }
+  }
+
+  // When: A store using the same directory recovers
+  JournaledStateStore<LogState> store{directory_, LogState{}, options};
+  auto add = store.bind<std::string, int>("add", addFn);
+  const auto replayCount = store.recover();
+
+  // Then: Only the updates after the snapshot of update 20 were replayed, and updates continue from there
+  EXPECT_EQ(replayCount, 5U);
+  EXPECT_EQ(store.get_state().entries.size(), 25U);
+  EXPECT_EQ(store.get_state().total, 300);
+  add("25", 25);
+  EXPECT_EQ(store.sequence(), 26U);
+}
+
+// Ensure that recovering a store repeatedly neither loses nor duplicates updates
+TEST_F(JournaledStateStoreTest, RepeatedRecoveriesKeepAllUpdates) {
+  // Given: Three store lifetimes each applying updates
+  for (int lifetime = 0; lifetime < 3; ++lifetime) {
+    JournaledStateStore<LogState> store{directory_, LogState{}};
+    auto add = store.bind<std::string, int>("add", addFn);
+    store.recover();
+    add("entry", 1);
+    add("entry", 1);
+  }
+
+  // When: A store using the same directory recovers
+  JournaledStateStore<LogState> store{directory_, LogState{}};
+  auto add = store.bind<std::string, int>("add", addFn);
+  store.recover();
+
+  // Then: The updates of all lifetimes are included exactly once
+  EXPECT_EQ(store.get_state().total, 6);
+  EXPECT_EQ(store.sequence(), 6U);
+}
+
+// Ensure that a record which was written incompletely is ignored on recovery
+TEST_F(JournaledStateStoreTest, IgnoresIncompleteRecordAtJournalEnd) {
+  // Given: A journal whose last record got corrupted
+  JournalOptions options;
+  options.journalFileSize = 4096;
+  {
+    JournaledStateStore<LogState> store{directory_, LogState{}, options};
+    auto add = store.bind<std::string, int>("add", addFn);
+    store.recover();
+    add("a", 1);
+    add("b", 2);
+    add("c", 3);
+  }
+  for (const auto& entry : std::filesystem::directory_iterator{directory_}) {
+    std::string content;
+    {
+      std::ifstream file{entry.path(), std::ios::binary};
+      content.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+    }
+    const auto lastEntryPos = content.rfind('c');
+    ASSERT_NE(lastEntryPos, std::string::npos);
+    content[lastEntryPos] = 'x';
+    std::ofstream{entry.path(), std::ios::binary} << content;
+  }
+
+  // When: A store using the same directory recovers
+  JournaledStateStore<LogState> store{directory_, LogState{}, options};
+  auto add = store.bind<std::string, int>("add", addFn);
+  const auto replayCount = store.recover();
+
+  // Then: The updates before the corrupted record were replayed
+  EXPECT_EQ(replayCount, 2U);
+  EXPECT_EQ(store.get_state().entries, (std::vector<std::string>{"a", "b"}));
+}
+
+// Ensure that updates journaled after recovering from an incomplete record survive another recovery
+TEST_F(JournaledStateStoreTest, KeepsUpdatesAcrossConsecutiveCrashes) {
+  // Given: A journal whose last record got corrupted, and a store that recovered from it, applied another update and
+  // crashed before its snapshot was written
+  JournalOptions options;
+  options.journalFileSize = 4096;
+  options.snapshotInterval = 0;
+  {
+    JournaledStateStore<LogState> store{directory_, LogState{}, options};
+    auto add = store.bind<std::string, int>("add", addFn);
+    store.recover();
+    add("a", 1);
+    add("b", 2);
+    add("c", 3);
+  }
+  for (const auto& entry : std::filesystem::directory_iterator{directory_}) {
+    std::string content;
+    {
+      std::ifstream file{entry.path(), std::ios::binary};
+      content.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+    }
+    content[content.rfind('c')] = 'x';
+    std::ofstream{entry.path(), std::ios::binary} << content;
+  }
+  std::filesystem::create_directory(directory_ / "snapshot-00000000000000000002.tmp");  // Note: fails the snapshot
+  {
+    JournaledStateStore<LogState> store{directory_, LogState{}, options};
+    auto add = store.bind<std::string, int>("add", addFn);
+    EXPECT_EQ(store.recover(), 2U);
+    add("d", 4);
+    store.sync();
+    while (!store.snapshotError()) {
+      std::this_thread::yield();
+    }
+  }
+
+  // When: A store using the same directory recovers again
+  JournaledStateStore<LogState> store{directory_, LogState{}, options};
+  auto add = store.bind<std::string, int>("add", addFn);
+  const auto replayCount = store.recover();
+
+  // Then: The update following the incomplete record was replayed as well
+  EXPECT_EQ(replayCount, 3U);
+  EXPECT_EQ(store.get_state().entries, (std::vector<std::string>{"a", "b", "d"}));
+}
+
+// Ensure that live updates notify the subscription, while replayed updates do not
+TEST_F(JournaledStateStoreTest, NotifiesLiveUpdatesOnly) {
+  // Given: A store that applied an update before being destroyed
+  {
+    JournaledStateStore<LogState> store{directory_, LogState{}};
+    auto add = store.bind<std::string, int>("add", addFn);
+    store.recover();
+    add("a", 1);
+  }
+  MockFunction<void(const std::string&, const LogState&, const LogState&)> subscriptionFn;
+  JournaledStateStore<LogState> store{directory_, subscriptionFn.AsStdFunction(), LogState{}};
+  auto add = store.bind<std::string, int>("add", addFn);
+
+  // Then: Only the update after recovery is notified
+  EXPECT_CALL(subscriptionFn, Call("add", _, _)).Times(1);
+
+  // When: The store recovers and applies another update
+  store.recover();
+  add("b", 2);
+}
+
+// Ensure that bound updates forward their outputs through the transform function
+TEST_F(JournaledStateStoreTest, BindWithTransformForwardsOutputs) {
+  // Given: A store with bound updates
+  JournaledStateStore<LogState> store{directory_, LogState{}};
+  auto add = store.bind<std::string, int>("add", addFn);
+  auto count = store.bind("count", countFn, [](const LogState& state, int entryCount) {
+    return std::to_string(entryCount) + "/" + std::to_string(state.total);
+  });
+  store.recover();
+
+  // When: The updates are applied
+  add("a", 5);
+  const auto result = count();
+
+  // Then: The transform function received the new state and the output
+  EXPECT_EQ(result, "1/5");
+}
+
+// Ensure that sync returns once the updates are durable and applying before recover is rejected
+TEST_F(JournaledStateStoreTest, SyncAndApplyBeforeRecover) {
+  // Given: A store with a bound update that did not recover yet
+  JournaledStateStore<LogState> store{directory_, LogState{}};
+  auto add = store.bind<std::string, int>("add", addFn);
+
+  // When & Then: Applying is rejected until the store recovered
+  EXPECT_THROW(add("a", 1), std::logic_error);
+  store.recover();
+  add("a", 1);
+  store.sync();
+  EXPECT_EQ(store.sequence(), 1U);
+}
@@ -0,0 +1,90 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "funkypipes/lens.hpp"
+#include "funkypipes/persistent_hash_map.hpp"
+#include "funkypipes/persistent_vector.hpp"
+
+using namespace funkypipes;
+
+namespace {
+
+struct Sensor {
+  std::string name;
+  double threshold{0.0};
+  std::vector<double> calibration;
+};
+
+struct Plant {
+  std::map<std::string, Sensor> sensors;
+  PersistentHashMap<int, Sensor> persistentSensors;
+};
+
+}  // namespace
+
+// Ensure that a lens gets and modifies the part reached via data members and std container keys
+TEST(LensTest, FocusesViaMembersAndKeys) {
+  // Given: a nested state and a lens focusing on a calibration value
+  Plant plant;
+  plant.sensors["boiler"] = Sensor{"boiler", 80.0, {1.0, 2.0}};
+  plant.sensors["pump"] = Sensor{"pump", 3.0, {}};
+  const auto calibrationLens = lens(&Plant::sensors, std::string{"boiler"}, &Sensor::calibration, std::size_t{1});
+
+  // When: modifying the focused part
+  calibrationLens.modify(plant, [](double& value) { value = 2.5; });
+
+  // Then: only the focused part is changed
+  EXPECT_EQ(calibrationLens.get(plant), 2.5);
+  EXPECT_EQ(plant.sensors["boiler"].calibration, (std::vector<double>{1.0, 2.5}));
+  EXPECT_EQ(plant.sensors["boiler"].threshold, 80.0);
+  EXPECT_EQ(plant.sensors["pump"].threshold, 3.0);
+}
+
+// Ensure that a lens replaces parts of immutable containers and leaves copies of the original container unchanged
+TEST(LensTest, ReplacesPartsOfImmutableContainers) {
+  // Given: a state holding a persistent map and a copy of that map
+  Plant plant;
+  plant.persistentSensors = plant.persistentSensors.set(7, Sensor{"valve", 1.0, {}});
+  const auto originalSensors = plant.persistentSensors;
+  const auto thresholdLens = lens(&Plant::persistentSensors, 7, &Sensor::threshold);
+
+  // When: modifying the focused part
+  thresholdLens.modify(plant, [](double& threshold) { threshold = 2.0; });
+
+  // Then: the state holds the new value, while the copy still holds the old one
+  EXPECT_EQ(thresholdLens.get(plant), 2.0);
+  EXPECT_EQ(plant.persistentSensors.at(7).name, "valve");
+  EXPECT_EQ(originalSensors.at(7).threshold, 1.0);
+
+  // Then: elements of persistent vectors are replaced likewise
+  PersistentVector<int> vector{1, 2, 3};
+  lens(std::size_t{1}).modify(vector, [](int& value) { value = 20; });
+  EXPECT_EQ(vector, (PersistentVector<int>{1, 20, 3}));
+}
+
+// Ensure that missing keys are reported and leave the state unchanged
+TEST(LensTest, MissingKeyThrows) {
+  // Given: a state without the focused sensor
+  Plant plant;
+  const auto thresholdLens = lens(&Plant::sensors, std::string{"missing"}, &Sensor::threshold);
+  const auto persistentThresholdLens = lens(&Plant::persistentSensors, 1, &Sensor::threshold);
+
+  // When / Then: accessing the focused part throws
+  EXPECT_THROW((void)thresholdLens.get(plant), std::out_of_range);
+  EXPECT_THROW(thresholdLens.modify(plant, [](double&) {}), std::out_of_range);
+  EXPECT_THROW(persistentThresholdLens.modify(plant, [](double&) {}), std::out_of_range);
+  EXPECT_TRUE(plant.sensors.empty());
+  EXPECT_TRUE(plant.persistentSensors.empty());
+}
@@ -0,0 +1,148 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "funkypipes/lens.hpp"
+#include "funkypipes/on_change_subscription.hpp"
+#include "funkypipes/seqlock_state_store.hpp"
+#include "funkypipes/state_store.hpp"
+
+using namespace funkypipes;
+using ::testing::_;
+using ::testing::MockFunction;
+
+namespace {
+
+struct Flags {
+  bool isEnabled{false};
+  std::uint64_t checksum{0};
+  int unhashedCounter{0};
+
+  bool operator==(const Flags& other) const {
+    return isEnabled == other.isEnabled && checksum == other.checksum && unhashedCounter == other.unhashedCounter;
+  }
+};
+
+Flags enable(Flags flags) {
+  flags.isEnabled = true;
+  return flags;
+}
+
+}  // namespace
+
+// Ensure that updates that do not change the state are neither notified nor change the store's version
+TEST(OnChangeSubscriptionTest, UnchangedStatesAreNotStored) {
+  // Given: A store with an on change subscription
+  MockFunction<void(const std::string&, const Flags&, const Flags&)> subscriptionMock;
+  auto store = makeStateStore(Flags{}, makeOnChangeSubscription(subscriptionMock.AsStdFunction()));
+
+  // Then: The subscription is notified about the first update only
+  EXPECT_CALL(subscriptionMock, Call("enable", Flags{}, (Flags{true, 0, 0}))).Times(1);
+
+  // When: The same flag is set repeatedly
+  store.apply("enable", enable);
+  const auto versionAfterChange = store.version();
+  store.apply("enable", enable);
+  store.apply("enable", enable);
+
+  // Then: The version changed with the first update only
+  EXPECT_EQ(versionAfterChange, 1U);
+  EXPECT_EQ(store.version(), 1U);
+}
+
+// Ensure that states can be compared by a hash, ignoring changes that keep the hash
+TEST(OnChangeSubscriptionTest, StatesCanBeComparedByHash) {
+  // Given: A store whose subscription compares the states' checksum
+  MockFunction<void(const std::string&, const Flags&, const Flags&)> subscriptionMock;
+  auto checksumOf = [](const Flags& flags) { return flags.checksum; };
+  auto store =
+      makeStateStore(Flags{}, makeOnChangeSubscription(subscriptionMock.AsStdFunction(), equalByHash(checksumOf)));
+
+  // Then: Only the update changing the checksum is notified
+  EXPECT_CALL(subscriptionMock, Call("setChecksum", _, _)).Times(1);
+
+  // When: One update changes the checksum and one changes another field only
+  store.apply("setChecksum", [](Flags flags) {
+    flags.checksum = 42;
+    return flags;
+  });
+  store.apply("increment", [](Flags flags) {
+    ++flags.unhashedCounter;
+    return flags;
+  });
+
+  // Then: The unchanged update was not stored
+  EXPECT_EQ(store.get_state().unhashedCounter, 0);
+}
+
+// Ensure that updates of a part via a lens that do not change the state are not stored
+TEST(OnChangeSubscriptionTest, UnchangedPartUpdatesAreNotStored) {
+  // Given: A store whose subscription compares the states' checksum
+  MockFunction<void(const std::string&, const Flags&, const Flags&)> subscriptionMock;
+  auto checksumOf = [](const Flags& flags) { return flags.checksum; };
+  auto store =
+      makeStateStore(Flags{}, makeOnChangeSubscription(subscriptionMock.AsStdFunction(), equalByHash(checksumOf)));
+
+  // Then: The update is not notified
+  EXPECT_CALL(subscriptionMock, Call(_, _, _)).Times(0);
+
+  // When: A field that is not part of the checksum is updated via a lens
+  store.applyAt("increment", lens(&Flags::unhashedCounter), [](int counter) { return counter + 1; });
+
+  // Then: The update was not stored
+  EXPECT_EQ(store.get_state().unhashedCounter, 0);
+  EXPECT_EQ(store.version(), 0U);
+}
+
+// Ensure that transactions that do not change the state are not notified
+TEST(OnChangeSubscriptionTest, UnchangedTransactionsAreFiltered) {
+  // Given: A store of a list with an on change subscription accepting lists of update names
+  using UpdateNames = std::vector<std::string>;
+  using List = std::vector<int>;
+  MockFunction<void(const UpdateNames&, const List&, const List&)> subscriptionMock;
+  auto store = makeStateStore(List{1, 2}, makeOnChangeSubscription(subscriptionMock.AsStdFunction()));
+
+  // Then: Only the transaction changing the state is notified
+  EXPECT_CALL(subscriptionMock, Call(UpdateNames{"set"}, _, _)).Times(1);
+
+  // When: Transactions set an element to its value and to another value
+  auto setFirst = [](List state, int value) {
+    state[0] = value;
+    return state;
+  };
+  store.transaction("batch", [&](auto& transaction) { transaction.apply("set", setFirst, 1); });
+  store.transaction("batch", [&](auto& transaction) { transaction.apply("set", setFirst, 5); });
+
+  // Then: The store's version changed once
+  EXPECT_EQ(store.version(), 1U);
+}
+
+// Ensure that a seqlock store neither publishes nor notifies unchanged states
+TEST(OnChangeSubscriptionTest, SeqlockStoreSkipsUnchangedStates) {
+  // Given: A seqlock store with an on change subscription
+  MockFunction<void(const std::string&, const int&, const int&)> subscriptionMock;
+  using Subscription = OnChangeSubscription<std::function<void(const std::string&, const int&, const int&)>>;
+  SeqlockStateStore<int, std::string, Subscription> store{Subscription{subscriptionMock.AsStdFunction()}, 0};
+
+  // Then: Only the change is notified
+  EXPECT_CALL(subscriptionMock, Call("set", 0, 7)).Times(1);
+
+  // When: The state is set to the same value twice
+  store.apply("set", [](int) { return 7; });
+  store.apply("set", [](int) { return 7; });
+
+  // Then: The state is published
+  EXPECT_EQ(store.get_state(), 7);
+}
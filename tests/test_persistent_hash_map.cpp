@@ -0,0 +1,149 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <map>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "funkypipes/persistent_hash_map.hpp"
+
+using namespace funkypipes;
+
+namespace {
+
+// Maps all keys to the same hash, so that all entries collide
+struct ConstantHash {
+  std::size_t operator()(int /*key*/) const { return 7; }
+};
+
+template <typename TMap>
+std::map<int, int> toStdMap(const TMap& map) {
+  return std::map<int, int>(map.begin(), map.end());
+}
+
+}  // namespace
+
+// Ensure that modifications return a new map and leave the original one unchanged
+TEST(PersistentHashMapTest, ModificationsLeaveOriginalUnchanged) {
+  // Given: a map
+  const PersistentHashMap<std::string, int> original{{"a", 1}, {"b", 2}};
+
+  // When: modifying it
+  const auto added = original.set("c", 3);
+  const auto replaced = original.set("a", 10);
+  const auto erased = original.erase("b");
+
+  // Then: only the returned maps are modified
+  EXPECT_EQ(original, (PersistentHashMap<std::string, int>{{"a", 1}, {"b", 2}}));
+  EXPECT_EQ(added.size(), 3U);
+  EXPECT_EQ(*added.find("c"), 3);
+  EXPECT_EQ(*replaced.find("a"), 10);
+  EXPECT_EQ(replaced.size(), 2U);
+  EXPECT_FALSE(erased.contains("b"));
+  EXPECT_EQ(erased.size(), 1U);
+  EXPECT_EQ(original.erase("x"), original);
+}
+
+// Ensure that keys with equal hashes are kept apart
+TEST(PersistentHashMapTest, CollidingKeys) {
+  // Given: a map whose keys all collide
+  PersistentHashMap<int, int, ConstantHash> map;
+  for (int key = 0; key < 10; ++key) {
+    map = map.set(key, key * 10);
+  }
+
+  // When: replacing and erasing some of them
+  const auto modified = map.set(3, -3).erase(5).erase(42);
+
+  // Then: all other keys are still found
+  EXPECT_EQ(map.size(), 10U);
+  EXPECT_EQ(*map.find(3), 30);
+  EXPECT_EQ(modified.size(), 9U);
+  EXPECT_EQ(*modified.find(3), -3);
+  EXPECT_EQ(modified.find(5), nullptr);
+  EXPECT_EQ(*modified.find(9), 90);
+  EXPECT_EQ(toStdMap(modified).size(), 9U);
+}
+
+// Ensure that a transient modifies in place and leaves the map it was created from unchanged
+TEST(PersistentHashMapTest, TransientLeavesSourceUnchanged) {
+  // Given: a map and a transient of it
+  const PersistentHashMap<int, int> source{{1, 1}};
+  auto transient = source.transient();
+
+  // When: modifying the transient
+  for (int key = 0; key < 1000; ++key) {
+    transient.set(key, -key);
+  }
+  transient.erase(500);
+  const auto result = transient.persistent();
+  transient.erase(0);
+
+  // Then: the source is unchanged and the persistent result keeps its state
+  EXPECT_EQ(toStdMap(source), (std::map<int, int>{{1, 1}}));
+  EXPECT_EQ(result.size(), 999U);
+  EXPECT_EQ(*result.find(0), 0);
+  EXPECT_EQ(*result.find(999), -999);
+  EXPECT_FALSE(result.contains(500));
+  EXPECT_EQ(transient.size(), 998U);
+}
+
+// Ensure that transients can be moved but not copied, as copies would modify each other's nodes in place
+TEST(PersistentHashMapTest, TransientIsMoveOnly) {
+  static_assert(!std::is_copy_constructible_v<PersistentHashMap<std::string, int>::Transient>);
+  static_assert(!std::is_copy_assignable_v<PersistentHashMap<std::string, int>::Transient>);
+
+  // Given: a transient of a hash map
+  const PersistentHashMap<std::string, int> source{{"a", 1}};
+  auto transient = source.transient();
+
+  // When: moving and then modifying it
+  auto moved = std::move(transient);
+  moved.set("b", 2);
+  const auto result = moved.persistent();
+
+  // Then: the moved transient carries the modification
+  EXPECT_EQ(result.size(), 2U);
+  EXPECT_EQ(*result.find("b"), 2);
+}
+
+// Ensure that random modifications match those of std::unordered_map, including old versions
+TEST(PersistentHashMapTest, MatchesUnorderedMapForRandomModifications) {
+  std::mt19937 random{42};
+  PersistentHashMap<int, int> map;
+  std::unordered_map<int, int> expected;
+  std::vector<std::pair<PersistentHashMap<int, int>, std::unordered_map<int, int>>> versions;
+
+  for (int step = 0; step < 20000; ++step) {
+    const int key = static_cast<int>(random() % 2000);
+    if (random() % 3 == 0) {
+      map = map.erase(key);
+      expected.erase(key);
+    } else {
+      map = map.set(key, step);
+      expected[key] = step;
+    }
+    if (step % 1000 == 0) {
+      versions.emplace_back(map, expected);
+    }
+  }
+
+  auto toExpected = [](const std::unordered_map<int, int>& map) { return std::map<int, int>(map.begin(), map.end()); };
+  EXPECT_EQ(map.size(), expected.size());
+  EXPECT_EQ(toStdMap(map), toExpected(expected));
+  for (const auto& [oldMap, oldExpected] : versions) {
+    EXPECT_EQ(toStdMap(oldMap), toExpected(oldExpected));
+  }
+}
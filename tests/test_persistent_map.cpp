@@ -0,0 +1,138 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "funkypipes/persistent_map.hpp"
+
+using namespace funkypipes;
+
+namespace {
+
+template <typename TKey, typename TValue>
+std::map<TKey, TValue> toStdMap(const PersistentMap<TKey, TValue>& map) {
+  return std::map<TKey, TValue>(map.begin(), map.end());
+}
+
+}  // namespace
+
+// Ensure that modifications return a new map and leave the original one unchanged
+TEST(PersistentMapTest, ModificationsLeaveOriginalUnchanged) {
+  // Given: a map
+  const PersistentMap<std::string, int> original{{"b", 2}, {"a", 1}};
+
+  // When: modifying it
+  const auto added = original.set("c", 3);
+  const auto replaced = original.set("a", 10);
+  const auto erased = original.erase("b");
+
+  // Then: only the returned maps are modified
+  EXPECT_EQ(toStdMap(original), (std::map<std::string, int>{{"a", 1}, {"b", 2}}));
+  EXPECT_EQ(toStdMap(added), (std::map<std::string, int>{{"a", 1}, {"b", 2}, {"c", 3}}));
+  EXPECT_EQ(toStdMap(replaced), (std::map<std::string, int>{{"a", 10}, {"b", 2}}));
+  EXPECT_EQ(toStdMap(erased), (std::map<std::string, int>{{"a", 1}}));
+  EXPECT_EQ(original.erase("x"), original);
+}
+
+// Ensure that the entries are iterated in ascending key order
+TEST(PersistentMapTest, IteratesInKeyOrder) {
+  // Given: a map filled in descending key order
+  PersistentMap<int, int> map;
+  for (int key = 1000; key > 0; --key) {
+    map = map.set(key, -key);
+  }
+
+  // When: iterating it
+  std::vector<int> keys;
+  for (const auto& [key, value] : map) {
+    EXPECT_EQ(value, -key);
+    keys.push_back(key);
+  }
+
+  // Then: the keys are ascending
+  ASSERT_EQ(keys.size(), 1000U);
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_EQ(keys[i], static_cast<int>(i) + 1);
+  }
+}
+
+// Ensure that a transient modifies in place and leaves the map it was created from unchanged
+TEST(PersistentMapTest, TransientLeavesSourceUnchanged) {
+  // Given: a map and a transient of it
+  const PersistentMap<int, int> source{{1, 1}};
+  auto transient = source.transient();
+
+  // When: modifying the transient
+  for (int key = 0; key < 1000; ++key) {
+    transient.set(key, -key);
+  }
+  transient.erase(500);
+  const auto result = transient.persistent();
+  transient.erase(0);
+
+  // Then: the source is unchanged and the persistent result keeps its state
+  EXPECT_EQ(toStdMap(source), (std::map<int, int>{{1, 1}}));
+  EXPECT_EQ(result.size(), 999U);
+  EXPECT_EQ(*result.find(0), 0);
+  EXPECT_FALSE(result.contains(500));
+  EXPECT_EQ(transient.size(), 998U);
+}
+
+// Ensure that transients can be moved but not copied, as copies would modify each other's nodes in place
+TEST(PersistentMapTest, TransientIsMoveOnly) {
+  static_assert(!std::is_copy_constructible_v<PersistentMap<std::string, int>::Transient>);
+  static_assert(!std::is_copy_assignable_v<PersistentMap<std::string, int>::Transient>);
+
+  // Given: a transient of a map
+  const PersistentMap<std::string, int> source{{"a", 1}};
+  auto transient = source.transient();
+
+  // When: moving and then modifying it
+  auto moved = std::move(transient);
+  moved.set("b", 2);
+  const auto result = moved.persistent();
+
+  // Then: the moved transient carries the modification
+  EXPECT_EQ(result.size(), 2U);
+  EXPECT_EQ(*result.find("b"), 2);
+}
+
+// Ensure that random modifications match those of std::map, including old versions
+TEST(PersistentMapTest, MatchesMapForRandomModifications) {
+  std::mt19937 random{42};
+  PersistentMap<int, int> map;
+  std::map<int, int> expected;
+  std::vector<std::pair<PersistentMap<int, int>, std::map<int, int>>> versions;
+
+  for (int step = 0; step < 20000; ++step) {
+    const int key = static_cast<int>(random() % 2000);
+    if (random() % 3 == 0) {
+      map = map.erase(key);
+      expected.erase(key);
+    } else {
+      map = map.set(key, step);
+      expected[key] = step;
+    }
+    if (step % 1000 == 0) {
+      versions.emplace_back(map, expected);
+    }
+  }
+
+  EXPECT_EQ(map.size(), expected.size());
+  EXPECT_EQ(toStdMap(map), expected);
+  for (const auto& [oldMap, oldExpected] : versions) {
+    EXPECT_EQ(toStdMap(oldMap), oldExpected);
+  }
+}
@@ -0,0 +1,187 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "funkypipes/persistent_vector.hpp"
+#include "funkypipes/state_store.hpp"
+
+using namespace funkypipes;
+
+namespace {
+
+template <typename T>
+std::vector<T> toStdVector(const PersistentVector<T>& vector) {
+  return std::vector<T>(vector.begin(), vector.end());
+}
+
+}  // namespace
+
+// Ensure that modifications return a new vector and leave the original one unchanged
+TEST(PersistentVectorTest, ModificationsLeaveOriginalUnchanged) {
+  // Given: a vector spanning several leaves
+  PersistentVector<int> original;
+  for (int i = 0; i < 100; ++i) {
+    original = original.push_back(i);
+  }
+
+  // When: modifying it
+  const auto pushed = original.push_back(100);
+  const auto set = original.set(10, -10);
+  const auto poppedBack = original.pop_back();
+  const auto poppedFront = original.pop_front();
+
+  // Then: only the returned vectors are modified
+  ASSERT_EQ(original.size(), 100U);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(original[static_cast<std::size_t>(i)], i);
+  }
+  EXPECT_EQ(pushed.size(), 101U);
+  EXPECT_EQ(pushed.back(), 100);
+  EXPECT_EQ(set[10], -10);
+  EXPECT_EQ(set[11], 11);
+  EXPECT_EQ(poppedBack.size(), 99U);
+  EXPECT_EQ(poppedBack.back(), 98);
+  EXPECT_EQ(poppedFront.size(), 99U);
+  EXPECT_EQ(poppedFront.front(), 1);
+}
+
+// Ensure that the vector serves as a queue beyond the size of a single leaf
+TEST(PersistentVectorTest, SlidingWindow) {
+  // Given: a window of 50 elements
+  constexpr int kWindowSize = 50;
+  PersistentVector<int> window;
+
+  // When: pushing many elements while dropping the oldest ones
+  for (int i = 0; i < 5000; ++i) {
+    window = window.push_back(i);
+    if (window.size() > kWindowSize) {
+      window = window.pop_front();
+    }
+  }
+
+  // Then: the window holds the latest elements in order
+  ASSERT_EQ(window.size(), static_cast<std::size_t>(kWindowSize));
+  int expected = 5000 - kWindowSize;
+  for (int value : window) {
+    EXPECT_EQ(value, expected++);
+  }
+}
+
+// Ensure that at reports indices out of range
+TEST(PersistentVectorTest, AtThrowsOutOfRange) {
+  const PersistentVector<std::string> vector{"a", "b"};
+
+  EXPECT_EQ(vector.at(1), "b");
+  EXPECT_THROW((void)vector.at(2), std::out_of_range);
+  EXPECT_THROW((void)vector.pop_front().pop_front().at(0), std::out_of_range);
+}
+
+// Ensure that a transient modifies in place and leaves the vector it was created from unchanged
+TEST(PersistentVectorTest, TransientLeavesSourceUnchanged) {
+  // Given: a vector and a transient of it
+  const PersistentVector<int> source{1, 2, 3};
+  auto transient = source.transient();
+
+  // When: modifying the transient
+  for (int i = 4; i <= 1000; ++i) {
+    transient.push_back(i);
+  }
+  transient.set(0, 0);
+  transient.pop_front();
+  const auto first = transient.persistent();
+  transient.pop_back();
+  const auto second = transient.persistent();
+
+  // Then: the source is unchanged and each persistent result keeps its state
+  EXPECT_EQ(toStdVector(source), (std::vector<int>{1, 2, 3}));
+  ASSERT_EQ(first.size(), 999U);
+  EXPECT_EQ(first.front(), 2);
+  EXPECT_EQ(first.back(), 1000);
+  ASSERT_EQ(second.size(), 998U);
+  EXPECT_EQ(second.back(), 999);
+}
+
+// Ensure that transients can be moved but not copied, as copies would modify each other's nodes in place
+TEST(PersistentVectorTest, TransientIsMoveOnly) {
+  static_assert(!std::is_copy_constructible_v<PersistentVector<int>::Transient>);
+  static_assert(!std::is_copy_assignable_v<PersistentVector<int>::Transient>);
+
+  // Given: a transient of a vector
+  const PersistentVector<int> source{1, 2, 3};
+  auto transient = source.transient();
+
+  // When: moving and then modifying it
+  auto moved = std::move(transient);
+  moved.push_back(4);
+  const auto result = moved.persistent();
+
+  // Then: the moved transient carries the modification
+  EXPECT_EQ(result.size(), 4U);
+  EXPECT_EQ(result.back(), 4);
+}
+
+// Ensure that random modifications match those of std::deque, including old versions
+TEST(PersistentVectorTest, MatchesDequeForRandomModifications) {
+  std::mt19937 random{42};
+  PersistentVector<int> vector;
+  std::deque<int> expected;
+  std::vector<std::pair<PersistentVector<int>, std::deque<int>>> versions;
+
+  for (int step = 0; step < 20000; ++step) {
+    const auto operation = random() % 10;
+    if (expected.empty() || operation < 5) {
+      vector = vector.push_back(step);
+      expected.push_back(step);
+    } else if (operation < 7) {
+      vector = vector.pop_front();
+      expected.pop_front();
+    } else if (operation < 8) {
+      vector = vector.pop_back();
+      expected.pop_back();
+    } else {
+      const std::size_t index = random() % expected.size();
+      vector = vector.set(index, -step);
+      expected[index] = -step;
+    }
+    if (step % 1000 == 0) {
+      versions.emplace_back(vector, expected);
+    }
+  }
+
+  EXPECT_EQ(toStdVector(vector), std::vector<int>(expected.begin(), expected.end()));
+  for (const auto& [oldVector, oldExpected] : versions) {
+    EXPECT_EQ(toStdVector(oldVector), std::vector<int>(oldExpected.begin(), oldExpected.end()));
+  }
+}
+
+// Ensure that the vector is usable as state of a StateStore updated by pure functions
+TEST(PersistentVectorTest, StateOfStateStore) {
+  // Given: a store holding a persistent vector
+  StateStore<PersistentVector<double>> store;
+  auto addSample = store.bind("addSample", [](PersistentVector<double> samples, double sample) {
+    samples = samples.push_back(sample);
+    return samples.size() > 3 ? samples.pop_front() : samples;
+  });
+
+  // When: adding samples
+  for (double sample : {1.0, 2.0, 3.0, 4.0, 5.0}) {
+    addSample(sample);
+  }
+
+  // Then: the store holds the latest samples
+  EXPECT_EQ(store.get_state(), (PersistentVector<double>{3.0, 4.0, 5.0}));
+}
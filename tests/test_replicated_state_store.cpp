@@ -0,0 +1,100 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "funkypipes/replicated_state_store.hpp"
+
+using namespace funkypipes;
+
+// Ensure that a store without updates holds the identity
+TEST(ReplicatedStateStoreTest, InitialStateIsIdentity) {
+  // When: A store is created with an identity
+  ReplicatedStateStore<int> store{[](int lhs, int rhs) { return lhs * rhs; }, 1};
+
+  // Then: Its state is the identity
+  EXPECT_EQ(store.get_state(), 1);
+}
+
+// Ensure that updates are applied and their outputs returned, transformed if requested
+TEST(ReplicatedStateStoreTest, ApplyAndTransform) {
+  // Given: A counter store
+  ReplicatedStateStore<int> store{std::plus<>{}};
+
+  // When: Updates are applied, one with an output and one with a transform function
+  auto output = store.apply([](int count, int summand) { return std::make_tuple(count + summand, count); }, 5);
+  const int transformed =
+      store.applyAndTransform([](int count) { return count + 1; }, [](int count) { return -count; });
+
+  // Then: The state reflects both updates and the outputs are returned
+  EXPECT_EQ(output, 0);
+  EXPECT_EQ(transformed, -6);
+  EXPECT_EQ(store.get_state(), 6);
+}
+
+// Ensure that the updates of all threads are merged
+TEST(ReplicatedStateStoreTest, UpdatesOfAllThreadsAreMerged) {
+  // Given: A histogram store and a bound update function counting a sample
+  using Histogram = std::array<int, 4>;
+  auto mergeFn = [](Histogram lhs, const Histogram& rhs) {
+    std::transform(lhs.begin(), lhs.end(), rhs.begin(), lhs.begin(), std::plus<>{});
+    return lhs;
+  };
+  ReplicatedStateStore<Histogram> store{mergeFn};
+  auto addSample = store.bind([](Histogram histogram, std::size_t bucket) {
+    ++histogram.at(bucket);
+    return histogram;
+  });
+
+  // When: Several threads add samples concurrently
+  constexpr int kThreadCount = 4;
+  constexpr int kSampleCount = 1000;
+  std::vector<std::thread> threads;
+  for (int thread = 0; thread < kThreadCount; ++thread) {
+    threads.emplace_back([&addSample] {
+      for (int sample = 0; sample < kSampleCount; ++sample) {
+        addSample(static_cast<std::size_t>(sample) % 4);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // Then: The merged state holds the samples of all threads
+  const Histogram expected{kThreadCount * kSampleCount / 4, kThreadCount * kSampleCount / 4,
+                           kThreadCount * kSampleCount / 4, kThreadCount * kSampleCount / 4};
+  EXPECT_EQ(store.get_state(), expected);
+}
+
+// Ensure that a thread alternating between stores updates its own replica of each
+TEST(ReplicatedStateStoreTest, AlternatingStoresKeepSeparateReplicas) {
+  // Given: Two counter stores of the same type
+  ReplicatedStateStore<int> first{std::plus<>{}};
+  ReplicatedStateStore<int> second{std::plus<>{}};
+  auto increment = [](int count) { return count + 1; };
+
+  // When: A thread alternates between them
+  for (int count = 0; count < 3; ++count) {
+    first.apply(increment);
+    second.apply(increment);
+    second.apply(increment);
+  }
+
+  // Then: Each store holds its own updates
+  EXPECT_EQ(first.get_state(), 3);
+  EXPECT_EQ(second.get_state(), 6);
+}
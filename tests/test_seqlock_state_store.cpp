@@ -0,0 +1,143 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "funkypipes/seqlock_state_store.hpp"
+
+using namespace funkypipes;
+using ::testing::MockFunction;
+
+namespace {
+
+// A trivially copyable state whose elements are expected to be equal at any time
+struct UniformState {
+  std::array<long, 16> values;
+};
+
+}  // namespace
+
+// Ensure that an initial state can be set
+TEST(SeqlockStateStoreTest, InitialStateOnly) {
+  // When: A store initialized with a given initial state
+  SeqlockStateStore<int> store{10};
+
+  // Then: The given initial state is active
+  EXPECT_EQ(store.get_state(), 10);
+}
+
+// Ensure that state is updated by [state,input->state] update function
+TEST(SeqlockStateStoreTest, ApplyingUpdateFunctionThatTakesInputAffectsState) {
+  // Given: A default initialized store
+  SeqlockStateStore<int> store;
+
+  // When: An update function taking input modifies the state
+  store.apply("increment", [](int state, int amount) { return state + amount; }, 2);
+
+  // Then: The store's state is updated
+  EXPECT_EQ(store.get_state(), 2);
+}
+
+// Ensure that output is returned when applying [state->state,output1,output2] update function
+TEST(SeqlockStateStoreTest, ApplyReturnsMultipleOutputs) {
+  // Given: A default initialized store
+  SeqlockStateStore<int> store;
+
+  // When: An update function returns a tuple with state change and additional outputs
+  const auto result = store.apply("incrementAndGetStringAndDouble", [](int state) {
+    ++state;
+    return std::make_tuple(state, std::to_string(state), state * 2);
+  });
+
+  // Then: The outputs are returned as tuple and the state is updated
+  EXPECT_EQ(result, std::make_tuple(std::string{"1"}, 2));
+  EXPECT_EQ(store.get_state(), 1);
+}
+
+// Ensure that transforming state based on [state->state,output] update function works
+TEST(SeqlockStateStoreTest, ApplyAndTransformReturnsBasedOnSingleOutput) {
+  // Given: A default initialized store
+  SeqlockStateStore<int> store;
+
+  // When: An update function provides state + output to a transformation function
+  auto updateFn = [](int state) { return std::make_tuple(++state, "output"); };
+  auto transformFn = [](int state, const char* output) { return std::to_string(state) + "," + output; };
+  auto result = store.applyAndTransform("incrementAndReturnString", updateFn, transformFn);
+
+  // Then: The transformation got applied
+  EXPECT_EQ(result, "1,output");
+}
+
+// Ensure that a bound update function updates the state and calls the subscription with correct arguments
+TEST(SeqlockStateStoreTest, BindCallsSubscriptionFunction) {
+  // Given: A update function bound to a store that has a subscription
+  MockFunction<void(const std::string&, const int&, const int&)> subscriptionFn;
+  SeqlockStateStore<int> store(subscriptionFn.AsStdFunction());
+  auto boundUpdateFn = store.bind("increment", [](int state) { return ++state; });
+
+  // Then: Subscription called with correct parameters
+  EXPECT_CALL(subscriptionFn, Call("increment", 0, 1));
+
+  // When: Update function is applied
+  boundUpdateFn();
+  EXPECT_EQ(store.get_state(), 1);
+}
+
+// Ensure that readers never observe a partially written state while updates are applied concurrently
+TEST(SeqlockStateStoreTest, ConcurrentReadersObserveConsistentStates) {
+  // Given: A store holding a multi word state and a pure update function keeping all elements equal
+  SeqlockStateStore<UniformState> store;
+  auto incrementAllFn = [](UniformState state) {
+    for (auto& value : state.values) {
+      ++value;
+    }
+    return state;
+  };
+
+  // When: Several readers copy the state while a writer updates it
+  std::atomic<bool> writerDone{false};
+  std::atomic<int> inconsistentReads{0};
+  std::vector<std::thread> readers;
+  for (int idx = 0; idx < 4; ++idx) {
+    readers.emplace_back([&] {
+      long lastSeen = 0;
+      while (!writerDone.load()) {
+        const auto state = store.get_state();
+        for (const auto value : state.values) {
+          if (value != state.values[0]) {
+            ++inconsistentReads;
+          }
+        }
+        if (state.values[0] < lastSeen) {
+          ++inconsistentReads;
+        }
+        lastSeen = state.values[0];
+      }
+    });
+  }
+  const int updateCount = 20000;
+  for (int idx = 0; idx < updateCount; ++idx) {
+    store.apply("incrementAll", incrementAllFn);
+  }
+  writerDone = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  // Then: Every observed state was consistent and monotonic, and all updates got published
+  EXPECT_EQ(inconsistentReads.load(), 0);
+  EXPECT_EQ(store.get_state().values[15], updateCount);
+}
@@ -0,0 +1,72 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "funkypipes/serialization.hpp"
+#include "funkypipes/update_id.hpp"
+
+using namespace funkypipes;
+
+namespace {
+
+struct Point {
+  double x;
+  double y;
+};
+
+// Writes the value and reads it back
+template <typename T>
+T roundTrip(const T& value) {
+  std::string buffer;
+  Serialization<T>::write(buffer, value);
+  std::string_view view{buffer};
+  T result = Serialization<T>::read(view);
+  EXPECT_TRUE(view.empty());
+  return result;
+}
+
+}  // namespace
+
+// Ensure that trivially copyable values survive a round trip
+TEST(SerializationTest, TriviallyCopyableRoundTrip) {
+  EXPECT_EQ(roundTrip(42), 42);
+  const auto point = roundTrip(Point{1.5, -2.0});
+  EXPECT_EQ(point.x, 1.5);
+  EXPECT_EQ(point.y, -2.0);
+}
+
+// Ensure that strings and vectors survive a round trip
+TEST(SerializationTest, StringAndVectorRoundTrip) {
+  EXPECT_EQ(roundTrip(std::string{"funky"}), "funky");
+  EXPECT_EQ(roundTrip(std::vector<int>{1, 2, 3}), (std::vector<int>{1, 2, 3}));
+  EXPECT_EQ(roundTrip(std::vector<std::string>{"a", "", "bc"}), (std::vector<std::string>{"a", "", "bc"}));
+}
+
+// Ensure that update ids are serialized by their name
+TEST(SerializationTest, UpdateIdRoundTripsByName) {
+  std::string buffer;
+  Serialization<UpdateId>::write(buffer, UpdateId{"serializedUpdate"});
+
+  EXPECT_NE(buffer.find("serializedUpdate"), std::string::npos);
+  EXPECT_EQ(roundTrip(UpdateId{"serializedUpdate"}), UpdateId{"serializedUpdate"});
+}
+
+// Ensure that reading beyond the buffer is rejected
+TEST(SerializationTest, ReadingTruncatedBufferThrows) {
+  std::string buffer;
+  Serialization<std::string>::write(buffer, "truncated");
+  std::string_view view{buffer.data(), buffer.size() - 1};
+
+  EXPECT_THROW(Serialization<std::string>::read(view), std::out_of_range);
+}
@@ -0,0 +1,148 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "funkypipes/sharded_state_store.hpp"
+
+using namespace funkypipes;
+using ::testing::MockFunction;
+
+// Ensure that updates apply to the value of their key only, starting from a default constructed value
+TEST(ShardedStateStoreTest, ApplyUpdatesValueOfKey) {
+  // Given: A store with several shards
+  ShardedStateStore<std::string, int> store{4};
+
+  // When: Updates are applied to different keys
+  store.apply("add", "a", [](int value, int summand) { return value + summand; }, 2);
+  store.apply("add", "a", [](int value, int summand) { return value + summand; }, 3);
+  store.apply("add", "b", [](int value, int summand) { return value + summand; }, 7);
+
+  // Then: Each key holds the result of its own updates
+  EXPECT_EQ(store.get("a"), 5);
+  EXPECT_EQ(store.get("b"), 7);
+  EXPECT_EQ(store.get("c"), std::nullopt);
+}
+
+// Ensure that additional outputs of update functions are returned
+TEST(ShardedStateStoreTest, ApplyReturnsOutputs) {
+  // Given: A store
+  ShardedStateStore<int, int> store{2};
+
+  // When: An update function returning an additional output is applied
+  auto output = store.apply("increment", 1, [](int value) { return std::make_tuple(value + 1, value * 10); });
+
+  // Then: The output is returned
+  EXPECT_EQ(output, 0);
+  EXPECT_EQ(store.get(1), 1);
+}
+
+// Ensure that bound update functions take the key and pass their result to the transform function
+TEST(ShardedStateStoreTest, BindAndTransform) {
+  // Given: A store and bound update functions, one with a transform function
+  ShardedStateStore<int, int> store{3};
+  auto add = store.bind("add", [](int value, int summand) { return value + summand; });
+  auto addAndDouble =
+      store.bind("add", [](int value, int summand) { return value + summand; }, [](int value) { return value * 2; });
+
+  // When: The bound functions are called
+  add(5, 1);
+  const int doubled = addAndDouble(5, 2);
+
+  // Then: The updates are applied to the given key and the transform function's result is returned
+  EXPECT_EQ(store.get(5), 3);
+  EXPECT_EQ(doubled, 6);
+}
+
+// Ensure that the subscription is notified with the update name, the key, the old value and the new value
+TEST(ShardedStateStoreTest, SubscriptionIsNotifiedPerKey) {
+  // Given: A store with a subscription and a key that was set
+  MockFunction<void(const std::string&, const int&, const int&, const int&)> subscriptionMock;
+  ShardedStateStore<int, int> store{2, subscriptionMock.AsStdFunction()};
+  EXPECT_CALL(subscriptionMock, Call("set", 3, 0, 10));
+  store.apply("set", 3, [](int) { return 10; });
+
+  // Then: The subscription is notified about the update of the key
+  EXPECT_CALL(subscriptionMock, Call("add", 3, 10, 15));
+
+  // When: An update is applied
+  store.apply("add", 3, [](int value) { return value + 5; });
+}
+
+// Ensure that concurrent updates of the same and of different keys are all applied
+TEST(ShardedStateStoreTest, ConcurrentUpdatesAreSerializedPerKey) {
+  // Given: A store and several threads incrementing a few keys each
+  constexpr int kThreadCount = 4;
+  constexpr int kKeyCount = 16;
+  constexpr int kIncrementCount = 500;
+  ShardedStateStore<int, int> store{8};
+  auto increment = store.bind("increment", [](int value) { return value + 1; });
+
+  // When: All threads increment all keys concurrently
+  std::vector<std::thread> threads;
+  for (int thread = 0; thread < kThreadCount; ++thread) {
+    threads.emplace_back([&increment] {
+      for (int count = 0; count < kIncrementCount; ++count) {
+        for (int key = 0; key < kKeyCount; ++key) {
+          increment(key);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // Then: No increment is lost
+  for (int key = 0; key < kKeyCount; ++key) {
+    EXPECT_EQ(store.get(key), kThreadCount * kIncrementCount);
+  }
+}
+
+// Ensure that a snapshot holds the values of all keys and is not affected by later updates
+TEST(ShardedStateStoreTest, SnapshotIsIsolatedFromLaterUpdates) {
+  // Given: A store holding some values
+  ShardedStateStore<int, int> store{4};
+  auto setValue = store.bind("set", [](int, int value) { return value; });
+  for (int key = 0; key < 10; ++key) {
+    setValue(key, key * 10);
+  }
+
+  // When: A snapshot is taken and then the store is updated
+  const auto snapshot = store.snapshot();
+  setValue(3, -1);
+  setValue(42, 42);
+
+  // Then: The snapshot holds the values at the time it was taken
+  EXPECT_EQ(snapshot.size(), 10U);
+  EXPECT_EQ(snapshot.at(3), 30);
+  EXPECT_FALSE(snapshot.contains(42));
+  EXPECT_THROW(std::ignore = snapshot.at(42), std::out_of_range);
+  std::map<int, int> values;
+  snapshot.forEach([&values](int key, int value) { values.emplace(key, value); });
+  EXPECT_EQ(values.size(), 10U);
+  EXPECT_EQ(values.at(9), 90);
+
+  // Then: The store holds the updated values
+  EXPECT_EQ(store.get(3), -1);
+  EXPECT_EQ(store.get(42), 42);
+}
+
+// Ensure that a store without shards is rejected
+TEST(ShardedStateStoreTest, ZeroShardsThrows) {
+  EXPECT_THROW((ShardedStateStore<int, int>{0}), std::invalid_argument);
+}
@@ -0,0 +1,205 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#include <fcntl.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <tuple>
+
+#include "funkypipes/on_change_subscription.hpp"
+#include "funkypipes/shared_memory_state_store.hpp"
+
+using namespace funkypipes;
+using ::testing::MockFunction;
+
+namespace {
+
+struct Position {
+  double x;
+  double y;
+};
+
+// Returns a segment name that is unique for the running test process
+std::string uniqueSegmentName(const std::string& suffix) {
+  return "/funkypipes_test_" + std::to_string(::getpid()) + "_" + suffix;
+}
+
+}  // namespace
+
+// Ensure that a reader observes the initial state written by the store
+TEST(SharedMemoryStateStoreTest, ReaderObservesInitialState) {
+  // Given: A store created with an initial state
+  const auto segmentName = uniqueSegmentName("initial");
+  SharedMemoryStateStore<Position> store{segmentName, Position{1.0, 2.0}};
+
+  // When: A reader maps the segment
+  SharedMemoryStateReader<Position> reader{segmentName};
+
+  // Then: The initial state is visible to the reader
+  EXPECT_EQ(reader.get_state().x, 1.0);
+  EXPECT_EQ(reader.get_state().y, 2.0);
+  EXPECT_EQ(reader.version(), 0U);
+}
+
+// Ensure that applied and bound updates are published to the reader and returning outputs works
+TEST(SharedMemoryStateStoreTest, ReaderObservesUpdates) {
+  // Given: A store with a reader
+  const auto segmentName = uniqueSegmentName("updates");
+  SharedMemoryStateStore<int> store{segmentName, 0};
+  SharedMemoryStateReader<int> reader{segmentName};
+
+  // When: Updates are applied directly and via a bound update function
+  const auto output = store.apply("incrementAndGetDouble", [](int state) {
+    ++state;
+    return std::make_tuple(state, state * 2);
+  });
+  auto addFn = store.bind("add", [](int state, int amount) { return state + amount; });
+  addFn(10);
+
+  // Then: Outputs are returned and the reader sees the latest state
+  EXPECT_EQ(output, 2);
+  EXPECT_EQ(store.get_state(), 11);
+  EXPECT_EQ(reader.get_state(), 11);
+  EXPECT_EQ(reader.version(), 2U);
+}
+
+// Ensure that the subscription function is called in the writer process
+TEST(SharedMemoryStateStoreTest, ApplyAndTransformCallsSubscriptionFunction) {
+  // Given: A store initialized with subscription
+  MockFunction<void(const std::string&, const int&, const int&)> subscriptionFn;
+  SharedMemoryStateStore<int> store{uniqueSegmentName("subscription"), subscriptionFn.AsStdFunction()};
+
+  // Then: Subscription called with correct parameters
+  EXPECT_CALL(subscriptionFn, Call("incrementAndReturnString", 0, 1));
+
+  // When: Update function is applied
+  auto result = store.applyAndTransform(
+      "incrementAndReturnString", [](int state) { return ++state; }, [](int state) { return std::to_string(state); });
+  EXPECT_EQ(result, "1");
+}
+
+// Ensure that updates that do not change the state are neither published nor notified with an on change subscription
+TEST(SharedMemoryStateStoreTest, UnchangedStatesAreNotPublished) {
+  // Given: A store with an on change subscription and a reader
+  MockFunction<void(const std::string&, const int&, const int&)> subscriptionMock;
+  using Subscription = OnChangeSubscription<std::function<void(const std::string&, const int&, const int&)>>;
+  const auto segmentName = uniqueSegmentName("unchanged");
+  SharedMemoryStateStore<int, std::string, Subscription> store{
+      segmentName, Subscription{subscriptionMock.AsStdFunction()}, 0};
+  SharedMemoryStateReader<int> reader{segmentName};
+
+  // Then: Only the change is notified
+  EXPECT_CALL(subscriptionMock, Call("set", 0, 7)).Times(1);
+
+  // When: The state is set to the same value twice
+  store.apply("set", [](int) { return 7; });
+  store.apply("set", [](int) { return 7; });
+
+  // Then: The reader observes a single update
+  EXPECT_EQ(reader.get_state(), 7);
+  EXPECT_EQ(reader.version(), 1U);
+}
+
+// Ensure that a store replacing the segment of the same name leaves readers of the previous segment unaffected
+TEST(SharedMemoryStateStoreTest, ReaderKeepsReplacedSegment) {
+  // Given: A store with a reader
+  const auto segmentName = uniqueSegmentName("replaced");
+  SharedMemoryStateStore<int> store{segmentName, 1};
+  SharedMemoryStateReader<int> reader{segmentName};
+
+  // When: Another store with the same segment name is created and updated
+  SharedMemoryStateStore<int> replacingStore{segmentName, 2};
+  replacingStore.apply("increment", [](int state) { return state + 1; });
+
+  // Then: The reader keeps observing the previous segment, while new readers observe the new one
+  EXPECT_EQ(reader.get_state(), 1);
+  EXPECT_EQ(SharedMemoryStateReader<int>{segmentName}.get_state(), 3);
+}
+
+// Ensure that reading a segment whose writer died while publishing an update fails instead of spinning forever
+TEST(SharedMemoryStateStoreTest, ReaderOfAbandonedSegmentFails) {
+  // Given: A store whose segment is left in the middle of publishing an update, as by a writer that died meanwhile
+  const auto segmentName = uniqueSegmentName("abandoned");
+  SharedMemoryStateStore<int> store{segmentName, 1};
+  const int fd = ::shm_open(segmentName.c_str(), O_RDWR, 0);
+  ASSERT_NE(fd, -1);
+  constexpr std::size_t kSegmentSize = sizeof(details::SharedMemoryStateSegment<int>);
+  void* address = ::mmap(nullptr, kSegmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  ASSERT_NE(address, MAP_FAILED);
+  // Note: the seqlock's sequence number is its first member, an odd one marks a store in progress
+  auto* sequence = reinterpret_cast<std::atomic<std::uint64_t>*>(
+      static_cast<char*>(address) + offsetof(details::SharedMemoryStateSegment<int>, state));
+  sequence->fetch_add(1);
+
+  // When: A reader reads the state
+  SharedMemoryStateReader<int> reader{segmentName, std::chrono::milliseconds{10}};
+
+  // Then: No state can be read
+  EXPECT_EQ(reader.try_get_state(), std::nullopt);
+  EXPECT_THROW(static_cast<void>(reader.get_state()), std::system_error);
+  ::munmap(address, kSegmentSize);
+}
+
+// Ensure that opening a segment that does not exist fails
+TEST(SharedMemoryStateStoreTest, ReaderOfMissingSegmentThrows) {
+  EXPECT_THROW(SharedMemoryStateReader<int>{uniqueSegmentName("missing")}, std::system_error);
+}
+
+// Ensure that opening a segment holding a different state type fails
+TEST(SharedMemoryStateStoreTest, ReaderOfDifferentStateTypeThrows) {
+  const auto segmentName = uniqueSegmentName("mismatch");
+  SharedMemoryStateStore<char> store{segmentName, 'a'};
+
+  EXPECT_THROW(SharedMemoryStateReader<Position>{segmentName}, std::system_error);
+}
+
+// Ensure that a reader in another process observes consistent states while the store is updated
+TEST(SharedMemoryStateStoreTest, ReaderInOtherProcessObservesConsistentStates) {
+  // Given: A store whose updates keep x and y equal
+  const auto segmentName = uniqueSegmentName("process");
+  SharedMemoryStateStore<Position> store{segmentName, Position{0.0, 0.0}};
+  const int updateCount = 20000;
+
+  // When: A child process reads until it observed the final state while the parent applies updates
+  const pid_t child = ::fork();
+  ASSERT_NE(child, -1);
+  if (child == 0) {
+    SharedMemoryStateReader<Position> reader{segmentName};
+    for (;;) {
+      const auto state = reader.get_state();
+      if (state.x != state.y) {
+        ::_exit(1);
+      }
+      if (state.x == updateCount) {
+        ::_exit(0);
+      }
+    }
+  }
+  for (int idx = 0; idx < updateCount; ++idx) {
+    store.apply("move", [](Position position) { return Position{position.x + 1.0, position.y + 1.0}; });
+  }
+
+  // Then: The child terminates successfully
+  int status = 0;
+  ASSERT_EQ(::waitpid(child, &status, 0), child);
+  ASSERT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+}
@@ -0,0 +1,96 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "funkypipes/stage_registry.hpp"
+
+using namespace funkypipes;
+
+namespace {
+
+StageRegistry makeRegistry() {
+  StageRegistry registry;
+  registry.add<int, int>("clamp", [](const StageParameters& parameters) {
+    return [max = parameters.get<int>("max")](int value) { return std::min(value, max); };
+  });
+  registry.add<int, int>("dropNegative", [](const StageParameters& /*parameters*/) {
+    return [](int value) -> std::optional<int> { return value < 0 ? std::nullopt : std::make_optional(value); };
+  });
+  registry.add<int, std::tuple<std::string, int>>("label", [](const StageParameters& parameters) {
+    return [label = parameters.get<std::string>("label")](int value) { return std::make_tuple(label, value); };
+  });
+  registry.add<std::tuple<std::string, int>, std::string>("format", [](const StageParameters& /*parameters*/) {
+    return [](const std::string& label, int value) { return label + "=" + std::to_string(value); };
+  });
+  return registry;
+}
+
+}  // namespace
+
+// Ensure that a pipe built from configuration runs its stages in order with their parameters
+TEST(StageRegistryTest, BuildsPipeFromConfiguration) {
+  // Given: A registry and a configuration of stages
+  const StageRegistry registry = makeRegistry();
+  const std::vector<StageConfig> configs{
+      {"clamp", {{"max", "10"}}}, {"label", {{"label", "level"}}}, {"format", {}}};
+
+  // When: A pipe is built and invoked
+  auto pipe = registry.build<int, std::string>(configs);
+
+  // Then: All stages were applied, with tuples unpacked for the stage taking their elements
+  EXPECT_EQ(pipe.size(), 3U);
+  EXPECT_EQ(pipe(42), std::optional<std::string>{"level=10"});
+  EXPECT_EQ(pipe(7), std::optional<std::string>{"level=7"});
+}
+
+// Ensure that stages returning an empty optional break the chain
+TEST(StageRegistryTest, StagesBreakTheChain) {
+  // Given: A pipe with a stage dropping negative values
+  const StageRegistry registry = makeRegistry();
+  auto pipe = registry.build<int, int>({{"dropNegative", {}}, {"clamp", {{"max", "5"}}}});
+
+  // When: The pipe is invoked with a negative and a positive value
+  // Then: The chain breaks for the negative value only
+  EXPECT_EQ(pipe(-1), std::nullopt);
+  EXPECT_EQ(pipe(9), std::optional<int>{5});
+}
+
+// Ensure that configurations of unknown stages or mismatching types are rejected on build
+TEST(StageRegistryTest, InvalidConfigurationsAreRejected) {
+  // Given: A registry
+  const StageRegistry registry = makeRegistry();
+
+  // When: Pipes are built from invalid configurations
+  // Then: They are rejected
+  EXPECT_THROW(static_cast<void>(registry.build<int, int>({{"unknown", {}}})), std::invalid_argument);
+  EXPECT_THROW(static_cast<void>(registry.build<int, int>({{"label", {{"label", "x"}}}})), std::invalid_argument);
+  EXPECT_THROW(static_cast<void>(registry.build<int, std::string>({{"format", {}}})), std::invalid_argument);
+  EXPECT_THROW(static_cast<void>(registry.build<int, int>({{"clamp", {}}})), std::invalid_argument);
+  EXPECT_THROW(static_cast<void>(registry.build<int, int>({{"clamp", {{"max", "ten"}}}})), std::invalid_argument);
+  EXPECT_NO_THROW(static_cast<void>(registry.build<int, int>({})));
+}
+
+// Ensure that stage names are unique
+TEST(StageRegistryTest, StageNamesAreUnique) {
+  // Given: A registry
+  StageRegistry registry = makeRegistry();
+
+  // When: A stage is registered under an existing name
+  // Then: It is rejected
+  EXPECT_TRUE(registry.contains("clamp"));
+  auto makeIdentity = [](const StageParameters& /*parameters*/) { return [](int value) { return value; }; };
+  EXPECT_THROW((registry.add<int, int>("clamp", makeIdentity)), std::invalid_argument);
+}
@@ -0,0 +1,120 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "funkypipes/state_machine.hpp"
+
+using namespace funkypipes;
+using ::testing::MockFunction;
+
+namespace {
+
+enum class DoorState { kClosed, kOpen, kLocked };
+enum class DoorEvent { kOpen, kClose, kLock, kUnlock };
+
+struct Door {
+  DoorState state{DoorState::kClosed};
+  int openCount{0};
+  std::string lockedBy;
+
+  bool operator==(const Door& other) const {
+    return state == other.state && openCount == other.openCount && lockedBy == other.lockedBy;
+  }
+};
+
+auto makeDoorTransitions() {
+  return makeTransitionTable(transition<DoorState::kClosed, DoorEvent::kOpen>([](Door door, const std::string&) {
+                               door.state = DoorState::kOpen;
+                               ++door.openCount;
+                               return door;
+                             }),
+                             transition<DoorState::kOpen, DoorEvent::kClose>([](Door door, const std::string&) {
+                               door.state = DoorState::kClosed;
+                               return door;
+                             }),
+                             transition<DoorState::kClosed, DoorEvent::kLock>([](Door door, const std::string& user) {
+                               door.state = DoorState::kLocked;
+                               door.lockedBy = user;
+                               return door;
+                             }),
+                             transition<DoorState::kLocked, DoorEvent::kUnlock>([](Door door, const std::string&) {
+                               door.state = DoorState::kClosed;
+                               door.lockedBy.clear();
+                               return door;
+                             }));
+}
+
+}  // namespace
+
+// Ensure that the transition table spans the used states and events and places each transition in its slot
+TEST(StateMachineTest, TransitionTableIsDense) {
+  using Table = decltype(makeDoorTransitions());
+
+  static_assert(Table::kStateCount == 3);
+  static_assert(Table::kEventCount == 4);
+  static_assert(Table::kTransitionOfSlot[Table::slotOf(DoorState::kClosed, DoorEvent::kLock)] == 2);
+  static_assert(Table::kTransitionOfSlot[Table::slotOf(DoorState::kOpen, DoorEvent::kLock)] == Table::kNoTransition);
+}
+
+// Ensure that dispatched events apply the transitions of the current state and ignore any other event
+TEST(StateMachineTest, DispatchAppliesTransitionOfCurrentState) {
+  // Given: A closed door
+  auto door = makeStateMachine(Door{}, &Door::state, makeDoorTransitions());
+
+  // When: Events are dispatched, one of them without a transition in the current state
+  const bool isOpened = door.dispatch(DoorEvent::kOpen, std::string{"alice"});
+  const bool isLocked = door.dispatch(DoorEvent::kLock, std::string{"alice"});
+  door.dispatch(DoorEvent::kClose, std::string{"alice"});
+  door.dispatch(DoorEvent::kLock, std::string{"bob"});
+
+  // Then: Only the transitions of the respective current state were applied
+  EXPECT_TRUE(isOpened);
+  EXPECT_FALSE(isLocked);
+  EXPECT_EQ(door.stateId(), DoorState::kLocked);
+  EXPECT_EQ(door.get_state(), (Door{DoorState::kLocked, 1, "bob"}));
+}
+
+// Ensure that each transition taken and each unhandled event is counted
+TEST(StateMachineTest, TransitionsAreCounted) {
+  // Given: A closed door and a bound event
+  auto door = makeStateMachine(Door{}, &Door::state, makeDoorTransitions());
+  auto open = door.bind(DoorEvent::kOpen);
+  auto close = door.bind(DoorEvent::kClose);
+
+  // When: The door is opened and closed twice, and unlocked once while not locked
+  for (int count = 0; count < 2; ++count) {
+    open(std::string{});
+    close(std::string{});
+  }
+  door.dispatch(DoorEvent::kUnlock, std::string{});
+
+  // Then: The counters reflect that
+  EXPECT_EQ(door.transitionCount(DoorState::kClosed, DoorEvent::kOpen), 2U);
+  EXPECT_EQ(door.transitionCount(DoorState::kOpen, DoorEvent::kClose), 2U);
+  EXPECT_EQ(door.transitionCount(DoorState::kClosed, DoorEvent::kLock), 0U);
+  EXPECT_EQ(door.unhandledCount(), 1U);
+}
+
+// Ensure that the subscription is notified about transitions with the event as update name
+TEST(StateMachineTest, SubscriptionIsNotifiedAboutTransitions) {
+  // Given: A closed door with a subscription
+  MockFunction<void(const DoorEvent&, const Door&, const Door&)> subscriptionMock;
+  StateMachine<Door, decltype(makeDoorTransitions())> door{Door{}, &Door::state, makeDoorTransitions(),
+                                                           subscriptionMock.AsStdFunction()};
+
+  // Then: The subscription is notified about the transition only
+  EXPECT_CALL(subscriptionMock, Call(DoorEvent::kOpen, Door{}, (Door{DoorState::kOpen, 1, ""})));
+
+  // When: An event with and an event without a transition are dispatched
+  door.dispatch(DoorEvent::kOpen, std::string{});
+  door.dispatch(DoorEvent::kOpen, std::string{});
+}
@@ -9,13 +9,24 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <tuple>
+#include <type_traits>
+#include <vector>
 
+#include "funkypipes/lens.hpp"
 #include "funkypipes/state_store.hpp"
+#include "funkypipes/update_id.hpp"
 #include "utils/move_only_struct.hpp"
 
 using namespace funkypipes;
+using ::testing::_;
 using ::testing::MockFunction;
 
 //
@@ -311,3 +322,363 @@ TEST(StateStoreTest, BindCallsSubscriptionFunction) {
   boundUpdateFn();
 }
 
+
+//
+// `TUpdateName` related tests
+//
+
+// Ensure that an enum can be used to identify updates
+TEST(StateStoreTest, EnumUpdateNameIsPassedToSubscription) {
+  // Given: A store identifying updates by an enum
+  enum class Update { kIncrement, kDecrement };
+  MockFunction<void(const Update&, const int&, const int&)> subscriptionFn;
+  StateStore<int, Update> store(subscriptionFn.AsStdFunction());
+  auto boundDecrementFn = store.bind(Update::kDecrement, [](int state) { return --state; });
+
+  // Then: Subscription called with the respective enum values
+  EXPECT_CALL(subscriptionFn, Call(Update::kIncrement, 0, 1));
+  EXPECT_CALL(subscriptionFn, Call(Update::kDecrement, 1, 0));
+
+  // When: Update functions are applied
+  store.apply(Update::kIncrement, [](int state) { return ++state; });
+  boundDecrementFn();
+}
+
+// Ensure that an UpdateId can be used to identify updates and provides the update's name
+TEST(StateStoreTest, UpdateIdIsPassedToSubscription) {
+  // Given: A store identifying updates by interned ids
+  std::string lastOutput;
+  auto subscriptionFn = [&lastOutput](UpdateId updateId, int oldState, int newState) {
+    lastOutput = std::string{updateId.name()} + " " + std::to_string(oldState) + "->" + std::to_string(newState);
+  };
+  StateStore<int, UpdateId> store(subscriptionFn);
+  const UpdateId incrementId{"incrementByAnAmountGivenAsArgument"};
+
+  // When: Update functions are applied using a prepared id and a name that gets interned
+  store.apply(incrementId, [](int state, int amount) { return state + amount; }, 2);
+  EXPECT_EQ(lastOutput, "incrementByAnAmountGivenAsArgument 0->2");
+  store.apply("decrement", [](int state) { return --state; });
+
+  // Then: The subscription received the respective names
+  EXPECT_EQ(lastOutput, "decrement 2->1");
+}
+
+//
+// `TSubscriptionFn` and `makeStateStore` related tests
+//
+
+// Ensure that the subscription function type can be specified explicitly
+TEST(StateStoreTest, StaticallyTypedSubscriptionFunctionIsCalled) {
+  // Given: A store using a plain function object as subscription
+  struct CountingSubscription {
+    void operator()(const std::string&, int, int) const { ++*callCount; }
+    int* callCount;
+  };
+  int callCount = 0;
+  StateStore<int, std::string, CountingSubscription> store{CountingSubscription{&callCount}};
+
+  // When: Update functions are applied
+  store.apply("increment", [](int state) { return ++state; });
+  store.apply("increment", [](int state) { return ++state; });
+
+  // Then: The subscription got called for each update
+  EXPECT_EQ(callCount, 2);
+  EXPECT_EQ(store.get_state(), 2);
+}
+
+// Ensure that makeStateStore deduces the subscription function type
+TEST(StateStoreTest, MakeStateStoreDeducesSubscriptionFunction) {
+  // Given: A store created with a lambda as subscription
+  std::string lastOutput;
+  auto store = makeStateStore(10, [&lastOutput](const std::string& updateName, int oldState, int newState) {
+    lastOutput = updateName + " " + std::to_string(oldState) + "->" + std::to_string(newState);
+  });
+
+  // When: A bound update function is called
+  auto boundAddFn = store.bind("add", [](int state, int amount) { return state + amount; });
+  boundAddFn(5);
+
+  // Then: The lambda is the store's subscription type and got called
+  using StdFunction = std::function<void(const std::string&, const int&, const int&)>;
+  EXPECT_FALSE((std::is_same_v<decltype(store)::SubscriptionFn, StdFunction>));
+  EXPECT_EQ(lastOutput, "add 10->15");
+  EXPECT_EQ(store.get_state(), 15);
+}
+
+// Ensure that makeStateStore allows to specify the update name type
+TEST(StateStoreTest, MakeStateStoreWithUpdateId) {
+  // Given: A store created with UpdateId names
+  UpdateId lastUpdateId{"none"};
+  auto store = makeStateStore<UpdateId>(0, [&lastUpdateId](UpdateId updateId, int, int) { lastUpdateId = updateId; });
+
+  // When: An update function is applied
+  store.apply("makeStateStoreIncrement", [](int state) { return ++state; });
+
+  // Then: The subscription received the update id
+  EXPECT_EQ(lastUpdateId.name(), "makeStateStoreIncrement");
+}
+
+//
+// `transaction` Method related tests
+//
+
+// Ensure that all updates of a transaction are applied and their outputs are returned
+TEST(StateStoreTest, TransactionAppliesAllUpdates) {
+  // Given: A default initialized store
+  StateStore<int> store;
+
+  // When: A transaction applies several updates
+  const auto output = store.transaction("batch", [](auto& tx) {
+    tx.apply("increment", [](int state) { return ++state; });
+    tx.apply("add", [](int state, int amount) { return state + amount; }, 10);
+    return tx.apply("doubleAndGetPrevious", [](int state) { return std::make_tuple(state * 2, state); });
+  });
+
+  // Then: The store's state reflects all updates and the transaction's result is returned
+  EXPECT_EQ(store.get_state(), 22);
+  EXPECT_EQ(output, 11);
+}
+
+// Ensure that a transaction notifies a subscription once using the transaction's name
+TEST(StateStoreTest, TransactionNotifiesOnceWithTransactionName) {
+  // Given: A store initialized with subscription
+  MockFunction<void(const std::string&, const int&, const int&)> subscriptionFn;
+  StateStore<int> store(subscriptionFn.AsStdFunction());
+
+  // Then: Subscription called once with the overall state transition
+  EXPECT_CALL(subscriptionFn, Call("batch", 0, 3));
+
+  // When: A transaction applies several updates
+  store.transaction("batch", [](auto& tx) {
+    for (int idx = 0; idx < 3; ++idx) {
+      tx.apply("increment", [](int state) { return ++state; });
+    }
+  });
+}
+
+// Ensure that a transaction notifies a subscription accepting update name lists with the applied update names
+TEST(StateStoreTest, TransactionNotifiesWithUpdateNames) {
+  // Given: A store whose subscription accepts single update names as well as lists of them
+  struct Subscription {
+    void operator()(const std::string& updateName, int, int) const { names->push_back(updateName); }
+    void operator()(const std::vector<std::string>& updateNames, int, int) const {
+      names->push_back("[" + updateNames.front() + "," + updateNames.back() + "]");
+    }
+    std::vector<std::string>* names;
+  };
+  std::vector<std::string> names;
+  auto store = makeStateStore(0, Subscription{&names});
+
+  // When: An update and a transaction are applied
+  store.apply("single", [](int state) { return ++state; });
+  store.transaction("batch", [](auto& tx) {
+    tx.apply("first", [](int state) { return ++state; });
+    tx.apply("last", [](int state) { return ++state; });
+  });
+
+  // Then: The transaction's notification holds the applied update names
+  EXPECT_EQ(names, (std::vector<std::string>{"single", "[first,last]"}));
+}
+
+// Ensure that updates within a transaction observe the preceding updates
+TEST(StateStoreTest, TransactionUpdatesObserveWorkingState) {
+  // Given: A store initialized with a state
+  StateStore<std::string> store{"a"};
+
+  // When: A transaction applies updates and inspects its working state
+  std::string observedState;
+  store.transaction("batch", [&observedState](auto& tx) {
+    tx.apply("appendB", [](std::string state) { return state + "b"; });
+    observedState = tx.state();
+    tx.apply("appendC", [](const std::string& state) { return state + "c"; });
+  });
+
+  // Then: The working state included the preceding update and the store holds the final state
+  EXPECT_EQ(observedState, "ab");
+  EXPECT_EQ(store.get_state(), "abc");
+}
+
+// Ensure that a throwing update rolls back the whole transaction
+TEST(StateStoreTest, TransactionRollsBackOnException) {
+  // Given: A store initialized with subscription
+  MockFunction<void(const std::string&, const int&, const int&)> subscriptionFn;
+  StateStore<int> store(subscriptionFn.AsStdFunction(), 5);
+
+  // Then: Subscription is not called
+  EXPECT_CALL(subscriptionFn, Call(_, _, _)).Times(0);
+
+  // When: A transaction's update throws after another update was applied
+  EXPECT_THROW(store.transaction("batch",
+                                 [](auto& tx) {
+                                   tx.apply("increment", [](int state) { return ++state; });
+                                   tx.apply("fail", [](int) -> int { throw std::runtime_error{"failed"}; });
+                                 }),
+               std::runtime_error);
+
+  // Then: The state remains unchanged
+  EXPECT_EQ(store.get_state(), 5);
+}
+
+// Ensure that a throwing update rolls back the whole transaction even if the transaction function catches it
+TEST(StateStoreTest, TransactionRollsBackOnCaughtException) {
+  // Given: A store holding a string, initialized with subscription
+  MockFunction<void(const std::string&, const std::string&, const std::string&)> subscriptionFn;
+  const std::string initialState(100, 'x');
+  StateStore<std::string> store(subscriptionFn.AsStdFunction(), initialState);
+
+  // Then: Subscription is not called
+  EXPECT_CALL(subscriptionFn, Call(_, _, _)).Times(0);
+
+  // When: A transaction catches the exception of an update taking the state by value
+  store.transaction("batch", [](auto& tx) {
+    try {
+      tx.apply("fail", [](std::string) -> std::string { throw std::runtime_error{"failed"}; });
+    } catch (const std::runtime_error&) {
+    }
+  });
+
+  // Then: The state and version remain unchanged
+  EXPECT_EQ(store.get_state(), initialState);
+  EXPECT_EQ(store.version(), 0U);
+}
+
+//
+// `applyAt` and `bindAt` Method related tests
+//
+
+namespace {
+
+struct Sensor {
+  double threshold{0.0};
+  int violations{0};
+};
+
+struct PlantState {
+  std::map<int, Sensor> sensors;
+  std::string operatorName;
+};
+
+}  // namespace
+
+// Ensure that applyAt updates the focused part only and notifies the subscription with the old and new state
+TEST(StateStoreTest, ApplyAtUpdatesFocusedPart) {
+  // Given: A store with a subscription and a nested state
+  std::vector<std::pair<double, double>> notifiedThresholds;
+  auto subscriptionFn = [&](const std::string&, const PlantState& oldState, const PlantState& newState) {
+    notifiedThresholds.emplace_back(oldState.sensors.at(2).threshold, newState.sensors.at(2).threshold);
+  };
+  StateStore<PlantState> store{subscriptionFn, PlantState{{{1, {10.0, 0}}, {2, {20.0, 0}}}, "alice"}};
+
+  // When: Updating the threshold of a single sensor
+  store.applyAt("raise", lens(&PlantState::sensors, 2, &Sensor::threshold),
+                [](double threshold, double delta) { return threshold + delta; }, 5.0);
+
+  // Then: Only the focused part is changed and the subscription observed the transition
+  const auto state = store.get_state();
+  EXPECT_EQ(state.sensors.at(1).threshold, 10.0);
+  EXPECT_EQ(state.sensors.at(2).threshold, 25.0);
+  EXPECT_EQ(state.operatorName, "alice");
+  EXPECT_EQ(notifiedThresholds, (std::vector<std::pair<double, double>>{{20.0, 25.0}}));
+}
+
+// Ensure that bindAt returns the additional outputs of the update function
+TEST(StateStoreTest, BindAtReturnsOutputs) {
+  // Given: A store without subscription and an update counting threshold violations
+  StateStore<PlantState> store{PlantState{{{1, {10.0, 0}}}, "bob"}};
+  auto checkReading = store.bindAt("check", lens(&PlantState::sensors, 1), [](Sensor sensor, double reading) {
+    const bool isViolation = reading > sensor.threshold;
+    sensor.violations += isViolation ? 1 : 0;
+    return std::make_tuple(sensor, isViolation);
+  });
+
+  // When: Checking readings
+  const bool first = checkReading(12.0);
+  const bool second = checkReading(8.0);
+
+  // Then: The outputs are returned and the focused part is updated
+  EXPECT_TRUE(first);
+  EXPECT_FALSE(second);
+  EXPECT_EQ(store.get_state().sensors.at(1).violations, 1);
+}
+
+// Ensure that a throwing update or a missing key leaves the state unchanged
+TEST(StateStoreTest, ApplyAtThrowingLeavesStateUnchanged) {
+  // Given: A store with a subscription
+  MockFunction<void(const std::string&, const PlantState&, const PlantState&)> subscriptionFn;
+  StateStore<PlantState> store(subscriptionFn.AsStdFunction(), PlantState{{{1, {10.0, 0}}}, "carol"});
+
+  // Then: Subscription is not called
+  EXPECT_CALL(subscriptionFn, Call(_, _, _)).Times(0);
+
+  // When: Applying a throwing update and an update at a missing key
+  EXPECT_THROW(store.applyAt("fail", lens(&PlantState::sensors, 1, &Sensor::threshold),
+                             [](double) -> double { throw std::runtime_error{"failed"}; }),
+               std::runtime_error);
+  EXPECT_THROW(store.applyAt("missing", lens(&PlantState::sensors, 2, &Sensor::threshold),
+                             [](double threshold) { return threshold; }),
+               std::out_of_range);
+
+  // Then: The state remains unchanged
+  EXPECT_EQ(store.get_state().sensors.at(1).threshold, 10.0);
+}
+
+//
+// `TMetrics` and `metrics` Method related tests
+//
+
+// Ensure that calls of each update name are counted and their latencies are measured
+TEST(StateStoreTest, MetricsCountCallsPerUpdateName) {
+  // Given: A store collecting metrics with a subscription
+  auto subscriptionFn = [](const std::string&, const std::vector<int>&, const std::vector<int>&) {};
+  auto store = makeStateStore<std::string, CollectMetrics>(std::vector<int>{}, subscriptionFn);
+  auto append = [](std::vector<int> state, int value) {
+    state.push_back(value);
+    return state;
+  };
+
+  // When: Updates are applied under different names, directly, bound, at a lens and within a transaction
+  store.apply("append", append, 1);
+  store.bind("append", append)(2);
+  store.applyAt("increment", lens(0), [](int value) { return value + 1; });
+  store.transaction("batch", [&](auto& transaction) { transaction.apply("append", append, 3); });
+
+  // Then: The calls are counted per update name, the transaction as a single update
+  const StateStoreMetrics<std::string> metrics = store.metrics();
+  ASSERT_EQ(metrics.updates.size(), 3U);
+  EXPECT_EQ(metrics.updates.at("append").callCount, 2U);
+  EXPECT_EQ(metrics.updates.at("increment").callCount, 1U);
+  EXPECT_EQ(metrics.updates.at("batch").callCount, 1U);
+  EXPECT_GE(metrics.updates.at("append").totalUpdateLatency, metrics.updates.at("append").maxUpdateLatency);
+  EXPECT_GE(metrics.updates.at("append").totalSubscriberLatency, metrics.updates.at("append").maxSubscriberLatency);
+
+  // Then: The state size includes the elements of the state's container
+  EXPECT_EQ(metrics.stateSize, sizeof(std::vector<int>) + 3 * sizeof(int));
+}
+
+// Ensure that the latency of the subscription is measured apart from that of the update function
+TEST(StateStoreTest, MetricsSeparateSubscriberLatency) {
+  // Given: A store collecting metrics with a subscription that is much slower than the update function
+  constexpr auto kSubscriberDelay = std::chrono::milliseconds{50};
+  auto subscriptionFn = [&](const std::string&, const int&, const int&) {
+    std::this_thread::sleep_for(kSubscriberDelay);
+  };
+  StateStore<int, std::string, decltype(subscriptionFn), CollectMetrics> store{subscriptionFn};
+
+  // When: An update is applied
+  store.apply("increment", [](int state) { return state + 1; });
+
+  // Then: The subscriber latency includes the delay, the update latency does not
+  const UpdateMetrics metrics = store.metrics().updates.at("increment");
+  EXPECT_GE(metrics.maxSubscriberLatency, kSubscriberDelay);
+  EXPECT_LT(metrics.maxUpdateLatency, metrics.maxSubscriberLatency);
+}
+
+// Ensure that a store without metrics is not larger than its members
+TEST(StateStoreTest, NoMetricsTakeNoSpace) {
+  struct MembersWithoutMetrics {
+    std::function<void(const std::string&, const int&, const int&)> subscriptionFn;
+    int state;
+    std::uint64_t version;
+  };
+  static_assert(sizeof(StateStore<int>) == sizeof(MembersWithoutMetrics));
+}
@@ -0,0 +1,205 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "funkypipes/state_store.hpp"
+#include "funkypipes/subscription_hub.hpp"
+
+using namespace funkypipes;
+using ::testing::_;
+using ::testing::MockFunction;
+
+namespace {
+
+struct SensorState {
+  double temperature;
+  int sampleCount;
+};
+
+auto addSampleFn = [](SensorState state, double temperature) {
+  state.temperature = temperature;
+  ++state.sampleCount;
+  return state;
+};
+
+auto resetFn = [](SensorState) { return SensorState{0.0, 0}; };
+
+}  // namespace
+
+// Ensure that all subscribers without filter are notified about every update
+TEST(SubscriptionHubTest, SubscribersWithoutFilterAreNotifiedAboutAllUpdates) {
+  // Given: A store whose hub has two subscribers
+  SubscriptionHub<SensorState> hub;
+  MockFunction<void(const std::string&, const SensorState&, const SensorState&)> subscriptionFn1;
+  MockFunction<void(const std::string&, const SensorState&, const SensorState&)> subscriptionFn2;
+  hub.subscribe(subscriptionFn1.AsStdFunction());
+  hub.subscribe(subscriptionFn2.AsStdFunction());
+  StateStore<SensorState> store{hub};
+
+  // Then: Both subscribers are notified about both updates
+  EXPECT_CALL(subscriptionFn1, Call(_, _, _)).Times(2);
+  EXPECT_CALL(subscriptionFn2, Call(_, _, _)).Times(2);
+
+  // When: Two updates are applied
+  store.apply("addSample", addSampleFn, 20.0);
+  store.apply("reset", resetFn);
+}
+
+// Ensure that subscribers with update name filter are only notified about matching updates
+TEST(SubscriptionHubTest, SubscribersWithFilterAreNotifiedAboutMatchingUpdatesOnly) {
+  // Given: A store whose hub has a subscriber interested in resets only
+  SubscriptionHub<SensorState> hub;
+  MockFunction<void(const std::string&, const SensorState&, const SensorState&)> subscriptionFn;
+  hub.subscribe(subscriptionFn.AsStdFunction(), {"reset"});
+  StateStore<SensorState> store{hub};
+
+  // Then: The subscriber is notified once
+  EXPECT_CALL(subscriptionFn, Call("reset", _, _)).Times(1);
+
+  // When: Several updates are applied
+  store.apply("addSample", addSampleFn, 20.0);
+  store.apply("reset", resetFn);
+  store.apply("addSample", addSampleFn, 21.0);
+}
+
+// Ensure that selector subscribers are only notified when the selected slice changed
+TEST(SubscriptionHubTest, SelectorSubscribersAreNotifiedOnSliceChangesOnly) {
+  // Given: A store whose hub has a subscriber to the temperature slice
+  SubscriptionHub<SensorState> hub;
+  auto temperature = hub.select([](const SensorState& state) { return state.temperature; });
+  MockFunction<void(const std::string&, const double&, const double&)> subscriptionFn;
+  hub.subscribe(temperature, subscriptionFn.AsStdFunction());
+  StateStore<SensorState> store{hub};
+
+  // Then: The subscriber is notified about temperature changes with old and new slice
+  EXPECT_CALL(subscriptionFn, Call("addSample", 0.0, 20.0));
+  EXPECT_CALL(subscriptionFn, Call("addSample", 20.0, 21.0));
+
+  // When: Samples are added, some of them not changing the temperature
+  store.apply("addSample", addSampleFn, 20.0);
+  store.apply("addSample", addSampleFn, 20.0);
+  store.apply("addSample", addSampleFn, 21.0);
+  store.apply("addSample", addSampleFn, 21.0);
+}
+
+// Ensure that a selector is evaluated once per update regardless of the number of its subscribers
+TEST(SubscriptionHubTest, SharedSelectorIsEvaluatedOncePerUpdate) {
+  // Given: A store whose hub has a counting selector shared by three subscribers
+  SubscriptionHub<SensorState> hub;
+  int selectCount = 0;
+  auto sampleCount = hub.select([&selectCount](const SensorState& state) {
+    ++selectCount;
+    return state.sampleCount;
+  });
+  int notificationCount = 0;
+  for (int idx = 0; idx < 3; ++idx) {
+    hub.subscribe(sampleCount, [&notificationCount](const std::string&, int, int) { ++notificationCount; });
+  }
+  StateStore<SensorState> store{hub};
+
+  // When: Ten updates are applied
+  for (int idx = 0; idx < 10; ++idx) {
+    store.apply("addSample", addSampleFn, 20.0);
+  }
+
+  // Then: The selector ran once per update plus once for the initial old state, and all subscribers got notified
+  EXPECT_EQ(selectCount, 11);
+  EXPECT_EQ(notificationCount, 30);
+}
+
+// Ensure that a selector is not evaluated if none of its subscribers is interested in the update
+TEST(SubscriptionHubTest, SelectorIsNotEvaluatedForUninterestingUpdates) {
+  // Given: A store whose hub has a counting selector with a subscriber interested in resets only
+  SubscriptionHub<SensorState> hub;
+  int selectCount = 0;
+  auto sampleCount = hub.select([&selectCount](const SensorState& state) {
+    ++selectCount;
+    return state.sampleCount;
+  });
+  MockFunction<void(const std::string&, const int&, const int&)> subscriptionFn;
+  hub.subscribe(sampleCount, subscriptionFn.AsStdFunction(), {"reset"});
+  StateStore<SensorState> store{hub};
+
+  // Then: The subscriber is notified about the reset based on freshly selected slices
+  EXPECT_CALL(subscriptionFn, Call("reset", 3, 0));
+
+  // When: Several samples are added and then a reset is applied
+  store.apply("addSample", addSampleFn, 20.0);
+  store.apply("addSample", addSampleFn, 21.0);
+  store.apply("addSample", addSampleFn, 22.0);
+  store.apply("reset", resetFn);
+  EXPECT_EQ(selectCount, 2);
+}
+
+namespace {
+
+// A state whose diffs are counted
+struct CountedState {
+  int value;
+};
+
+int countedDiffComputations = 0;
+
+}  // namespace
+
+namespace funkypipes {
+template <>
+struct Diff<CountedState> {
+  using Type = ValueDiff<int>;
+  static Type compute(const CountedState& oldState, const CountedState& newState) {
+    ++countedDiffComputations;
+    return diff(oldState.value, newState.value);
+  }
+};
+}  // namespace funkypipes
+
+// Ensure that the diff is computed once per update for all diff subscribers, which are notified about changes only
+TEST(SubscriptionHubTest, DiffIsComputedOncePerUpdate) {
+  // Given: A store whose hub has two diff subscribers with different signatures
+  SubscriptionHub<CountedState> hub;
+  std::vector<int> newValues;
+  std::vector<int> oldStateValues;
+  hub.subscribeDiff(
+      [&](const std::string&, const ValueDiff<int>& valueDiff) { newValues.push_back(valueDiff.change->newValue); });
+  hub.subscribeDiff([&](const std::string&, const CountedState& oldState, const CountedState&, const ValueDiff<int>&) {
+    oldStateValues.push_back(oldState.value);
+  });
+  StateStore<CountedState> store{hub, CountedState{1}};
+  countedDiffComputations = 0;
+
+  // When: A changing and an unchanging update are applied
+  store.apply("set", [](CountedState, int value) { return CountedState{value}; }, 2);
+  store.apply("set", [](CountedState, int value) { return CountedState{value}; }, 2);
+
+  // Then: The diff was computed once per update and the subscribers were notified about the change only
+  EXPECT_EQ(countedDiffComputations, 2);
+  EXPECT_EQ(newValues, (std::vector<int>{2}));
+  EXPECT_EQ(oldStateValues, (std::vector<int>{1}));
+}
+
+// Ensure that the diff is not computed if no diff subscriber is interested in the update
+TEST(SubscriptionHubTest, DiffIsNotComputedForUninterestingUpdates) {
+  // Given: A store whose hub has a diff subscriber interested in resets only
+  SubscriptionHub<CountedState> hub;
+  int notificationCount = 0;
+  hub.subscribeDiff([&](const std::string&, const ValueDiff<int>&) { ++notificationCount; }, {"reset"});
+  StateStore<CountedState> store{hub, CountedState{1}};
+  countedDiffComputations = 0;
+
+  // When: Another update is applied
+  store.apply("set", [](CountedState, int value) { return CountedState{value}; }, 2);
+
+  // Then: The diff was not computed
+  EXPECT_EQ(countedDiffComputations, 0);
+  EXPECT_EQ(notificationCount, 0);
+}
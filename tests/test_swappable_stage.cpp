@@ -0,0 +1,120 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "funkypipes/make_auto_pipe.hpp"
+#include "funkypipes/make_pipe.hpp"
+#include "funkypipes/swappable_stage.hpp"
+
+using namespace funkypipes;
+
+namespace {
+
+// A function that tracks whether it is invoked after being destroyed.
+class Scaling {
+ public:
+  Scaling(int factor, std::shared_ptr<std::atomic<int>> invalidCallCount)
+      : factor_{factor},
+        isAlive_{std::make_shared<std::atomic<bool>>(true)},
+        invalidCallCount_{std::move(invalidCallCount)} {}
+  Scaling(const Scaling&) = default;
+  Scaling(Scaling&&) noexcept = default;
+  Scaling& operator=(const Scaling&) = delete;
+  Scaling& operator=(Scaling&&) = delete;
+  ~Scaling() {
+    if (isAlive_) {
+      isAlive_->store(false);
+    }
+  }
+
+  int operator()(int value) const {
+    if (!isAlive_->load()) {
+      ++*invalidCallCount_;
+    }
+    return value * factor_;
+  }
+
+ private:
+  int factor_;
+  std::shared_ptr<std::atomic<bool>> isAlive_;
+  std::shared_ptr<std::atomic<int>> invalidCallCount_;
+};
+
+}  // namespace
+
+// Ensure that a swapped function is invoked by pipes composed of the stage before the swap
+TEST(SwappableStageTest, PipesInvokeTheSwappedFunction) {
+  // Given: A pipe composed of a swappable stage
+  auto threshold = makeSwappableStage<bool(int)>([](int value) { return value > 10; });
+  auto pipe = makePipe([](const std::string& text) { return std::stoi(text); }, threshold);
+  EXPECT_TRUE(pipe("15"));
+
+  // When: The stage's function is swapped
+  threshold.swap([](int value) { return value > 20; });
+
+  // Then: The pipe invokes the new function
+  EXPECT_FALSE(pipe("15"));
+  EXPECT_EQ(threshold.version(), 1U);
+}
+
+// Ensure that swappable stages may break the chain of pipes made by makeAutoPipe
+TEST(SwappableStageTest, ComposesWithAutoPipes) {
+  // Given: An auto pipe composed of a swappable stage returning an optional
+  auto filter = makeSwappableStage<std::optional<int>(int)>([](int value) { return std::make_optional(value); });
+  auto pipe = makeAutoPipe(filter, [](int value) { return value + 1; });
+
+  // When: The stage is swapped for one breaking the chain
+  const std::optional<int> resultBefore = pipe(1);
+  filter.swap([](int /*value*/) -> std::optional<int> { return std::nullopt; });
+  const std::optional<int> resultAfter = pipe(1);
+
+  // Then: The chain breaks after the swap only
+  EXPECT_EQ(resultBefore, std::optional<int>{2});
+  EXPECT_EQ(resultAfter, std::nullopt);
+}
+
+// Ensure that previous functions are destroyed only after all invocations in flight completed
+TEST(SwappableStageTest, PreviousFunctionsOutliveInvocationsInFlight) {
+  // Given: A swappable stage invoked by several threads
+  auto invalidCallCount = std::make_shared<std::atomic<int>>(0);
+  auto scale = makeSwappableStage<int(int)>(Scaling{1, invalidCallCount});
+  std::atomic<bool> isRunning{true};
+  std::vector<std::thread> callers;
+  for (int caller = 0; caller < 4; ++caller) {
+    callers.emplace_back([&isRunning, pipe = makePipe(scale)]() mutable {
+      while (isRunning.load()) {
+        const int result = pipe(1);
+        EXPECT_GE(result, 1);
+      }
+    });
+  }
+
+  // When: The function is swapped repeatedly meanwhile
+  constexpr int kSwapCount = 200;
+  for (int factor = 2; factor < 2 + kSwapCount; ++factor) {
+    scale.swap(Scaling{factor, invalidCallCount});
+  }
+  isRunning.store(false);
+  for (auto& caller : callers) {
+    caller.join();
+  }
+
+  // Then: No destroyed function was invoked and the last function is current
+  EXPECT_EQ(invalidCallCount->load(), 0);
+  EXPECT_EQ(scale(1), 1 + kSwapCount);
+  EXPECT_EQ(scale.version(), static_cast<std::uint64_t>(kSwapCount));
+}
@@ -0,0 +1,72 @@
+//
+// Copyright (c) 2025 mahush (info@mahush.de)
+//
+// Distributed under MIT License
+//
+// Official repository: https://github.com/mahush/funkypipes
+//
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+#include "funkypipes/update_id.hpp"
+
+using namespace funkypipes;
+
+// Ensure that ids are cheap handles
+TEST(UpdateIdTest, IsTriviallyCopyableHandle) {
+  EXPECT_TRUE(std::is_trivially_copyable_v<UpdateId>);
+  EXPECT_EQ(sizeof(UpdateId), sizeof(void*));
+}
+
+// Ensure that ids created from equal names are equal and ids of different names are not
+TEST(UpdateIdTest, EqualNamesResultInEqualIds) {
+  const UpdateId first{"updateIdTestFirst"};
+  const UpdateId firstAgain{std::string{"updateIdTestFirst"}};
+  const UpdateId second{"updateIdTestSecond"};
+
+  EXPECT_EQ(first, firstAgain);
+  EXPECT_EQ(first.index(), firstAgain.index());
+  EXPECT_NE(first, second);
+  EXPECT_NE(first.index(), second.index());
+}
+
+// Ensure that the name of an id is available for logging
+TEST(UpdateIdTest, ProvidesName) {
+  const UpdateId updateId{"updateIdTestName"};
+
+  std::ostringstream stream;
+  stream << updateId;
+
+  EXPECT_EQ(updateId.name(), "updateIdTestName");
+  EXPECT_EQ(stream.str(), "updateIdTestName");
+}
+
+// Ensure that ids can be used as keys of unordered containers
+TEST(UpdateIdTest, IsHashable) {
+  std::unordered_set<UpdateId> ids{UpdateId{"updateIdTestA"}, UpdateId{"updateIdTestB"}, UpdateId{"updateIdTestA"}};
+
+  EXPECT_EQ(ids.size(), 2U);
+}
+
+// Ensure that interning the same name from several threads results in a single id
+TEST(UpdateIdTest, InterningIsThreadSafe) {
+  std::vector<UpdateId> ids(8, UpdateId{"updateIdTestPlaceholder"});
+  std::vector<std::thread> threads;
+  for (std::size_t idx = 0; idx < ids.size(); ++idx) {
+    threads.emplace_back([&ids, idx] { ids[idx] = UpdateId{"updateIdTestConcurrent"}; });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (const auto& updateId : ids) {
+    EXPECT_EQ(updateId, ids.front());
+  }
+}